@@ -3,17 +3,20 @@
 #endif
 #include <zstd.h>
 
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <iterator>
 #include <thread>
 #include <mutex>
 #include <fc/log/logger.hpp>
 #include <fc/exception/exception.hpp>
+#include <fc/io/raw.hpp>
 #include <hive/chain/block_compression_dictionaries.hpp>
 #include <hive/chain/raw_compression_dictionaries.hpp>
 
 namespace hive { namespace chain {
 
-#ifdef HAS_COMPRESSION_DICTIONARIES
-
 // we store our dictionaries in compressed form, this is the maximum size
 // one will be when decompressed.  At the time of writing, we've decided
 // to use 220K dictionaries
@@ -31,18 +34,42 @@ struct decompressed_raw_dictionary_info
 typedef std::map<uint8_t, decompressed_raw_dictionary_info> decompressed_raw_dictionary_map_t;
 decompressed_raw_dictionary_map_t decompressed_raw_dictionaries;
 
-// maps a dictionary_number to the ready-to-use decompression dictionary
-std::map<uint8_t, ZSTD_DDict*> decompression_dictionaries;
+// maps a dictionary_number to the ready-to-use decompression dictionary; dictionaries are never released, so once
+// loaded they can be read without taking dictionaries_mutex (every block needs one during replay or p2p serving)
+std::array<std::atomic<ZSTD_DDict*>, 256> decompression_dictionaries = {};
 
 // maps a (dictionary_number, compression_level) pair to a ready-to-use compression dictionary
 std::map<std::pair<uint8_t, int>, ZSTD_CDict*> compression_dictionaries;
 
+// block ranges covered by registered custom dictionaries (guarded by dictionaries_mutex)
+struct custom_dictionary_range
+{
+  uint32_t first_block;
+  uint32_t last_block;
+  uint8_t dictionary_number;
+};
+std::vector<custom_dictionary_range> custom_dictionary_ranges;
+std::atomic<bool> has_custom_dictionaries = { false };
+
+std::optional<uint8_t> get_custom_dictionary_number_for_block(uint32_t block_number)
+{
+  if (!has_custom_dictionaries.load(std::memory_order_acquire))
+    return std::optional<uint8_t>();
+
+  std::lock_guard<std::mutex> guard(dictionaries_mutex);
+  for (const auto& range : custom_dictionary_ranges)
+    if (range.first_block <= block_number && block_number <= range.last_block)
+      return range.dictionary_number;
+  return std::optional<uint8_t>();
+}
+
 // helper function, assumes the upper level function holds the mutex on our maps
 const decompressed_raw_dictionary_info& get_decompressed_raw_dictionary(uint8_t dictionary_number)
 {
   auto decompressed_dictionary_iter = decompressed_raw_dictionaries.find(dictionary_number);
   if (decompressed_dictionary_iter == decompressed_raw_dictionaries.end())
   {
+#ifdef HAS_COMPRESSION_DICTIONARIES
     // we don't.  do we have the raw, compressed dictionary?
     auto raw_iter = raw_dictionaries.find(dictionary_number);
     if (raw_iter == raw_dictionaries.end())
@@ -68,36 +95,63 @@ const decompressed_raw_dictionary_info& get_decompressed_raw_dictionary(uint8_t
                                                                                                                    decompressed_raw_dictionary_info{std::move(resized_buffer), uncompressed_dictionary_size}));
     if (!insert_succeeded)
       FC_THROW("Error storing decompressing dictionary ${dictionary_number}", (dictionary_number));
+#else
+    FC_THROW_EXCEPTION(fc::key_not_found_exception, "No dictionary ${dictionary_number} available -- hived was not built with compression dictionaries and no such custom dictionary was loaded", (dictionary_number));
+#endif
   }
   return decompressed_dictionary_iter->second;
 }
 
 std::optional<uint8_t> get_best_available_zstd_compression_dictionary_number_for_block(uint32_t block_number)
 {
+  std::optional<uint8_t> custom_dictionary = get_custom_dictionary_number_for_block(block_number);
+  if (custom_dictionary)
+    return custom_dictionary;
+
+#ifdef HAS_COMPRESSION_DICTIONARIES
   uint8_t last_available_dictionary = raw_dictionaries.rbegin()->first;
   return std::min<uint8_t>(block_number / 1000000, last_available_dictionary);
+#else
+  return std::optional<uint8_t>();
+#endif
 }
 
 std::optional<uint8_t> get_last_available_zstd_compression_dictionary_number()
 {
+#ifdef HAS_COMPRESSION_DICTIONARIES
   return raw_dictionaries.rbegin()->first;
+#else
+  return std::optional<uint8_t>();
+#endif
+}
+
+bool is_plausible_zstd_compression_dictionary_number(uint8_t dictionary_number)
+{
+  return dictionary_number <= get_last_available_zstd_compression_dictionary_number().value_or(0) ||
+         dictionary_number >= HIVE_FIRST_CUSTOM_ZSTD_DICTIONARY_NUMBER;
 }
 
 ZSTD_DDict* get_zstd_decompression_dictionary(uint8_t dictionary_number)
 {
+  // try to find the dictionary already fully loaded for decompression
+  ZSTD_DDict* dictionary = decompression_dictionaries[dictionary_number].load(std::memory_order_acquire);
+  if (dictionary)
+    return dictionary;
+
   std::lock_guard<std::mutex> guard(dictionaries_mutex);
 
-  // try to find the dictionary already fully loaded for decompression
-  auto iter = decompression_dictionaries.find(dictionary_number);
-  if (iter != decompression_dictionaries.end())
-    return iter->second;
+  // check again, other thread might have loaded it while we were waiting for the mutex
+  dictionary = decompression_dictionaries[dictionary_number].load(std::memory_order_relaxed);
+  if (dictionary)
+    return dictionary;
 
   // it's not there, see if we have, or can create, a decompressed raw dictionary
   const decompressed_raw_dictionary_info& decompressed_dictionary = get_decompressed_raw_dictionary(dictionary_number);
 
   // then create a usable decompression dictionary for it
-  ZSTD_DDict* dictionary = ZSTD_createDDict(decompressed_dictionary.buffer.get(), decompressed_dictionary.size);
-  decompression_dictionaries[dictionary_number] = dictionary;
+  dictionary = ZSTD_createDDict(decompressed_dictionary.buffer.get(), decompressed_dictionary.size);
+  FC_ASSERT(dictionary, "Error creating decompression dictionary ${dictionary_number}", (dictionary_number));
+  decompression_dictionaries[dictionary_number].store(dictionary, std::memory_order_release);
   return dictionary;
 }
 
@@ -116,26 +170,64 @@ ZSTD_CDict* get_zstd_compression_dictionary(uint8_t dictionary_number, int compr
   return dictionary;
 }
 
-#else // !defined(HAS_COMPRESSION_DICTIONARIES)
-std::optional<uint8_t> get_best_available_zstd_compression_dictionary_number_for_block(uint32_t block_number)
+void register_custom_zstd_compression_dictionary(const custom_zstd_dictionary& dictionary)
 {
-  return std::optional<uint8_t>();
-}
+  FC_ASSERT(dictionary.dictionary_number >= HIVE_FIRST_CUSTOM_ZSTD_DICTIONARY_NUMBER,
+            "Custom dictionary number ${n} collides with numbers reserved for built-in dictionaries (custom ones start at ${f})",
+            ("n", dictionary.dictionary_number)("f", HIVE_FIRST_CUSTOM_ZSTD_DICTIONARY_NUMBER));
+  FC_ASSERT(dictionary.first_block <= dictionary.last_block, "Invalid block range of custom dictionary ${n}", ("n", dictionary.dictionary_number));
+  FC_ASSERT(!dictionary.dictionary.empty() && dictionary.dictionary.size() <= MAX_DICTIONARY_LENGTH,
+            "Invalid size ${s} of custom dictionary ${n}", ("s", dictionary.dictionary.size())("n", dictionary.dictionary_number));
 
-std::optional<uint8_t> get_last_available_zstd_compression_dictionary_number()
-{
-  return std::optional<uint8_t>();
+  std::lock_guard<std::mutex> guard(dictionaries_mutex);
+  for (const auto& range : custom_dictionary_ranges)
+  {
+    FC_ASSERT(range.dictionary_number != dictionary.dictionary_number, "Custom dictionary ${n} is already registered", ("n", dictionary.dictionary_number));
+    FC_ASSERT(dictionary.last_block < range.first_block || range.last_block < dictionary.first_block,
+              "Block range of custom dictionary ${n} overlaps with dictionary ${o}", ("n", dictionary.dictionary_number)("o", range.dictionary_number));
+  }
+
+  std::unique_ptr<char[]> buffer(new char[dictionary.dictionary.size()]);
+  memcpy(buffer.get(), dictionary.dictionary.data(), dictionary.dictionary.size());
+  decompressed_raw_dictionaries[dictionary.dictionary_number] = decompressed_raw_dictionary_info{std::move(buffer), dictionary.dictionary.size()};
+  custom_dictionary_ranges.push_back(custom_dictionary_range{dictionary.first_block, dictionary.last_block, dictionary.dictionary_number});
+  has_custom_dictionaries.store(true, std::memory_order_release);
 }
 
-ZSTD_DDict* get_zstd_decompression_dictionary(uint8_t dictionary_number)
+// side file starts with this marker followed by packed vector of custom_zstd_dictionary
+const char custom_dictionaries_file_marker[] = "HIVEZDICT1";
+
+std::vector<custom_zstd_dictionary> load_custom_zstd_compression_dictionaries(const fc::path& dictionaries_file)
 {
-  FC_THROW_EXCEPTION(fc::key_not_found_exception, "No dictionary ${dictionary_number} available -- hived was not built with compression dictionaries", (dictionary_number));
+  std::ifstream stream(dictionaries_file.generic_string(), std::ios::binary);
+  FC_ASSERT(stream, "Unable to open custom compression dictionaries file ${f}", ("f", dictionaries_file));
+  std::vector<char> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+  const size_t marker_size = sizeof(custom_dictionaries_file_marker) - 1;
+  FC_ASSERT(data.size() >= marker_size && memcmp(data.data(), custom_dictionaries_file_marker, marker_size) == 0,
+            "File ${f} is not a custom compression dictionaries file", ("f", dictionaries_file));
+
+  std::vector<custom_zstd_dictionary> dictionaries;
+  fc::datastream<const char*> ds(data.data() + marker_size, data.size() - marker_size);
+  fc::raw::unpack(ds, dictionaries);
+
+  for (const auto& dictionary : dictionaries)
+  {
+    register_custom_zstd_compression_dictionary(dictionary);
+    ilog("Loaded custom compression dictionary ${n} (${s} bytes) for blocks ${first}-${last}",
+         ("n", dictionary.dictionary_number)("s", dictionary.dictionary.size())("first", dictionary.first_block)("last", dictionary.last_block));
+  }
+  return dictionaries;
 }
 
-ZSTD_CDict* get_zstd_compression_dictionary(uint8_t dictionary_number, int compression_level)
+void save_custom_zstd_compression_dictionaries(const fc::path& dictionaries_file, const std::vector<custom_zstd_dictionary>& dictionaries)
 {
-  FC_THROW_EXCEPTION(fc::key_not_found_exception, "No dictionary ${dictionary_number} available -- hived was not built with compression dictionaries", (dictionary_number));
+  std::vector<char> data = fc::raw::pack_to_vector(dictionaries);
+  std::ofstream stream(dictionaries_file.generic_string(), std::ios::binary | std::ios::trunc);
+  FC_ASSERT(stream, "Unable to create custom compression dictionaries file ${f}", ("f", dictionaries_file));
+  stream.write(custom_dictionaries_file_marker, sizeof(custom_dictionaries_file_marker) - 1);
+  stream.write(data.data(), data.size());
+  FC_ASSERT(stream.good(), "Error writing custom compression dictionaries file ${f}", ("f", dictionaries_file));
 }
-#endif // HAS_COMPRESSION_DICTIONARIES
  
 } } // end namespace hive::chain
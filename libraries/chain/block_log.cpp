@@ -7,10 +7,12 @@
 #include <hive/chain/detail/block_attributes.hpp>
 #include <hive/chain/blockchain_worker_thread_pool.hpp>
 
+#include <algorithm>
 #include <queue>
 #include <thread>
 #include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <fc/io/raw.hpp>
 #include <fc/thread/thread.hpp>
 
@@ -23,6 +25,7 @@
 #include <boost/interprocess/sync/lock_options.hpp>
 #include <boost/interprocess/sync/file_lock.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/scope_exit.hpp>
 
 #include <unistd.h>
 
@@ -121,8 +124,119 @@ namespace hive { namespace chain {
 
         signed_block read_block_from_offset_and_size(uint64_t offset, uint64_t size);
         signed_block_header read_block_header_from_offset_and_size(uint64_t offset, uint64_t size);
+
+        // read-only mapping of the block log used by readers when mmap reads are enabled; since the file grows,
+        // the mapping is made larger than the file and replaced with bigger one when reader needs data past its end
+        // (blocks handed out earlier keep old mapping alive through aliasing pointers)
+        struct block_log_mapping
+        {
+          char* ptr = nullptr;
+          size_t size = 0;
+          ~block_log_mapping();
+        };
+        bool mmap_reads_enabled = false;
+        std::shared_ptr<block_log_mapping> mapping;
+        std::vector<std::weak_ptr<block_log_mapping>> live_mappings; // all mappings still held by blocks
+        std::mutex mapping_mutex;
+
+        std::shared_ptr<block_log_mapping> get_mapping(uint64_t required_size);
+        void drop_mapping();
+        // must be called before the file is shrunk - replaces part of live mappings past new end of file with
+        // private copy, so blocks handed out earlier don't access truncated pages (which would raise SIGBUS)
+        void detach_mappings_from_file(uint64_t new_file_size);
+        void advise_mapping(const std::shared_ptr<block_log_mapping>& the_mapping, uint64_t offset, int advice);
     };
 
+    block_log_impl::block_log_mapping::~block_log_mapping()
+    {
+      if (ptr && munmap(ptr, size) == -1)
+        elog("error unmapping block_log: ${error}", ("error", strerror(errno)));
+    }
+
+    std::shared_ptr<block_log_impl::block_log_mapping> block_log_impl::get_mapping(uint64_t required_size)
+    {
+      std::shared_ptr<block_log_mapping> current = std::atomic_load(&mapping);
+      if (current && current->size >= required_size)
+        return current;
+
+      std::lock_guard<std::mutex> guard(mapping_mutex);
+      current = std::atomic_load(&mapping);
+      if (current && current->size >= required_size)
+        return current;
+
+      // pages past the end of file become readable as soon as the file grows into them, so reserve address
+      // space for appends that are going to happen, to not remap with every new block
+      constexpr uint64_t mapping_reserve = 256ull << 20;
+      struct stat file_stats;
+      if (fstat(block_log_fd, &file_stats) == -1)
+        FC_THROW("Error getting size of file: ${error}", ("error", strerror(errno)));
+      uint64_t file_size = std::max<uint64_t>(required_size, file_stats.st_size);
+      auto new_mapping = std::make_shared<block_log_mapping>();
+      new_mapping->size = file_size + mapping_reserve;
+      void* ptr = mmap(0, new_mapping->size, PROT_READ, MAP_SHARED, block_log_fd, 0);
+      if (ptr == MAP_FAILED)
+        FC_THROW("Failed to mmap block log file: ${error}", ("error", strerror(errno)));
+      new_mapping->ptr = (char*)ptr;
+      // default access pattern is random (API and p2p requests), sequential reads (replay) advise separately
+      if (madvise(new_mapping->ptr, new_mapping->size, MADV_RANDOM) == -1)
+        wlog("madvise failed: ${error}", ("error", strerror(errno)));
+
+      live_mappings.erase(std::remove_if(live_mappings.begin(), live_mappings.end(),
+        [](const std::weak_ptr<block_log_mapping>& m) { return m.expired(); }), live_mappings.end());
+      live_mappings.push_back(new_mapping);
+      std::atomic_store(&mapping, new_mapping);
+      return new_mapping;
+    }
+
+    void block_log_impl::drop_mapping()
+    {
+      std::lock_guard<std::mutex> guard(mapping_mutex);
+      std::atomic_store(&mapping, std::shared_ptr<block_log_mapping>());
+    }
+
+    void block_log_impl::detach_mappings_from_file(uint64_t new_file_size)
+    {
+      static const uint64_t page_size = sysconf(_SC_PAGESIZE);
+      std::lock_guard<std::mutex> guard(mapping_mutex);
+      std::atomic_store(&mapping, std::shared_ptr<block_log_mapping>());
+
+      struct stat file_stats;
+      if (fstat(block_log_fd, &file_stats) == -1)
+        FC_THROW("Error getting size of file: ${error}", ("error", strerror(errno)));
+      const uint64_t first_page = new_file_size / page_size * page_size;
+      for (const std::weak_ptr<block_log_mapping>& weak_mapping : live_mappings)
+      {
+        std::shared_ptr<block_log_mapping> live_mapping = weak_mapping.lock();
+        if (!live_mapping || live_mapping->size <= first_page)
+          continue;
+        // the copy is prepared aside and then moved over the mapped range in one step, so concurrent readers
+        // always see valid data
+        const uint64_t length = live_mapping->size - first_page;
+        const uint64_t copied = std::min<uint64_t>(live_mapping->size, file_stats.st_size) - std::min<uint64_t>(first_page, file_stats.st_size);
+        void* copy = mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (copy == MAP_FAILED)
+          FC_THROW("Failed to allocate copy of mapped block log: ${error}", ("error", strerror(errno)));
+        memcpy(copy, live_mapping->ptr + first_page, copied);
+        if (mprotect(copy, length, PROT_READ) == -1)
+          wlog("mprotect failed: ${error}", ("error", strerror(errno)));
+        if (mremap(copy, length, length, MREMAP_MAYMOVE | MREMAP_FIXED, live_mapping->ptr + first_page) == MAP_FAILED)
+        {
+          munmap(copy, length);
+          FC_THROW("Failed to replace mapped block log with its copy: ${error}", ("error", strerror(errno)));
+        }
+      }
+      live_mappings.erase(std::remove_if(live_mappings.begin(), live_mappings.end(),
+        [](const std::weak_ptr<block_log_mapping>& m) { return m.expired(); }), live_mappings.end());
+    }
+
+    void block_log_impl::advise_mapping(const std::shared_ptr<block_log_mapping>& the_mapping, uint64_t offset, int advice)
+    {
+      static const uint64_t page_size = sysconf(_SC_PAGESIZE);
+      offset = std::min<uint64_t>(offset, the_mapping->size) / page_size * page_size;
+      if (madvise(the_mapping->ptr + offset, the_mapping->size - offset, advice) == -1)
+        wlog("madvise failed: ${error}", ("error", strerror(errno)));
+    }
+
     void block_log_impl::write_with_retry(int fd, const void* buf, size_t nbyte)
     {
       for (;;)
@@ -298,6 +412,7 @@ namespace hive { namespace chain {
   void block_log::close()
   {
     my->_artifacts.reset(); /// Destruction also performs file close.
+    my->drop_mapping();
 
     if (my->block_log_fd != -1) {
       ::close(my->block_log_fd);
@@ -412,6 +527,20 @@ namespace hive { namespace chain {
     return std::make_tuple(std::move(serialized_data), serialized_data_size, std::move(this_block_artifacts));
   }
 
+  std::tuple<std::shared_ptr<const char>, size_t, block_log_artifacts::artifacts_t> block_log::read_mapped_raw_block_data_by_num(uint32_t block_num) const
+  {
+    FC_ASSERT(my->mmap_reads_enabled, "Memory mapped reads are not enabled for ${file}", ("file", my->block_file));
+    block_log_artifacts::artifacts_t this_block_artifacts = my->_artifacts->read_block_artifacts(block_num);
+
+    const uint64_t block_start_pos = this_block_artifacts.block_log_file_pos;
+    const uint64_t serialized_data_size = this_block_artifacts.block_serialized_data_size;
+
+    std::shared_ptr<detail::block_log_impl::block_log_mapping> mapping = my->get_mapping(block_start_pos + serialized_data_size);
+    std::shared_ptr<const char> serialized_data(mapping, mapping->ptr + block_start_pos);
+
+    return std::make_tuple(std::move(serialized_data), serialized_data_size, std::move(this_block_artifacts));
+  }
+
   std::tuple<std::unique_ptr<char[]>, size_t, block_log_artifacts::block_attributes_t> block_log::read_common_raw_block_data_by_num(uint32_t block_num) const
   {
     if( block_num == my->_artifacts->read_head_block_num() )
@@ -442,7 +571,7 @@ namespace hive { namespace chain {
       {
         const compressed_block_data& compressed_block = full_block->get_compressed_block();
         block_start_pos = append_raw(full_block->get_block_num(),
-                                     compressed_block.compressed_bytes.get(), compressed_block.compressed_size, compressed_block.compression_attributes,
+                                     compressed_block.data(), compressed_block.compressed_size, compressed_block.compression_attributes,
                                      full_block->get_block_id(), is_at_live_sync);
       }
       else // compression not enabled
@@ -504,6 +633,20 @@ namespace hive { namespace chain {
 
       // if we're still here, we know that it's in the block log, and the block after it is also
       // in the block log (which means we can determine its size)
+      if (my->mmap_reads_enabled)
+      {
+        std::tuple<std::shared_ptr<const char>, size_t, block_log_artifacts::artifacts_t> mapped_block_data = read_mapped_raw_block_data_by_num(block_num);
+        const block_log_artifacts::artifacts_t& artifacts = std::get<2>(mapped_block_data);
+        if (artifacts.attributes.flags != block_flags::uncompressed)
+          return full_block_type::create_from_mapped_compressed_block_data(std::get<0>(std::move(mapped_block_data)), std::get<1>(mapped_block_data),
+                                                                           artifacts.attributes, artifacts.block_id);
+
+        // uncompressed blocks are decoded in place, so they need their own copy
+        std::unique_ptr<char[]> serialized_data(new char[std::get<1>(mapped_block_data)]);
+        memcpy(serialized_data.get(), std::get<0>(mapped_block_data).get(), std::get<1>(mapped_block_data));
+        return full_block_type::create_from_uncompressed_block_data(std::move(serialized_data), std::get<1>(mapped_block_data), artifacts.block_id);
+      }
+
       std::tuple<std::unique_ptr<char[]>, size_t, block_log_artifacts::artifacts_t> raw_block_data = read_raw_block_data_by_num(block_num);
       block_log_artifacts::artifacts_t artifacts = std::get<2>(std::move(raw_block_data));
 
@@ -577,6 +720,30 @@ namespace hive { namespace chain {
 
         uint64_t first_block_offset = plural_of_block_artifacts.front().block_log_file_pos;
 
+        if (my->mmap_reads_enabled)
+        {
+          std::shared_ptr<detail::block_log_impl::block_log_mapping> mapping = my->get_mapping(first_block_offset + size_of_all_blocks);
+          for (const block_log_artifacts::artifacts_t& block_artifacts : plural_of_block_artifacts)
+          {
+            const char* block_data = mapping->ptr + block_artifacts.block_log_file_pos;
+            if (block_artifacts.attributes.flags == block_flags::uncompressed)
+            {
+              std::unique_ptr<char[]> uncompressed_block_data(new char[block_artifacts.block_serialized_data_size]);
+              memcpy(uncompressed_block_data.get(), block_data, block_artifacts.block_serialized_data_size);
+              result.push_back(full_block_type::create_from_uncompressed_block_data(std::move(uncompressed_block_data),
+                                                                                    block_artifacts.block_serialized_data_size,
+                                                                                    block_artifacts.block_id));
+            }
+            else
+              result.push_back(full_block_type::create_from_mapped_compressed_block_data(std::shared_ptr<const char>(mapping, block_data),
+                                                                                         block_artifacts.block_serialized_data_size,
+                                                                                         block_artifacts.attributes, block_artifacts.block_id));
+          }
+          if (last_block_is_head_block)
+            result.push_back(head_block);
+          return result;
+        }
+
         // then read all the blocks in one go
         idump((size_of_all_blocks));
         std::unique_ptr<char[]> block_data(new char[size_of_all_blocks]);
@@ -659,12 +826,13 @@ namespace hive { namespace chain {
 
   void block_log::open_and_init( const fc::path& file, bool read_only, bool allow_artifacts_regeneration,
     bool enable_compression, int compression_level, bool enable_block_log_auto_fixing,
-    hive::chain::blockchain_worker_thread_pool& thread_pool )
+    hive::chain::blockchain_worker_thread_pool& thread_pool, bool enable_mmap_reads /* = false */ )
   {
     my->auto_fixing_enabled = enable_block_log_auto_fixing;
     open( file, thread_pool, read_only, allow_artifacts_regeneration );
     my->compression_enabled = enable_compression;
     my->zstd_level = compression_level;
+    my->mmap_reads_enabled = enable_mmap_reads;
   }
 
   void block_log::for_each_block_position(block_info_processor_t processor) const
@@ -729,8 +897,9 @@ namespace hive { namespace chain {
     ilog("Block position list walk finished in time: ${et} ms.", ("et", elapsed_time/1000));
   }
 
-  void block_log::read_blocks_data_for_artifacts_generation(artifacts_generation_processor processor, const uint32_t target_block_number, const uint32_t starting_block_number,
-                                                            const fc::optional<uint64_t> starting_block_position) const
+  uint32_t block_log::read_blocks_data_for_artifacts_generation(artifacts_generation_processor processor, artifacts_generation_progress_t progress,
+                                                                const uint32_t target_block_number, const uint32_t starting_block_number,
+                                                                const fc::optional<uint64_t> starting_block_position) const
   {
     FC_ASSERT(target_block_number <= starting_block_number);
     FC_ASSERT(target_block_number != 0);
@@ -758,11 +927,18 @@ namespace hive { namespace chain {
     }
 
     // memory map for block log
-    char* block_log_ptr = (char*)mmap(0, my->block_log_size, PROT_READ, MAP_SHARED, my->block_log_fd, 0);
+    const size_t block_log_size = my->block_log_size;
+    char* block_log_ptr = (char*)mmap(0, block_log_size, PROT_READ, MAP_SHARED, my->block_log_fd, 0);
     if (block_log_ptr == (char*)-1)
       FC_THROW("Failed to mmap block log file: ${error}", ("error", strerror(errno)));
+    // unmapped also when worker or walker throws (after workers are joined)
+    BOOST_SCOPE_EXIT(block_log_ptr, block_log_size)
+    {
+      if (munmap(block_log_ptr, block_log_size) == -1)
+        elog("error unmapping block_log: ${error}", ("error", strerror(errno)));
+    } BOOST_SCOPE_EXIT_END
     // Use MADV_RANDOM since we're scanning backward; we'll issue targeted MADV_WILLNEED prefetches
-    if (madvise(block_log_ptr, my->block_log_size, MADV_RANDOM) == -1)
+    if (madvise(block_log_ptr, block_log_size, MADV_RANDOM) == -1)
       wlog("madvise failed: ${error}", ("error", strerror(errno)));
 
     ilog("Processing blocks in reverse order for artifact file from block: ${starting_block_number} (position: ${block_position}, is head: ${starting_from_head_block} ) to ${target_block_number} ...",
@@ -784,28 +960,47 @@ namespace hive { namespace chain {
       last_prefetch_end = prefetch_start;
     }
 
-    // Batch-parallel block_id computation: gather block metadata in batches,
-    // compute block_ids in parallel, then deliver to processor in order.
-    struct block_entry
+    // Helper: follow position trailer of current block to its start, moves to the trailer of previous block
+    auto read_next_entry = [&]() -> artifacts_generation_entry
     {
-      uint64_t block_pos;
-      uint32_t block_num;
-      uint32_t data_size;
+      // Periodically prefetch the next backward chunk
+      if (++blocks_since_prefetch >= PREFETCH_INTERVAL_BLOCKS && block_position < last_prefetch_end + PREFETCH_CHUNK_SIZE)
+      {
+        uint64_t prefetch_start = last_prefetch_end > PREFETCH_CHUNK_SIZE ? last_prefetch_end - PREFETCH_CHUNK_SIZE : 0;
+        if (prefetch_start < last_prefetch_end)
+        {
+          madvise(block_log_ptr + prefetch_start, last_prefetch_end - prefetch_start, MADV_WILLNEED);
+          last_prefetch_end = prefetch_start;
+        }
+        blocks_since_prefetch = 0;
+      }
+
+      // read the file offset of the start of the block from the block log
+      uint64_t higher_block_position = block_position;
+      // read next block pos offset from the block log
+      uint64_t block_position_with_flags = *(uint64_t*)(block_log_ptr + block_position);
       block_attributes_t attributes;
-      block_id_type block_id; // filled by parallel computation
-    };
+      std::tie(block_position, attributes) = detail::split_block_start_pos_with_flags(block_position_with_flags);
 
-    constexpr size_t BATCH_SIZE = 4096;
-    std::vector<block_entry> batch;
-    batch.reserve(BATCH_SIZE);
+      if (higher_block_position <= block_position) //this is a sanity check on index values stored in the block log
+        FC_THROW("bad block offset at block ${current_block_num} because higher block pos: ${higher_block_pos} <= lower block pos: ${block_position}",
+                 (current_block_num)(higher_block_position)(block_position));
+
+      artifacts_generation_entry entry{block_position, current_block_num, static_cast<uint32_t>(higher_block_position - block_position), attributes, {}};
+
+      /// Move to the offset of previous block
+      block_position -= sizeof(uint64_t);
+      --current_block_num;
+      return entry;
+    };
 
     // Helper: compute block_id for a single entry directly from mmap'd data
-    auto compute_block_id = [block_log_ptr](block_entry& entry)
+    auto compute_block_id = [block_log_ptr](artifacts_generation_entry& entry)
     {
-      const char* raw_ptr = block_log_ptr + entry.block_pos;
+      const char* raw_ptr = block_log_ptr + entry.block_log_file_pos;
       if (entry.attributes.flags == block_flags::uncompressed)
       {
-        fc::datastream<const char*> ds(raw_ptr, entry.data_size);
+        fc::datastream<const char*> ds(raw_ptr, entry.block_serialized_data_size);
         block_header hdr;
         fc::raw::unpack(ds, hdr);
         signature_type sig;
@@ -815,108 +1010,149 @@ namespace hive { namespace chain {
       else
       {
         entry.block_id = full_block_type::compute_block_id_from_compressed_data(
-            raw_ptr, entry.data_size, entry.attributes);
+            raw_ptr, entry.block_serialized_data_size, entry.attributes);
       }
     };
 
-    // Determine thread count for parallel computation
-    const unsigned num_threads = std::max(1u, std::thread::hardware_concurrency());
-    std::vector<std::thread> workers;
+    // all blocks from starting one down to this one are passed to processor
+    uint32_t processed_down_to = starting_block_number;
 
-    // Helper: process a filled batch — compute block_ids in parallel, then deliver to processor
+    // head block is handled up front, so the value reported to caller always names a processed block
     bool stop_requested = false;
-    auto process_batch = [&]()
+    if (starting_from_head_block)
     {
-      if (batch.empty())
-        return;
+      std::vector<artifacts_generation_entry> head_entry{ read_next_entry() };
+      compute_block_id(head_entry.front());
+      stop_requested = !processor(head_entry);
+      progress(processed_down_to);
+    }
 
-      // Parallel block_id computation: divide batch among threads
-      if (batch.size() >= 64 && num_threads > 1)
+    // The position trailers form a chain that has to be followed block by block, but that is cheap compared to computing
+    // block ids (which usually means decompressing the block). This thread walks the trailers and cuts blocks into ranges
+    // of known positions, worker threads compute ids for whole ranges and pass them to processor independently.
+    constexpr uint32_t BLOCKS_PER_RANGE = 10000;
+    struct block_range
+    {
+      size_t range_index;
+      std::vector<artifacts_generation_entry> entries;
+    };
+
+    const unsigned num_threads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t max_pending_ranges = 2 * num_threads;
+
+    std::mutex ranges_mutex;
+    std::condition_variable ranges_condition;
+    std::queue<block_range> pending_ranges;
+    bool walk_finished = false;
+    std::exception_ptr worker_exception;
+    // ranges finish out of order, progress only moves over the contiguous completed ones (guarded by ranges_mutex)
+    std::vector<bool> completed_ranges;
+    std::vector<uint32_t> range_lowest_block_num;
+    size_t first_not_completed_range = 0;
+
+    auto worker_body = [&]()
+    {
+      fc::set_thread_name("artifacts_gen"); // tells the OS the thread's name
+      fc::thread::current().set_name("artifacts_gen"); // tells fc the thread's name for logging
+      while (true)
       {
-        workers.clear();
-        const size_t chunk = (batch.size() + num_threads - 1) / num_threads;
-        for (unsigned t = 0; t < num_threads; ++t)
+        block_range range;
         {
-          size_t begin = t * chunk;
-          size_t end = std::min(begin + chunk, batch.size());
-          if (begin >= end)
-            break;
-          workers.emplace_back([&batch, &compute_block_id, begin, end]()
-          {
-            for (size_t i = begin; i < end; ++i)
-              compute_block_id(batch[i]);
-          });
+          std::unique_lock<std::mutex> lock(ranges_mutex);
+          ranges_condition.wait(lock, [&]() { return stop_requested || walk_finished || !pending_ranges.empty(); });
+          if (stop_requested || pending_ranges.empty())
+            return;
+          range = std::move(pending_ranges.front());
+          pending_ranges.pop();
         }
-        for (auto& w : workers)
-          w.join();
-      }
-      else
-      {
-        // Small batch — compute sequentially
-        for (auto& entry : batch)
-          compute_block_id(entry);
-      }
+        ranges_condition.notify_all(); // walker might wait for free slot
 
-      // Deliver results to processor in order (blocks are in decreasing block_num order)
-      for (const auto& entry : batch)
-      {
-        if (!processor(entry.block_id, entry.block_pos, entry.block_num, entry.attributes))
+        bool continue_processing = true;
+        try
         {
-          ilog("Block log reading for artifacts stopped on caller request. Last read block: ${block_num}", ("block_num", entry.block_num));
+          for (auto& entry : range.entries)
+            compute_block_id(entry);
+          continue_processing = processor(range.entries);
+        }
+        catch (...)
+        {
+          std::unique_lock<std::mutex> lock(ranges_mutex);
+          if (!worker_exception)
+            worker_exception = std::current_exception();
           stop_requested = true;
-          break;
+          ranges_condition.notify_all();
+          return;
         }
-      }
 
-      batch.clear();
-    };
-
-    while (current_block_num >= target_block_number && !stop_requested)
-    {
-      // Periodically prefetch the next backward chunk
-      if (++blocks_since_prefetch >= PREFETCH_INTERVAL_BLOCKS && block_position < last_prefetch_end + PREFETCH_CHUNK_SIZE)
-      {
-        uint64_t prefetch_start = last_prefetch_end > PREFETCH_CHUNK_SIZE ? last_prefetch_end - PREFETCH_CHUNK_SIZE : 0;
-        if (prefetch_start < last_prefetch_end)
+        std::unique_lock<std::mutex> lock(ranges_mutex);
+        completed_ranges[range.range_index] = true;
+        if (range.range_index == first_not_completed_range)
         {
-          madvise(block_log_ptr + prefetch_start, last_prefetch_end - prefetch_start, MADV_WILLNEED);
-          last_prefetch_end = prefetch_start;
+          while (first_not_completed_range < completed_ranges.size() && completed_ranges[first_not_completed_range])
+            ++first_not_completed_range;
+          processed_down_to = range_lowest_block_num[first_not_completed_range - 1];
+          progress(processed_down_to);
+        }
+        if (!continue_processing)
+        {
+          ilog("Block log reading for artifacts stopped on caller request. Last read block: ${block_num}", ("block_num", range.entries.back().block_num));
+          stop_requested = true;
+          ranges_condition.notify_all();
         }
-        blocks_since_prefetch = 0;
       }
+    };
 
-      // read the file offset of the start of the block from the block log
-      uint64_t higher_block_position = block_position;
-      // read next block pos offset from the block log
-      uint64_t block_position_with_flags = *(uint64_t*)(block_log_ptr + block_position);
-      block_attributes_t attributes;
-      std::tie(block_position, attributes) = detail::split_block_start_pos_with_flags(block_position_with_flags);
-
-      if (higher_block_position <= block_position) //this is a sanity check on index values stored in the block log
-        FC_THROW("bad block offset at block ${current_block_num} because higher block pos: ${higher_block_pos} <= lower block pos: ${block_position}",
-                 (current_block_num)(higher_block_position)(block_position));
-
-      uint32_t block_serialized_data_size = higher_block_position - block_position;
-
-      batch.push_back({block_position, current_block_num, block_serialized_data_size, attributes, {}});
-
-      if (batch.size() >= BATCH_SIZE)
-        process_batch();
+    std::vector<std::thread> workers;
+    if (!stop_requested && current_block_num >= target_block_number)
+    {
+      for (unsigned t = 0; t < num_threads; ++t)
+        workers.emplace_back(worker_body);
+    }
 
-      /// Move to the offset of previous block
-      block_position -= sizeof(uint64_t);
-      --current_block_num;
+    try
+    {
+      for (size_t range_index = 0; current_block_num >= target_block_number; ++range_index)
+      {
+        block_range range;
+        range.range_index = range_index;
+        range.entries.reserve(std::min(BLOCKS_PER_RANGE, current_block_num - target_block_number + 1));
+        while (range.entries.size() < BLOCKS_PER_RANGE && current_block_num >= target_block_number)
+          range.entries.push_back(read_next_entry());
+
+        std::unique_lock<std::mutex> lock(ranges_mutex);
+        ranges_condition.wait(lock, [&]() { return stop_requested || pending_ranges.size() < max_pending_ranges; });
+        if (stop_requested)
+          break;
+        completed_ranges.push_back(false);
+        range_lowest_block_num.push_back(range.entries.back().block_num);
+        pending_ranges.push(std::move(range));
+        ranges_condition.notify_all();
+      }
+    }
+    catch (...)
+    {
+      std::unique_lock<std::mutex> lock(ranges_mutex);
+      if (!worker_exception)
+        worker_exception = std::current_exception();
+      stop_requested = true;
     }
 
-    // Process remaining blocks
-    process_batch();
+    {
+      std::unique_lock<std::mutex> lock(ranges_mutex);
+      walk_finished = true;
+    }
+    ranges_condition.notify_all();
+    for (auto& worker : workers)
+      worker.join();
 
-    if (munmap(block_log_ptr, my->block_log_size) == -1)
-      elog("error unmapping block_log: ${error}", ("error", strerror(errno)));
+    if (worker_exception)
+      std::rethrow_exception(worker_exception);
 
     const fc::time_point end_time = fc::time_point::now();
     const fc::microseconds iteration_duration = end_time - start_time;
-    ilog("Block log reading for artifacts finished in time: ${iteration_duration} s.", ("iteration_duration", iteration_duration.count() / 1000000));
+    ilog("Block log reading for artifacts finished in time: ${iteration_duration} s. All blocks down to ${processed_down_to} processed.",
+      ("iteration_duration", iteration_duration.count() / 1000000)(processed_down_to));
+    return processed_down_to;
   }
 
   void block_log::for_each_block(uint32_t starting_block_number, uint32_t ending_block_number,
@@ -944,6 +1180,20 @@ namespace hive { namespace chain {
         FC_THROW("unknown purpose");
     }
 
+    // replay reads the block log front to back, tell the kernel to read ahead aggressively (and drop pages behind)
+    std::shared_ptr<detail::block_log_impl::block_log_mapping> sequential_mapping;
+    if (my->mmap_reads_enabled && starting_block_number < ending_block_number && my->_artifacts &&
+        starting_block_number <= my->_artifacts->read_head_block_num())
+    {
+      uint64_t starting_position = my->_artifacts->read_block_artifacts(starting_block_number).block_log_file_pos;
+      sequential_mapping = my->get_mapping(starting_position);
+      my->advise_mapping(sequential_mapping, starting_position, MADV_SEQUENTIAL);
+    }
+    BOOST_SCOPE_EXIT(&sequential_mapping, this_) {
+      if (sequential_mapping)
+        this_->my->advise_mapping(sequential_mapping, 0, MADV_RANDOM);
+    } BOOST_SCOPE_EXIT_END
+
     std::thread queue_filler_thread([&, this]() {
       fc::set_thread_name("for_each_io"); // tells the OS the thread's name
       fc::thread::current().set_name("for_each_io"); // tells fc the thread's name for logging
@@ -1037,6 +1287,9 @@ namespace hive { namespace chain {
     dlog("new head block starts at offset ${offset} and is ${bytes} bytes long",
          ("offset", new_head_block_artifacts.block_log_file_pos)("bytes", new_head_block_artifacts.block_serialized_data_size));
     off_t final_block_log_size = new_head_block_artifacts.block_log_file_pos + new_head_block_artifacts.block_serialized_data_size + sizeof(uint64_t);;
+    // blocks past the new head must not be read through the old mapping anymore, and blocks handed out
+    // earlier must not be left pointing at truncated part of file
+    my->detach_mappings_from_file(final_block_log_size);
     FC_ASSERT(ftruncate(my->block_log_fd, final_block_log_size) == 0,
               "failed to truncate block log, ${error}", ("error", strerror(errno)));
     my->_artifacts->truncate(new_head_block_num);
@@ -1084,7 +1337,7 @@ namespace hive { namespace chain {
             bool dictionary_is_plausible;
             // if the dictionary flag bit is set, verify that the dictionary number is one that we have.
             if (block_offset_with_flags & 0x0100000000000000ull)
-              dictionary_is_plausible = *flags.dictionary_number <= hive::chain::get_last_available_zstd_compression_dictionary_number().value_or(0);
+              dictionary_is_plausible = hive::chain::is_plausible_zstd_compression_dictionary_number(*flags.dictionary_number);
             // if the dictionary flag bit is not set, expect the dictionary number to be zeroed
             else
               dictionary_is_plausible = (block_offset_with_flags & 0x00ff000000000000ull) == 0;
@@ -1152,6 +1405,7 @@ namespace hive { namespace chain {
                 const uint64_t new_block_log_size = offset_of_pos_and_flags_to_test + sizeof(uint64_t);
                 wlog("Found end of last completed block in block_log. Truncating block_log to: ${new_block_log_size} bytes. Original block_log size: ${block_log_size}. Diff: ${diff}",
                     (new_block_log_size)(block_log_size)("diff", (block_log_size - new_block_log_size)));
+                my->detach_mappings_from_file(new_block_log_size);
                 FC_ASSERT(ftruncate(my->block_log_fd, new_block_log_size) == 0, "failed to truncate block log, ${error}", ("error", strerror(errno)));
                 wlog("block_log file has been truncated. Replay blockchain may be needed.");
                 my->block_log_size = get_file_stats(my->block_log_fd).st_size;
@@ -13,11 +13,11 @@
 #include <fc/thread/thread.hpp>
 #include <fc/io/json.hpp>
 
-#include <boost/lockfree/spsc_queue.hpp>
 #include <boost/interprocess/sync/file_lock.hpp>
 
 #include <fcntl.h>
 
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <map>
@@ -575,161 +575,73 @@ void block_log_artifacts::impl::generate_artifacts_file(const block_log& source_
   const fc::optional<uint64_t> starting_block_position = _header.generating_interrupted_at_block ? read_block_artifacts(_header.generating_interrupted_at_block).block_log_file_pos : fc::optional<uint64_t>();
   ilog("Generating block log artifacts file from block ${starting_block_num} to ${target_block_num}", (starting_block_num)(target_block_num));
 
-  uint32_t processed_blocks_count = 0;
+  FC_ASSERT(starting_block_num >= target_block_num,
+    "starting_block_num (${s}) must be >= target_block_num (${t})",
+    ("s", starting_block_num)("t", target_block_num));
+
+  const uint32_t blocks_to_process = starting_block_num - target_block_num + 1;
+  std::atomic<uint32_t> processed_blocks_count = { 0 };
   const uint64_t time_begin = timestamp_ms();
-  bool generating_interrupted = false;
 
-  std::mutex queue_mutex;
-  std::condition_variable queue_condition;
-  struct block_artifact_data
+  // Called concurrently for independent block ranges; whole range is written with single pwrite.
+  auto block_processor = [&](const std::vector<block_log::artifacts_generation_entry>& blocks) -> bool
   {
-    uint64_t block_log_file_pos;
-    block_attributes_t attributes;
-    block_id_type block_id;
-    uint32_t block_num;
-  };
-
-  typedef boost::lockfree::spsc_queue<std::shared_ptr<block_artifact_data>> queue_type;
-  constexpr size_t MAX_BLOCK_TO_PREFETCH = 10000;
-  queue_type artifact_queue{MAX_BLOCK_TO_PREFETCH};
-  std::atomic<size_t> queue_size = { 0 }; // approx artifact_queue size
-
-  std::thread artifacts_writer_thread([&]() {
-    fc::set_thread_name("artifact_writer"); // tells the OS the thread's name
-    fc::thread::current().set_name("artifact_writer"); // tells fc the thread's name for logging
-
-    constexpr uint32_t BLOCKS_COUNT_INTERVAL_FOR_ARTIFACTS_SAVE = 1000000;
-    // Batch write buffer: accumulate chunks and write them in a single pwrite call.
-    // Blocks arrive in decreasing block_num order, so we fill the buffer from back to front
-    // and flush when full or at boundaries.
-    constexpr size_t WRITE_BATCH_SIZE = 4096;
-    std::vector<artifact_file_chunk> write_buffer(WRITE_BATCH_SIZE);
-    size_t buffer_count = 0; // number of chunks buffered (filled from the end of write_buffer)
-    uint32_t buffer_lowest_block_num = 0; // lowest block_num in the buffer
-
-    auto flush_write_buffer = [&]()
+    // blocks arrive in decreasing block_num order, in the file they are stored in increasing one
+    std::vector<artifact_file_chunk> chunks(blocks.size());
+    for (size_t i = 0; i < blocks.size(); ++i)
     {
-      if (buffer_count == 0)
-        return;
-      auto write_position = calculate_offset(buffer_lowest_block_num);
-      // Chunks are stored at the end of write_buffer, starting at index (WRITE_BATCH_SIZE - buffer_count)
-      write_data(write_buffer[WRITE_BATCH_SIZE - buffer_count], buffer_count, write_position,
-                 "Batch writing artifact file chunks");
-      buffer_count = 0;
-    };
-
-    size_t idx = 0;
-    uint32_t current_block_number = starting_block_num;
-
-    FC_ASSERT(starting_block_num >= target_block_num,
-      "starting_block_num (${s}) must be >= target_block_num (${t})",
-      ("s", starting_block_num)("t", target_block_num));
-    do
-    {
-      std::shared_ptr<block_artifact_data> block_with_artifacts;
-      {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        while (!theApp.is_interrupt_request() && !artifact_queue.pop(block_with_artifacts))
-          queue_condition.wait(lock);
-
-        if (theApp.is_interrupt_request() || !block_with_artifacts)
-        {
-          flush_write_buffer();
-          ilog("Artifacts file generation interrupted at block: ${current_block_number}", (current_block_number));
-          generating_interrupted = true;
-          break;
-        }
-
-        queue_size.fetch_sub(1, std::memory_order_relaxed);
-      }
-      queue_condition.notify_one();
-
-      current_block_number = block_with_artifacts->block_num;
-      const block_id_type& the_block_id = block_with_artifacts->block_id;
-
-      // Pack the chunk into the write buffer
-      artifact_file_chunk data_chunk;
-      data_chunk.pack_data(block_with_artifacts->block_log_file_pos, block_with_artifacts->attributes);
-      data_chunk.pack_block_id(current_block_number, the_block_id);
-
-      // If buffer is full or this block is not contiguous with buffered range, flush first
-      if (buffer_count > 0 && (buffer_count >= WRITE_BATCH_SIZE || current_block_number != buffer_lowest_block_num - 1))
-        flush_write_buffer();
-
-      // Place chunk at the appropriate position (filling from the end since blocks arrive in decreasing order)
-      write_buffer[WRITE_BATCH_SIZE - buffer_count - 1] = data_chunk;
-      if (buffer_count == 0)
-        buffer_lowest_block_num = current_block_number;
-      else
-        buffer_lowest_block_num = current_block_number; // current is always the new lowest
-      ++buffer_count;
-
-      if (idx >= BLOCKS_COUNT_INTERVAL_FOR_ARTIFACTS_SAVE)
-      {
-        flush_write_buffer();
-        ilog("Artifact generation just processed block ${current_block_number}. Processed blocks count: ${processed_blocks_count}, Target block: ${target_block_num}", (current_block_number)(processed_blocks_count)(target_block_num));
-        idx = 0;
-        _header.generating_interrupted_at_block = current_block_number;
-        flush_header();
-      }
-
-      ++processed_blocks_count;
-      ++idx;
+      const auto& block = blocks[i];
+      artifact_file_chunk& data_chunk = chunks[blocks.size() - 1 - i];
+      data_chunk.pack_data(block.block_log_file_pos, block.attributes);
+      data_chunk.pack_block_id(block.block_num, block.block_id);
     }
-    while (current_block_number > target_block_num);
+    write_data(chunks.front(), chunks.size(), calculate_offset(blocks.back().block_num), "Batch writing artifact file chunks");
+    processed_blocks_count.fetch_add(blocks.size(), std::memory_order_relaxed);
+    return !theApp.is_interrupt_request();
+  };
 
-    flush_write_buffer();
-    _header.generating_interrupted_at_block = current_block_number;
-  });
+  constexpr uint32_t BLOCKS_COUNT_INTERVAL_FOR_ARTIFACTS_SAVE = 1000000;
+  constexpr uint64_t PROGRESS_REPORT_INTERVAL_MS = 10000;
+  uint32_t last_saved_block_num = starting_block_num;
+  uint64_t last_report_time = time_begin;
 
-  auto block_processor = [&](const block_id_type& block_id, const uint64_t block_pos, const uint32_t block_num, const block_attributes_t attributes) -> bool
+  // Called (never concurrently) when all blocks down to given one are written - only such point can be saved in header,
+  // so the generation can be resumed from it after interruption.
+  auto progress_reporter = [&](const uint32_t processed_down_to_block_num)
   {
-    if (!theApp.is_interrupt_request() && queue_size.load(std::memory_order_relaxed) >= MAX_BLOCK_TO_PREFETCH)
+    if (last_saved_block_num - processed_down_to_block_num >= BLOCKS_COUNT_INTERVAL_FOR_ARTIFACTS_SAVE)
     {
-      std::unique_lock<std::mutex> lock(queue_mutex);
-      while (!theApp.is_interrupt_request() && queue_size.load(std::memory_order_relaxed) >= MAX_BLOCK_TO_PREFETCH)
-        queue_condition.wait(lock);
+      _header.generating_interrupted_at_block = processed_down_to_block_num;
+      flush_header();
+      last_saved_block_num = processed_down_to_block_num;
     }
-    if (theApp.is_interrupt_request())
-      return false;
-
-    auto block_with_artifacts = std::make_shared<block_artifact_data>();
-    block_with_artifacts->block_log_file_pos = block_pos;
-    block_with_artifacts->attributes = attributes;
-    block_with_artifacts->block_id = block_id;
-    block_with_artifacts->block_num = block_num;
-
-    artifact_queue.push(block_with_artifacts);
-    queue_size.fetch_add(1, std::memory_order_relaxed);
-    queue_condition.notify_one();
-    return true;
-  };
 
-  auto stop_writer_thread = [&]()
-  {
+    const uint64_t now = timestamp_ms();
+    if (now - last_report_time >= PROGRESS_REPORT_INTERVAL_MS)
     {
-      std::unique_lock<std::mutex> lock(queue_mutex);
-      artifact_queue.push(nullptr);
-      queue_condition.notify_one();
+      const uint32_t processed = processed_blocks_count.load(std::memory_order_relaxed);
+      const uint64_t elapsed_ms = std::max<uint64_t>(now - time_begin, 1);
+      ilog("Artifact generation progress: ${processed} of ${total} blocks (${percent}%), ${rate} blocks/s. All blocks down to ${processed_down_to_block_num} saved.",
+        (processed)("total", blocks_to_process)("percent", uint64_t(processed) * 100 / blocks_to_process)("rate", uint64_t(processed) * 1000 / elapsed_ms)
+        (processed_down_to_block_num));
+      last_report_time = now;
     }
-    artifacts_writer_thread.join();
   };
 
-  try
-  {
-    source_block_provider.read_blocks_data_for_artifacts_generation(block_processor, target_block_num, starting_block_num, starting_block_position);
-  }
-  catch (...)
-  {
-    stop_writer_thread();
-    throw;
-  }
-  stop_writer_thread();
+  const uint32_t processed_down_to_block_num = source_block_provider.read_blocks_data_for_artifacts_generation(block_processor, progress_reporter,
+    target_block_num, starting_block_num, starting_block_position);
+  const bool generating_interrupted = processed_down_to_block_num > target_block_num;
 
   const uint64_t time_end = timestamp_ms();
   const auto elapsed_time = time_end - time_begin;
 
-  if (!generating_interrupted)
+  if (generating_interrupted)
+  {
+    ilog("Artifacts file generation interrupted, all blocks down to ${processed_down_to_block_num} saved", (processed_down_to_block_num));
+    _header.generating_interrupted_at_block = processed_down_to_block_num;
+    flush_header();
+  }
+  else
   {
     _header.generating_interrupted_at_block = 0;
     _header.tail_block_num = calculate_tail_block_num(1);
@@ -737,7 +649,7 @@ void block_log_artifacts::impl::generate_artifacts_file(const block_log& source_
   }
 
   ilog("Block artifact file generation finished. Elapsed time: ${elapsed_time} ms. Processed blocks count: ${processed_blocks_count}. Generation interrupted: ${was_interrupted}.",
-    (elapsed_time)(processed_blocks_count)("was_interrupted", (static_cast<bool>(_header.generating_interrupted_at_block))));
+    (elapsed_time)("processed_blocks_count", processed_blocks_count.load())("was_interrupted", generating_interrupted));
 }
 
 void block_log_artifacts::impl::verify_if_blocks_from_block_log_matches_artifacts(const block_log& source_block_provider, const bool full_match_verification, const bool use_block_log_head_num) const
@@ -5,8 +5,6 @@
 
 #include <fc/exception/exception.hpp>
 
-#include <boost/scope_exit.hpp>
-
 #ifndef ZSTD_STATIC_LINKING_ONLY
 # define ZSTD_STATIC_LINKING_ONLY
 #endif
@@ -14,6 +12,84 @@
 
 namespace hive { namespace chain {
 
+namespace { /// anonymous
+
+/**
+ * zstd contexts and scratch buffer owned by a thread, used by every (de)compression call which doesn't supply
+ * its own context. Creating a context allocates several hundred kB, so doing it once per block during replay
+ * or p2p serving is pure overhead.
+ */
+struct zstd_thread_data
+{
+  ~zstd_thread_data()
+  {
+    ZSTD_freeCCtx(compression_context);
+    ZSTD_freeDCtx(decompression_context);
+  }
+
+  ZSTD_CCtx* get_compression_context()
+  {
+    if (!compression_context)
+    {
+      compression_context = ZSTD_createCCtx();
+      FC_ASSERT(compression_context, "Error creating zstd compression context");
+    }
+    ZSTD_CCtx_reset(compression_context, ZSTD_reset_session_and_parameters);
+    return compression_context;
+  }
+
+  /// decompression parameters don't change between calls, so session is reset only and dictionary stays bound if it is the same
+  ZSTD_DCtx* get_decompression_context(std::optional<uint8_t> dictionary_number)
+  {
+    if (!decompression_context)
+    {
+      decompression_context = ZSTD_createDCtx();
+      FC_ASSERT(decompression_context, "Error creating zstd decompression context");
+    }
+    else if (dictionary_number != bound_dictionary_number)
+    {
+      ZSTD_DCtx_reset(decompression_context, ZSTD_reset_session_and_parameters);
+      decompression_parameters_set = false;
+    }
+    else
+    {
+      ZSTD_DCtx_reset(decompression_context, ZSTD_reset_session_only);
+    }
+    return decompression_context;
+  }
+
+  /// buffer reused for every block processed by the thread, so it doesn't need to be allocated per block
+  char* get_scratch_buffer(size_t size)
+  {
+    if (scratch_buffer_size < size)
+    {
+      scratch_buffer.reset(new char[size]);
+      scratch_buffer_size = size;
+    }
+    return scratch_buffer.get();
+  }
+
+  ZSTD_CCtx* compression_context = nullptr;
+  ZSTD_DCtx* decompression_context = nullptr;
+  bool decompression_parameters_set = false;
+  std::optional<uint8_t> bound_dictionary_number;
+
+  std::unique_ptr<char[]> scratch_buffer;
+  size_t scratch_buffer_size = 0;
+};
+
+thread_local zstd_thread_data thread_data;
+
+/// copies data to a buffer of exactly the right size, since such buffers can be accumulated at caller side...
+std::tuple<std::unique_ptr<char[]>, size_t> copy_to_exact_size_buffer(const char* data, size_t size)
+{
+  std::unique_ptr<char[]> actual_buffer(new char[size]);
+  memcpy(actual_buffer.get(), data, size);
+  return std::make_tuple(std::move(actual_buffer), size);
+}
+
+} /// anonymous
+
 std::tuple<std::unique_ptr<char[]>, size_t> compress_block_zstd_helper(const char* uncompressed_block_data, 
                                                                          size_t uncompressed_block_size,
                                                                          std::optional<uint8_t> dictionary_number,
@@ -45,17 +121,16 @@ std::tuple<std::unique_ptr<char[]>, size_t> compress_block_zstd_helper(const cha
     ZSTD_CCtx_setParameter(compression_context, ZSTD_c_checksumFlag, 0);
 
     size_t zstd_max_size = ZSTD_compressBound(uncompressed_block_size);
-    std::unique_ptr<char[]> zstd_compressed_data(new char[zstd_max_size]);
+    char* zstd_compressed_data = thread_data.get_scratch_buffer(zstd_max_size);
 
     size_t zstd_compressed_size = ZSTD_compress2(compression_context, 
-                                                 zstd_compressed_data.get(), zstd_max_size,
+                                                 zstd_compressed_data, zstd_max_size,
                                                  uncompressed_block_data, uncompressed_block_size);
 
     if (ZSTD_isError(zstd_compressed_size))
       FC_THROW("Error compressing block with zstd");
 
-
-    return std::make_tuple(std::move(zstd_compressed_data), zstd_compressed_size);
+    return copy_to_exact_size_buffer(zstd_compressed_data, zstd_compressed_size);
   }
 
   /* static */ std::tuple<std::unique_ptr<char[]>, size_t> block_log_compression::decompress_raw_block(const char* raw_block_data, size_t raw_block_size, block_attributes_t attributes)
@@ -67,11 +142,7 @@ std::tuple<std::unique_ptr<char[]>, size_t> compress_block_zstd_helper(const cha
       case block_flags::zstd:
         return block_log_compression::decompress_block_zstd(raw_block_data, raw_block_size, attributes.dictionary_number);
       case block_flags::uncompressed:
-        {
-          std::unique_ptr<char[]> block_data_copy(new char[raw_block_size]);
-          memcpy(block_data_copy.get(), raw_block_data, raw_block_size);
-          return std::make_tuple(std::move(block_data_copy), raw_block_size);
-        }
+        return copy_to_exact_size_buffer(raw_block_data, raw_block_size);
       default:
         FC_THROW("Unrecognized block_flags in block log");
       }
@@ -107,47 +178,44 @@ std::tuple<std::unique_ptr<char[]>, size_t> compress_block_zstd_helper(const cha
                                         compression_level);
     }
 
-    ZSTD_CCtx* compression_context = ZSTD_createCCtx();
-    BOOST_SCOPE_EXIT(&compression_context) {
-      ZSTD_freeCCtx(compression_context);
-    } BOOST_SCOPE_EXIT_END
-
     return compress_block_zstd_helper(uncompressed_block_data, 
                                       uncompressed_block_size,
                                       dictionary_number,
-                                      compression_context,
+                                      thread_data.get_compression_context(),
                                       compression_level);
   }
 
   std::tuple<std::unique_ptr<char[]>, size_t> decompress_block_zstd_helper(const char* compressed_block_data,
                                                                            size_t compressed_block_size,
                                                                            std::optional<uint8_t> dictionary_number,
-                                                                           ZSTD_DCtx* decompression_context)
+                                                                           ZSTD_DCtx* decompression_context,
+                                                                           bool set_parameters = true)
   {
-    if (dictionary_number)
+    if (set_parameters)
     {
-      ZSTD_DDict* decompression_dictionary = get_zstd_decompression_dictionary(*dictionary_number);
-      size_t ref_ddict_result = ZSTD_DCtx_refDDict(decompression_context, decompression_dictionary);
-      if (ZSTD_isError(ref_ddict_result))
-        FC_THROW("Error loading decompression dictionary into context");
-    }
+      if (dictionary_number)
+      {
+        ZSTD_DDict* decompression_dictionary = get_zstd_decompression_dictionary(*dictionary_number);
+        size_t ref_ddict_result = ZSTD_DCtx_refDDict(decompression_context, decompression_dictionary);
+        if (ZSTD_isError(ref_ddict_result))
+          FC_THROW("Error loading decompression dictionary into context");
+      }
 
-    // tell zstd not to expect the first four bytes to be a magic number
-    ZSTD_DCtx_setParameter(decompression_context, ZSTD_d_format, ZSTD_f_zstd1_magicless);
+      // tell zstd not to expect the first four bytes to be a magic number
+      ZSTD_DCtx_setParameter(decompression_context, ZSTD_d_format, ZSTD_f_zstd1_magicless);
+    }
 
-    std::unique_ptr<char[]> uncompressed_block_data(new char[HIVE_MAX_BLOCK_SIZE]);
+    // blocks don't store their decompressed size, so we decompress to (reused) buffer that can hold any block
+    char* uncompressed_block_data = thread_data.get_scratch_buffer(HIVE_MAX_BLOCK_SIZE);
     size_t uncompressed_block_size = ZSTD_decompressDCtx(decompression_context,
-                                                         uncompressed_block_data.get(), HIVE_MAX_BLOCK_SIZE,
+                                                         uncompressed_block_data, HIVE_MAX_BLOCK_SIZE,
                                                          compressed_block_data, compressed_block_size);
     if (ZSTD_isError(uncompressed_block_size))
       FC_THROW("Error decompressing block with zstd: ${error}", ("error", ZSTD_getErrorName(uncompressed_block_size)));
     
     FC_ASSERT(uncompressed_block_size <= HIVE_MAX_BLOCK_SIZE);
 
-    /// Return a buffer adjusted to actual block size, since such buffers can be accumulated at caller side...
-    std::unique_ptr<char[]> actual_buffer(new char[uncompressed_block_size]);
-    memcpy(actual_buffer.get(), uncompressed_block_data.get(), uncompressed_block_size);
-    return std::make_tuple(std::move(actual_buffer), uncompressed_block_size);
+    return copy_to_exact_size_buffer(uncompressed_block_data, uncompressed_block_size);
   }
 
   /* static */ std::tuple<std::unique_ptr<char[]>, size_t> block_log_compression::decompress_block_zstd(
@@ -163,16 +231,15 @@ std::tuple<std::unique_ptr<char[]>, size_t> compress_block_zstd_helper(const cha
                                           *decompression_context_for_reuse);
     }
 
-    ZSTD_DCtx* decompression_context = ZSTD_createDCtx();
-    BOOST_SCOPE_EXIT(&decompression_context) {
-      ZSTD_freeDCtx(decompression_context);
-    } BOOST_SCOPE_EXIT_END
-
-    return decompress_block_zstd_helper(compressed_block_data, 
-                                        compressed_block_size,
-                                        dictionary_number,
-                                        decompression_context);
-
+    ZSTD_DCtx* decompression_context = thread_data.get_decompression_context(dictionary_number);
+    auto result = decompress_block_zstd_helper(compressed_block_data, 
+                                               compressed_block_size,
+                                               dictionary_number,
+                                               decompression_context,
+                                               !thread_data.decompression_parameters_set);
+    thread_data.bound_dictionary_number = dictionary_number;
+    thread_data.decompression_parameters_set = true;
+    return result;
   }
 
 } } // hive::chain
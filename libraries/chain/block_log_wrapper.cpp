@@ -468,7 +468,8 @@ void block_log_wrapper::internal_open_and_init( block_log_ptr_t the_log, const f
                           _open_args.enable_block_log_compression,
                           _open_args.block_log_compression_level,
                           _open_args.enable_block_log_auto_fixing,
-                          _thread_pool );
+                          _thread_pool,
+                          _open_args.enable_block_log_mmap_reads );
 }
 
 uint32_t block_log_wrapper::validate_tail_part_number( uint32_t tail_part_number,
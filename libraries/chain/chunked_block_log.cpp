@@ -0,0 +1,481 @@
+#include <hive/chain/chunked_block_log.hpp>
+#include <hive/chain/block_log_wrapper.hpp>
+#include <hive/chain/database_exceptions.hpp>
+#include <hive/chain/full_block.hpp>
+
+#include <hive/utilities/io_primitives.hpp>
+
+#include <fc/crypto/city.hpp>
+#include <fc/io/raw.hpp>
+
+#include <boost/range/adaptor/reversed.hpp>
+
+#include <zstd.h>
+
+#include <limits>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hive { namespace chain {
+
+namespace {
+  // "HIVECBLK" read as little endian number
+  const uint64_t chunked_block_log_magic = 0x4b4c424345564948ull;
+  const uint32_t chunked_block_log_format_version = 1;
+  // size reserved for file_header at the start of the file (packed header is smaller, rest is zeroed)
+  const size_t header_space = 64;
+  const size_t decoded_chunk_cache_size = 4;
+
+  uint64_t compute_chunk_checksum( const char* data, size_t size )
+  {
+    return fc::city_hash64( data, size );
+  }
+}
+
+const std::string chunked_block_log::_chunked_extension = ".chunked";
+
+std::shared_ptr<full_block_type> chunked_block_log::decoded_chunk::create_block( uint32_t index_in_chunk ) const
+{
+  FC_ASSERT( index_in_chunk < block_sizes.size() );
+  const uint32_t block_size = block_sizes[ index_in_chunk ];
+  std::unique_ptr<char[]> block_data( new char[ block_size ] );
+  memcpy( block_data.get(), data.get() + block_offsets[ index_in_chunk ], block_size );
+  return full_block_type::create_from_uncompressed_block_data( std::move( block_data ), block_size, block_ids[ index_in_chunk ] );
+}
+
+void chunked_block_log::create_from_block_log( const block_log_wrapper& source, const fc::path& output_file,
+  uint32_t first_block_num, uint32_t last_block_num, uint32_t blocks_per_chunk, int compression_level )
+{
+  FC_ASSERT( first_block_num > 0 && first_block_num <= last_block_num, "Invalid block range ${first_block_num} - ${last_block_num}",
+    (first_block_num)(last_block_num) );
+  FC_ASSERT( last_block_num <= source.head_block_num(), "Source block log ends at block ${head}, can't convert up to ${last_block_num}",
+    ("head", source.head_block_num())(last_block_num) );
+  FC_ASSERT( blocks_per_chunk > 0, "Chunk has to contain at least one block" );
+  FC_ASSERT( !fc::exists( output_file ), "Output file ${output_file} already exists", (output_file) );
+
+  const std::string output_file_str = output_file.generic_string();
+  int fd = ::open( output_file_str.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644 );
+  if( fd == -1 )
+    FC_THROW( "Error creating chunked block log file ${output_file}: ${error}", (output_file)( "error", strerror( errno ) ) );
+
+  try
+  {
+    std::vector<chunk_info> chunks;
+    uint64_t file_offset = header_space;
+    std::vector<char> chunk_data;
+    std::vector<char> compressed_chunk;
+
+    std::unique_ptr<ZSTD_CCtx, decltype( &ZSTD_freeCCtx )> compression_context( ZSTD_createCCtx(), &ZSTD_freeCCtx );
+    FC_ASSERT( compression_context, "Unable to create zstd compression context" );
+
+    for( uint32_t chunk_first_block = first_block_num; chunk_first_block <= last_block_num; )
+    {
+      const uint32_t block_count = std::min<uint32_t>( blocks_per_chunk, last_block_num - chunk_first_block + 1 );
+
+      std::vector<std::shared_ptr<full_block_type>> blocks;
+      blocks.reserve( block_count );
+      size_t blocks_size = 0;
+      for( uint32_t block_num = chunk_first_block; block_num < chunk_first_block + block_count; ++block_num )
+      {
+        std::shared_ptr<full_block_type> full_block = source.read_block_by_num( block_num );
+        FC_ASSERT( full_block, "Block ${block_num} is missing in source block log", (block_num) );
+        blocks_size += full_block->get_uncompressed_block_size();
+        blocks.push_back( std::move( full_block ) );
+      }
+
+      // chunk index first, then block data
+      const size_t index_size = sizeof( uint32_t ) + block_count * ( sizeof( uint32_t ) + sizeof( block_id_type ) );
+      // chunk directory keeps sizes on 32 bits
+      FC_ASSERT( index_size + blocks_size <= std::numeric_limits<uint32_t>::max(),
+        "Chunk starting at block ${chunk_first_block} would take ${size} bytes, use smaller --blocks-per-chunk",
+        (chunk_first_block)( "size", index_size + blocks_size ) );
+      chunk_data.resize( index_size + blocks_size );
+      fc::datastream<char*> index_stream( chunk_data.data(), index_size );
+      fc::raw::pack( index_stream, block_count );
+      char* block_data_pos = chunk_data.data() + index_size;
+      for( const auto& full_block : blocks )
+      {
+        const uncompressed_block_data& block_data = full_block->get_uncompressed_block();
+        fc::raw::pack( index_stream, static_cast<uint32_t>( block_data.raw_size ) );
+        fc::raw::pack( index_stream, full_block->get_block_id() );
+        memcpy( block_data_pos, block_data.raw_bytes.get(), block_data.raw_size );
+        block_data_pos += block_data.raw_size;
+      }
+
+      compressed_chunk.resize( ZSTD_compressBound( chunk_data.size() ) );
+      const size_t compressed_size = ZSTD_compressCCtx( compression_context.get(), compressed_chunk.data(), compressed_chunk.size(),
+        chunk_data.data(), chunk_data.size(), compression_level );
+      FC_ASSERT( !ZSTD_isError( compressed_size ), "Error compressing chunk starting at block ${chunk_first_block}: ${error}",
+        (chunk_first_block)( "error", ZSTD_getErrorName( compressed_size ) ) );
+      FC_ASSERT( compressed_size <= std::numeric_limits<uint32_t>::max(),
+        "Compressed chunk starting at block ${chunk_first_block} takes ${compressed_size} bytes, use smaller --blocks-per-chunk",
+        (chunk_first_block)(compressed_size) );
+
+      chunk_info chunk;
+      chunk.file_offset = file_offset;
+      chunk.compressed_size = compressed_size;
+      chunk.uncompressed_size = chunk_data.size();
+      chunk.first_block_num = chunk_first_block;
+      chunk.block_count = block_count;
+      chunk.checksum = compute_chunk_checksum( compressed_chunk.data(), compressed_size );
+      hive::utilities::perform_write( fd, compressed_chunk.data(), compressed_size, file_offset, "writing chunked block log" );
+      file_offset += compressed_size;
+      chunks.push_back( chunk );
+
+      if( chunks.size() % 100 == 0 )
+        ilog( "Written chunks up to block ${block_num}, ${size} bytes so far", ( "block_num", chunk_first_block + block_count - 1 )( "size", file_offset ) );
+
+      chunk_first_block += block_count;
+    }
+
+    const std::vector<char> directory = fc::raw::pack_to_vector( chunks );
+    hive::utilities::perform_write( fd, directory.data(), directory.size(), file_offset, "writing chunked block log directory" );
+
+    // header is written last, so interrupted conversion does not leave file that looks valid
+    file_header header;
+    header.magic = chunked_block_log_magic;
+    header.format_version = chunked_block_log_format_version;
+    header.first_block_num = first_block_num;
+    header.head_block_num = last_block_num;
+    header.blocks_per_chunk = blocks_per_chunk;
+    header.directory_offset = file_offset;
+    std::vector<char> packed_header = fc::raw::pack_to_vector( header );
+    FC_ASSERT( packed_header.size() <= header_space );
+    packed_header.resize( header_space, 0 );
+    hive::utilities::perform_write( fd, packed_header.data(), packed_header.size(), 0, "writing chunked block log header" );
+
+    FC_ASSERT( fsync( fd ) == 0, "Error syncing chunked block log file: ${error}", ( "error", strerror( errno ) ) );
+    ::close( fd );
+    ilog( "Chunked block log ${output_file} with ${count} chunks (blocks ${first_block_num} - ${last_block_num}) created, ${size} bytes",
+      (output_file)( "count", chunks.size() )(first_block_num)(last_block_num)( "size", file_offset + directory.size() ) );
+  }
+  catch( ... )
+  {
+    ::close( fd );
+    throw;
+  }
+}
+
+void chunked_block_log::write_to_block_log( const fc::path& chunked_file, block_log_wrapper& target,
+  blockchain_worker_thread_pool& thread_pool )
+{
+  chunked_block_log source( chunked_file );
+  const uint32_t target_head_block_num = target.head_block_num();
+  FC_ASSERT( target_head_block_num + 1 == source.tail_block_num(),
+    "Target block log ends at block ${target_head_block_num}, chunked block log starts at ${first}",
+    (target_head_block_num)( "first", source.tail_block_num() ) );
+
+  source.process_blocks( source.tail_block_num(), source.head_block_num(),
+    [&target]( const std::shared_ptr<full_block_type>& full_block ) -> bool
+    {
+      target.append( full_block, false /*is_at_live_sync*/ );
+      return true;
+    }, thread_pool );
+  target.flush_head_storage();
+}
+
+chunked_block_log::chunked_block_log( const fc::path& file ) : _file( file )
+{
+  const std::string file_str = _file.generic_string();
+  _fd = ::open( file_str.c_str(), O_RDONLY | O_CLOEXEC );
+  if( _fd == -1 )
+    FC_THROW( "Error opening chunked block log file ${file}: ${error}", ( "file", _file )( "error", strerror( errno ) ) );
+
+  try
+  {
+    struct stat file_stats;
+    FC_ASSERT( fstat( _fd, &file_stats ) == 0, "Error getting size of file: ${error}", ( "error", strerror( errno ) ) );
+    const uint64_t file_size = file_stats.st_size;
+    FC_ASSERT( file_size >= header_space, "${file} is too small to be chunked block log", ( "file", _file ) );
+
+    char header_data[ header_space ];
+    hive::utilities::perform_read( _fd, header_data, header_space, 0, "reading chunked block log header" );
+    fc::datastream<const char*> header_stream( header_data, header_space );
+    fc::raw::unpack( header_stream, _header );
+    FC_ASSERT( _header.magic == chunked_block_log_magic, "${file} is not chunked block log", ( "file", _file ) );
+    FC_ASSERT( _header.format_version == chunked_block_log_format_version, "Unsupported chunked block log format version ${v}",
+      ( "v", _header.format_version ) );
+    FC_ASSERT( _header.directory_offset >= header_space && _header.directory_offset < file_size,
+      "Chunked block log ${file} is corrupted (invalid directory offset)", ( "file", _file ) );
+
+    const size_t directory_size = file_size - _header.directory_offset;
+    std::unique_ptr<char[]> directory_data( new char[ directory_size ] );
+    hive::utilities::perform_read( _fd, directory_data.get(), directory_size, _header.directory_offset, "reading chunked block log directory" );
+    fc::datastream<const char*> directory_stream( directory_data.get(), directory_size );
+    fc::raw::unpack( directory_stream, _chunks );
+
+    // directory has to describe consecutive chunks covering whole block range
+    FC_ASSERT( !_chunks.empty(), "Chunked block log ${file} has no chunks", ( "file", _file ) );
+    uint32_t expected_first_block = _header.first_block_num;
+    uint64_t expected_offset = header_space;
+    for( const chunk_info& chunk : _chunks )
+    {
+      // all chunks but last have to be full, get_chunk_index() relies on it
+      const bool is_last = &chunk == &_chunks.back();
+      FC_ASSERT( chunk.first_block_num == expected_first_block && chunk.block_count > 0 &&
+                 ( is_last ? chunk.block_count <= _header.blocks_per_chunk : chunk.block_count == _header.blocks_per_chunk ) &&
+                 chunk.file_offset == expected_offset,
+        "Chunked block log ${file} is corrupted (invalid directory entry for block ${block_num})", ( "file", _file )( "block_num", expected_first_block ) );
+      expected_first_block += chunk.block_count;
+      expected_offset += chunk.compressed_size;
+    }
+    FC_ASSERT( expected_first_block == _header.head_block_num + 1 && expected_offset == _header.directory_offset,
+      "Chunked block log ${file} is corrupted (directory does not match header)", ( "file", _file ) );
+
+    _head_block = get_chunk( _chunks.size() - 1 )->create_block( _chunks.back().block_count - 1 );
+  }
+  catch( ... )
+  {
+    ::close( _fd );
+    throw;
+  }
+}
+
+chunked_block_log::~chunked_block_log()
+{
+  if( _fd != -1 )
+    ::close( _fd );
+}
+
+uint32_t chunked_block_log::get_chunk_index( uint32_t block_num ) const
+{
+  // all chunks but last are full (checked when directory is loaded)
+  return ( block_num - _header.first_block_num ) / _header.blocks_per_chunk;
+}
+
+chunked_block_log::decoded_chunk_ptr_t chunked_block_log::read_chunk( uint32_t chunk_index ) const
+{
+  const chunk_info& chunk = _chunks[ chunk_index ];
+  std::unique_ptr<char[]> compressed_data( new char[ chunk.compressed_size ] );
+  hive::utilities::perform_read( _fd, compressed_data.get(), chunk.compressed_size, chunk.file_offset, "reading chunked block log" );
+  FC_ASSERT( compute_chunk_checksum( compressed_data.get(), chunk.compressed_size ) == chunk.checksum,
+    "Checksum mismatch in chunk starting at block ${block_num} of ${file}", ( "block_num", chunk.first_block_num )( "file", _file ) );
+
+  auto result = std::make_shared<decoded_chunk>();
+  result->chunk_index = chunk_index;
+  result->data.reset( new char[ chunk.uncompressed_size ] );
+  result->size = ZSTD_decompress( result->data.get(), chunk.uncompressed_size, compressed_data.get(), chunk.compressed_size );
+  FC_ASSERT( !ZSTD_isError( result->size ) && result->size == chunk.uncompressed_size,
+    "Error decompressing chunk starting at block ${block_num} of ${file}", ( "block_num", chunk.first_block_num )( "file", _file ) );
+
+  fc::datastream<const char*> ds( result->data.get(), result->size );
+  uint32_t block_count = 0;
+  fc::raw::unpack( ds, block_count );
+  FC_ASSERT( block_count == chunk.block_count, "Block count mismatch in chunk starting at block ${block_num}", ( "block_num", chunk.first_block_num ) );
+  result->block_offsets.reserve( block_count );
+  result->block_sizes.resize( block_count );
+  result->block_ids.resize( block_count );
+  for( uint32_t i = 0; i < block_count; ++i )
+  {
+    fc::raw::unpack( ds, result->block_sizes[i] );
+    fc::raw::unpack( ds, result->block_ids[i] );
+  }
+  uint64_t offset = ds.tellp();
+  for( uint32_t size : result->block_sizes )
+  {
+    result->block_offsets.push_back( offset );
+    offset += size;
+  }
+  FC_ASSERT( offset == result->size, "Invalid block index in chunk starting at block ${block_num}", ( "block_num", chunk.first_block_num ) );
+
+  return result;
+}
+
+chunked_block_log::decoded_chunk_ptr_t chunked_block_log::get_chunk( uint32_t chunk_index ) const
+{
+  {
+    std::lock_guard<std::mutex> guard( _cache_mutex );
+    for( auto it = _cache.begin(); it != _cache.end(); ++it )
+    {
+      if( (*it)->chunk_index == chunk_index )
+      {
+        decoded_chunk_ptr_t result = *it;
+        _cache.splice( _cache.begin(), _cache, it );
+        return result;
+      }
+    }
+  }
+
+  // decode outside of the lock, in worst case two threads decode the same chunk
+  decoded_chunk_ptr_t result = read_chunk( chunk_index );
+  std::lock_guard<std::mutex> guard( _cache_mutex );
+  _cache.push_front( result );
+  if( _cache.size() > decoded_chunk_cache_size )
+    _cache.pop_back();
+  return result;
+}
+
+void chunked_block_log::verify() const
+{
+  for( uint32_t chunk_index = 0; chunk_index < _chunks.size(); ++chunk_index )
+    read_chunk( chunk_index );
+}
+
+std::shared_ptr<full_block_type> chunked_block_log::head_block() const
+{
+  return _head_block;
+}
+
+uint32_t chunked_block_log::head_block_num( fc::microseconds wait_for_microseconds /*= fc::microseconds()*/ ) const
+{
+  return _header.head_block_num;
+}
+
+block_id_type chunked_block_log::head_block_id( fc::microseconds wait_for_microseconds /*= fc::microseconds()*/ ) const
+{
+  return _head_block->get_block_id();
+}
+
+std::shared_ptr<full_block_type> chunked_block_log::read_block_by_num( uint32_t block_num ) const
+{
+  if( block_num < _header.first_block_num || block_num > _header.head_block_num )
+    return std::shared_ptr<full_block_type>();
+  if( block_num == _header.head_block_num )
+    return _head_block;
+
+  const uint32_t chunk_index = get_chunk_index( block_num );
+  return get_chunk( chunk_index )->create_block( block_num - _chunks[ chunk_index ].first_block_num );
+}
+
+void chunked_block_log::process_blocks( uint32_t starting_block_number, uint32_t ending_block_number,
+  block_processor_t processor, blockchain_worker_thread_pool& thread_pool ) const
+{
+  starting_block_number = std::max( starting_block_number, _header.first_block_num );
+  ending_block_number = std::min( ending_block_number, _header.head_block_num );
+  // chunks are decoded directly (not through cache) since each is used exactly once
+  for( uint32_t block_num = starting_block_number; block_num <= ending_block_number; )
+  {
+    const uint32_t chunk_index = get_chunk_index( block_num );
+    decoded_chunk_ptr_t chunk = read_chunk( chunk_index );
+    const uint32_t chunk_first_block = _chunks[ chunk_index ].first_block_num;
+    const uint32_t chunk_last_block = std::min( chunk_first_block + _chunks[ chunk_index ].block_count - 1, ending_block_number );
+    for( ; block_num <= chunk_last_block; ++block_num )
+    {
+      if( !processor( chunk->create_block( block_num - chunk_first_block ) ) )
+        return;
+    }
+  }
+}
+
+std::shared_ptr<full_block_type> chunked_block_log::fetch_block_by_id( const block_id_type& id ) const
+{
+  std::shared_ptr<full_block_type> block = read_block_by_num( protocol::block_header::num_from_id( id ) );
+  if( block && block->get_block_id() == id )
+    return block;
+  return std::shared_ptr<full_block_type>();
+}
+
+std::shared_ptr<full_block_type> chunked_block_log::get_block_by_number( uint32_t block_num,
+  fc::microseconds wait_for_microseconds /*= fc::microseconds()*/ ) const
+{
+  if( block_num == 0 || block_num > _header.head_block_num )
+    return std::shared_ptr<full_block_type>();
+
+  FC_ASSERT( block_num >= _header.first_block_num, "Block ${block_num} is not stored in ${file} (oldest stored block is ${first})",
+    (block_num)( "file", _file )( "first", _header.first_block_num ) );
+  return read_block_by_num( block_num );
+}
+
+std::vector<std::shared_ptr<full_block_type>> chunked_block_log::fetch_block_range( const uint32_t starting_block_num,
+  const uint32_t count, fc::microseconds wait_for_microseconds /*= fc::microseconds()*/ ) const
+{
+  FC_ASSERT( starting_block_num > 0, "Invalid starting block number" );
+  FC_ASSERT( count > 0, "Why ask for zero blocks?" );
+  FC_ASSERT( count <= 1000, "You can only ask for 1000 blocks at a time" );
+
+  std::vector<std::shared_ptr<full_block_type>> result;
+  if( starting_block_num < _header.first_block_num )
+    return result;
+  const uint32_t last_block_num = std::min<uint64_t>( (uint64_t)starting_block_num + count - 1, _header.head_block_num );
+  if( starting_block_num > last_block_num )
+    return result;
+
+  result.reserve( last_block_num - starting_block_num + 1 );
+  for( uint32_t block_num = starting_block_num; block_num <= last_block_num; ++block_num )
+    result.push_back( read_block_by_num( block_num ) );
+  return result;
+}
+
+bool chunked_block_log::is_known_block( const block_id_type& id ) const
+{
+  const uint32_t block_num = protocol::block_header::num_from_id( id );
+  if( block_num < _header.first_block_num || block_num > _header.head_block_num )
+    return false;
+  return find_block_id_for_num( block_num ) == id;
+}
+
+std::deque<block_id_type>::const_iterator chunked_block_log::find_first_item_not_in_blockchain(
+  const std::deque<block_id_type>& item_hashes_received ) const
+{
+  return std::partition_point( item_hashes_received.begin(), item_hashes_received.end(), [&]( const block_id_type& block_id ) {
+    return is_known_block( block_id );
+  } );
+}
+
+block_id_type chunked_block_log::find_block_id_for_num( uint32_t block_num ) const
+{
+  if( block_num < _header.first_block_num || block_num > _header.head_block_num )
+    FC_THROW_EXCEPTION( fc::key_not_found_exception, "block number not found" );
+
+  // ids are stored in chunk index, no need to construct the block
+  const uint32_t chunk_index = get_chunk_index( block_num );
+  return get_chunk( chunk_index )->block_ids[ block_num - _chunks[ chunk_index ].first_block_num ];
+}
+
+std::vector<block_id_type> chunked_block_log::get_blockchain_synopsis(
+  const block_id_type& reference_point, uint32_t number_of_blocks_after_reference_point ) const
+{
+  std::vector<block_id_type> synopsis;
+  const uint32_t reference_point_block_num = protocol::block_header::num_from_id( reference_point );
+  if( reference_point_block_num < _header.head_block_num )
+  {
+    FC_ASSERT( is_known_block( reference_point ), "Peer is on a fork I'm unable to switch to" );
+    synopsis.push_back( reference_point );
+  }
+  return synopsis;
+}
+
+std::vector<block_id_type> chunked_block_log::get_block_ids(
+  const std::vector<block_id_type>& blockchain_synopsis, uint32_t& remaining_item_count, uint32_t limit ) const
+{
+  remaining_item_count = 0;
+
+  // same as fork_db_block_reader, except all ids come from chunk indexes
+  block_id_type last_known_block_id;
+  if( !blockchain_synopsis.empty() &&
+      !( blockchain_synopsis.size() == 1 && blockchain_synopsis[0] == block_id_type() ) )
+  {
+    bool found_a_block_in_synopsis = false;
+    for( const block_id_type& block_id_in_synopsis : boost::adaptors::reverse( blockchain_synopsis ) )
+      if( block_id_in_synopsis == block_id_type() || is_known_block( block_id_in_synopsis ) )
+      {
+        last_known_block_id = block_id_in_synopsis;
+        found_a_block_in_synopsis = true;
+        break;
+      }
+
+    if( !found_a_block_in_synopsis )
+      FC_THROW_EXCEPTION( internal_peer_is_on_an_unreachable_fork, "Unable to provide a list of blocks starting at any of the blocks in peer's synopsis" );
+  }
+
+  const uint32_t first_block_num_in_reply = std::max<uint32_t>( protocol::block_header::num_from_id( last_known_block_id ), 1 );
+  if( first_block_num_in_reply < _header.first_block_num )
+    FC_THROW_EXCEPTION( internal_peer_is_on_an_unreachable_fork, "Blocks older than ${first} are not stored in ${file}",
+      ( "first", _header.first_block_num )( "file", _file ) );
+  if( limit == 0 || first_block_num_in_reply > _header.head_block_num )
+    return std::vector<block_id_type>();
+
+  const uint32_t last_block_num_in_reply = std::min<uint64_t>( (uint64_t)first_block_num_in_reply + limit - 1, _header.head_block_num );
+  std::vector<block_id_type> result;
+  result.reserve( last_block_num_in_reply - first_block_num_in_reply + 1 );
+  for( uint32_t block_num = first_block_num_in_reply; block_num <= last_block_num_in_reply; ++block_num )
+    result.push_back( find_block_id_for_num( block_num ) );
+
+  remaining_item_count = _header.head_block_num - last_block_num_in_reply;
+  return result;
+}
+
+} } // hive::chain
@@ -52,6 +52,7 @@
 
 #include <iostream>
 
+#include <algorithm>
 #include <cstdint>
 #include <deque>
 #include <fstream>
@@ -195,8 +196,13 @@ void database::initialize_state_independent_data(const open_args& args)
   }
 
   _benchmark_dumper.set_enabled(args.benchmark_is_enabled);
+  auto has_typed_handlers = []( const auto& typed_signals )
+  {
+    return std::any_of( typed_signals.begin(), typed_signals.end(), []( const auto& signal ) { return signal && !signal->empty(); } );
+  };
   if( _benchmark_dumper.is_enabled() &&
-      ( !_my->_pre_apply_operation_signal.empty() || !_my->_post_apply_operation_signal.empty() ) )
+      ( !_my->_pre_apply_operation_signal.empty() || !_my->_post_apply_operation_signal.empty() ||
+        has_typed_handlers( _my->_pre_apply_typed_operation_signals ) || has_typed_handlers( _my->_post_apply_typed_operation_signals ) ) )
   {
     wlog( "BENCHMARK will run into nested measurements - data on operations that emit vops will be lost!!!" );
   }
@@ -398,6 +404,20 @@ const account_object* database::find_account( const account_name_type& name )con
   return find< account_object, by_name >( name );
 }
 
+const account_details_object* database::find_account_details( const account_object& account )const
+{
+  return find< account_details_object, by_account >( account.get_id() );
+}
+
+void database::modify_account_details( const account_object& account, const std::function< void( account_details_object& ) >& modifier )
+{
+  const auto* details = find_account_details( account );
+  if( details == nullptr )
+    create< account_details_object >( account, modifier );
+  else
+    modify( *details, modifier );
+}
+
 comment database::get_comment( const account_id_type& author, const shared_string& permlink )const
 {
   return get_comments_handler().get_comment( author, to_string( permlink ), true /*comment_is_required*/ );
@@ -794,12 +814,21 @@ void post_push_virtual_operation( database& db, const operation& op, const fc::o
 
 void database::notify_pre_apply_operation( const operation_notification& note )
 {
+  // handlers registered for selected operation types go after all generic ones regardless of group
   HIVE_TRY_NOTIFY( _my->_pre_apply_operation_signal, note )
+  const auto& typed_signals = _my->_pre_apply_typed_operation_signals;
+  size_t which = note.op.which();
+  if( which < typed_signals.size() && typed_signals[ which ] )
+    HIVE_TRY_NOTIFY( *typed_signals[ which ], note )
 }
 
 void database::notify_post_apply_operation( const operation_notification& note )
 {
   HIVE_TRY_NOTIFY( _my->_post_apply_operation_signal, note )
+  const auto& typed_signals = _my->_post_apply_typed_operation_signals;
+  size_t which = note.op.which();
+  if( which < typed_signals.size() && typed_signals[ which ] )
+    HIVE_TRY_NOTIFY( *typed_signals[ which ], note )
 }
 
 void database::notify_pre_apply_block( const block_notification& note )
@@ -886,6 +915,11 @@ void database::notify_wipe()
   HIVE_TRY_NOTIFY(_my->_wipe_signal)
 }
 
+void database::notify_debug_state_change()
+{
+  HIVE_TRY_NOTIFY(_my->_debug_state_change_signal)
+}
+
 void database::notify_flush()
 {
   HIVE_TRY_NOTIFY( _my->_flush_signal )
@@ -1086,13 +1120,22 @@ void database::adjust_proxied_witness_votes( const account_object& a,
 
     const auto& proxy = get_account( a.get_proxy() );
 
-    modify( proxy, [&]( account_object& a )
+    if( _witness_votes_batch )
     {
+      auto& proxied_votes = _witness_votes_batch->proxied_votes[ proxy.get_id() ];
       for( int i = HIVE_MAX_PROXY_RECURSION_DEPTH - depth - 1; i >= 0; --i )
+        proxied_votes[i+depth] += delta[i];
+    }
+    else
+    {
+      modify( proxy, [&]( account_object& a )
       {
-        a.proxied_vsf_votes[i+depth] += delta[i];
-      }
-    } );
+        for( int i = HIVE_MAX_PROXY_RECURSION_DEPTH - depth - 1; i >= 0; --i )
+        {
+          a.proxied_vsf_votes[i+depth] += delta[i];
+        }
+      } );
+    }
 
     adjust_proxied_witness_votes( proxy, delta, depth + 1 );
   }
@@ -1115,10 +1158,17 @@ void database::adjust_proxied_witness_votes( const account_object& a, share_type
 
     const auto& proxy = get_account( a.get_proxy() );
 
-    modify( proxy, [&]( account_object& a )
+    if( _witness_votes_batch )
     {
-      a.proxied_vsf_votes[depth] += delta;
-    } );
+      _witness_votes_batch->proxied_votes[ proxy.get_id() ][depth] += delta;
+    }
+    else
+    {
+      modify( proxy, [&]( account_object& a )
+      {
+        a.proxied_vsf_votes[depth] += delta;
+      } );
+    }
 
     adjust_proxied_witness_votes( proxy, delta, depth + 1 );
   }
@@ -1128,6 +1178,40 @@ void database::adjust_proxied_witness_votes( const account_object& a, share_type
   }
 }
 
+void database::begin_witness_votes_batch()
+{
+#ifdef USE_ALTERNATE_CHAIN_ID
+  if( !configuration_data.batch_witness_votes )
+    return;
+#endif
+  FC_ASSERT( !_witness_votes_batch, "Nested batches of witness votes are not supported" );
+  _witness_votes_batch.emplace();
+}
+
+void database::apply_witness_votes_batch()
+{
+#ifdef USE_ALTERNATE_CHAIN_ID
+  if( !configuration_data.batch_witness_votes )
+    return;
+#endif
+  FC_ASSERT( _witness_votes_batch, "No batch of witness votes to apply" );
+  witness_votes_batch batch = std::move( *_witness_votes_batch );
+  _witness_votes_batch.reset();
+
+  for( const auto& proxy_delta : batch.proxied_votes )
+  {
+    modify( get< account_object >( proxy_delta.first ), [&]( account_object& a )
+    {
+      for( int i = 0; i < HIVE_MAX_PROXY_RECURSION_DEPTH; ++i )
+        a.proxied_vsf_votes[i] += proxy_delta.second[i];
+    } );
+  }
+  // note: witness is adjusted even if its deltas summed up to zero, just like it was with each separate change;
+  // new votes were already checked against total vesting shares after each step (see adjust_witness_votes)
+  for( const auto& witness_delta : batch.witness_votes )
+    adjust_witness_vote( get< witness_object >( witness_delta.first ), witness_delta.second, false );
+}
+
 void database::nullify_proxied_witness_votes( const account_object& a )
 {
   std::array<share_type, HIVE_MAX_PROXY_RECURSION_DEPTH + 1> delta;
@@ -1407,8 +1491,14 @@ void database::lock_account( const account_object& account )
   modify( account, []( account_object& a )
   {
     a.set_recovery_account( a );
-    a.memo_key = public_key_type();
   } );
+  if( find_account_details( account ) != nullptr )
+  {
+    modify_account_details( account, []( account_details_object& d )
+    {
+      d.memo_key = public_key_type();
+    } );
+  }
 
   auto rec_req = find< account_recovery_request_object, by_account >( account.get_name() );
   if( rec_req )
@@ -1655,8 +1745,15 @@ void database::process_delayed_voting( const block_notification& note )
 {
   if( has_hardfork( HIVE_HARDFORK_1_24 ) )
   {
+    begin_witness_votes_batch();
+    BOOST_SCOPE_EXIT( this_ )
+    {
+      this_->_witness_votes_batch.reset();
+    } BOOST_SCOPE_EXIT_END
+
     delayed_voting dv( *this );
     dv.run( note.get_block_timestamp() );
+    apply_witness_votes_batch();
   }
 }
 
@@ -2596,9 +2693,10 @@ void database::validate_transaction(const std::shared_ptr<full_transaction_type>
 
   if (!(skip & (skip_transaction_signatures | skip_authority_check)))
   {
-    auto get_active  =    [&]( const string& name ) { return authority( get< account_authority_object, by_account >( name ).active ); };
-    auto get_owner   =    [&]( const string& name ) { return authority( get< account_authority_object, by_account >( name ).owner );  };
-    auto get_posting =    [&]( const string& name ) { return authority( get< account_authority_object, by_account >( name ).posting );  };
+    // authorities are viewed directly in state (not copied), they don't change during verification
+    hive::protocol::authority_view_getter get_active  = [&]( const string& name ) { return hive::protocol::authority_view( get< account_authority_object, by_account >( name ).active ); };
+    hive::protocol::authority_view_getter get_owner   = [&]( const string& name ) { return hive::protocol::authority_view( get< account_authority_object, by_account >( name ).owner );  };
+    hive::protocol::authority_view_getter get_posting = [&]( const string& name ) { return hive::protocol::authority_view( get< account_authority_object, by_account >( name ).posting );  };
     auto get_witness_key = [&]( const string& name ) { try { return get_witness( name ).signing_key; } FC_CAPTURE_AND_RETHROW((name)) };
 
     try
@@ -3104,10 +3202,15 @@ void database::clear_expired_transactions()
 {
   //Look for expired transactions in the deduplication list, and remove them.
   //Transactions must have expired by at least two forking windows in order to be removed.
-  auto& transaction_idx = get_index< transaction_index >();
-  const auto& dedupe_index = transaction_idx.indices().get< by_expiration >();
-  while( ( !dedupe_index.empty() ) && ( head_block_time() > dedupe_index.begin()->expiration ) )
-    remove( *dedupe_index.begin() );
+  const auto now = head_block_time();
+  const auto& dedupe_index = get_index< transaction_index, by_expiration >();
+  auto itr = dedupe_index.begin();
+  while( itr != dedupe_index.end() && now > itr->expiration )
+  {
+    const auto& transaction = *itr;
+    ++itr;
+    remove( transaction );
+  }
 }
 
 void database::clear_expired_delegations()
@@ -12,12 +12,14 @@ void initialize_core_indexes_01( database& db )
 {
   HIVE_ADD_CORE_INDEX(db, dynamic_global_property_index);
   HIVE_ADD_CORE_INDEX(db, account_index);
+  HIVE_ADD_CORE_INDEX(db, account_details_index);
 }
 
 } }
 
 HIVE_DEFINE_TYPE_REGISTRAR_REGISTER_TYPE(hive::chain::dynamic_global_property_index)
 HIVE_DEFINE_TYPE_REGISTRAR_REGISTER_TYPE(hive::chain::account_index)
+HIVE_DEFINE_TYPE_REGISTRAR_REGISTER_TYPE(hive::chain::account_details_index)
 
 // Explicit template instantiations for chainbase::database methods
 template const chainbase::generic_index<hive::chain::dynamic_global_property_index>& chainbase::database::get_index<hive::chain::dynamic_global_property_index>() const;
@@ -25,3 +27,6 @@ template chainbase::generic_index<hive::chain::dynamic_global_property_index>& c
 
 template const chainbase::generic_index<hive::chain::account_index>& chainbase::database::get_index<hive::chain::account_index>() const;
 template chainbase::generic_index<hive::chain::account_index>& chainbase::database::get_mutable_index<hive::chain::account_index>();
+
+template const chainbase::generic_index<hive::chain::account_details_index>& chainbase::database::get_index<hive::chain::account_details_index>() const;
+template chainbase::generic_index<hive::chain::account_details_index>& chainbase::database::get_mutable_index<hive::chain::account_details_index>();
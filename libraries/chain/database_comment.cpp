@@ -23,7 +23,7 @@
 
 #include "database_vesting_helpers.hpp"
 
-#include <set>
+#include <algorithm>
 
 namespace hive { namespace chain {
 
@@ -155,15 +155,18 @@ HIVE_asset database::pay_curators( const comment_object& comment, const comment_
       const auto& cvidx = get_index<comment_vote_index, by_comment_voter>();
       auto itr = cvidx.lower_bound( comment.get_id() );
 
-      std::set< const comment_vote_object*, cmp > proxy_set;
+      // (weight, voter) is unique within comment, so sorted vector gives the same order as set would,
+      // but with single allocation instead of one per vote
+      std::vector< const comment_vote_object* > votes;
       while( itr != cvidx.end() && itr->get_comment() == comment.get_id() )
       {
-        proxy_set.insert( &( *itr ) );
+        votes.push_back( &( *itr ) );
         ++itr;
       }
+      std::sort( votes.begin(), votes.end(), cmp() );
 
       const auto& comment_author_name = get_account( comment_cashout.get_author_id() ).get_name();
-      for( auto& item : proxy_set )
+      for( auto& item : votes )
       { try {
         uint128_t weight( item->get_weight() );
         HIVE_asset claim( fc::uint128_to_int64( ( max_rewards.amount.value * weight ) / total_weight ) );
@@ -180,9 +183,9 @@ HIVE_asset database::pay_curators( const comment_object& comment, const comment_
               pre_push_virtual_operation( *this, vop );
             } );
 
-            modify( voter, [&]( account_object& a )
+            modify_account_details( voter, [&]( account_details_object& d )
             {
-              a.curation_rewards += claim;
+              d.curation_rewards += claim;
             });
           post_push_virtual_operation( *this, vop );
         }
@@ -316,9 +319,9 @@ HIVE_asset database::cashout_comment_helper( util::comment_reward_context& ctx,
         push_virtual_operation( *this, comment_reward_operation( comment_author, to_string( comment_cashout.get_permlink() ),
           to_hbd( claimed_reward ), author_tokens, payout, curator_payout, beneficiary_payout ) );
 
-        modify( author, [&]( account_object& a )
+        modify_account_details( author, [&]( account_details_object& d )
         {
-          a.posting_rewards += author_tokens;
+          d.posting_rewards += author_tokens;
         });
       }
 
@@ -425,22 +428,18 @@ void database::process_comment_cashout()
   const auto& cidx        = get_index< comment_cashout_index, by_cashout_time >();
   const auto& com_by_root = get_index< comment_cashout_ex_index, by_root >();
 
-  auto _current = cidx.begin();
-  // add all rshares about to be cashed out to the reward funds. This ensures equal satoshi per rshare payment
+  // comments due for payout are collected in single scan of the index; all their rshares are added to the
+  // reward funds before any payout is made. This ensures equal satoshi per rshare payment
+  std::vector< const comment_cashout_object* > due_cashouts;
   if( has_hardfork( HIVE_HARDFORK_0_17__771 ) )
   {
-    while( _current != cidx.end() && _current->get_cashout_time() <= _now )
+    const auto& rf = get_reward_fund();
+    for( auto _current = cidx.begin(); _current != cidx.end() && _current->get_cashout_time() <= _now; ++_current )
     {
       if( _current->get_net_rshares() > 0 )
-      {
-        const auto& rf = get_reward_fund();
         funds[ rf.get_id() ].recent_claims += util::evaluate_reward_curve( _current->get_net_rshares(), rf.author_reward_curve, rf.content_constant );
-      }
-
-      ++_current;
+      due_cashouts.push_back( &( *_current ) );
     }
-
-    _current = cidx.begin();
   }
 
   bool forward_curation_remainder = !has_hardfork( HIVE_HARDFORK_0_20__1877 );
@@ -461,11 +460,12 @@ void database::process_comment_cashout()
   auto block_num = head_block_num();
   if( _benchmark_dumper.is_enabled() )
     _benchmark_dumper.begin();
-  while( _current != cidx.end() && _current->get_cashout_time() <= _now )
+  if( has_hardfork( HIVE_HARDFORK_0_17__771 ) )
   {
-    if( has_hardfork( HIVE_HARDFORK_0_17__771 ) )
+    // payout of one comment does not affect cashout of any other, so collected list stays valid
+    auto fund_id = get_reward_fund().get_id();
+    for( const comment_cashout_object* _current : due_cashouts )
     {
-      auto fund_id = get_reward_fund().get_id();
       ctx.total_reward_shares2 = funds[ fund_id ].recent_claims;
       ctx.total_reward_fund_hive = funds[ fund_id ].reward_balance;
 
@@ -480,7 +480,12 @@ void database::process_comment_cashout()
         remove( *_current );
       }
     }
-    else
+  }
+  else
+  {
+    // payout of whole discussion moves cashout times of all its comments, so index has to be searched again each time
+    auto _current = cidx.begin();
+    while( _current != cidx.end() && _current->get_cashout_time() <= _now )
     {
       comment_id_type root_id = find_comment_cashout_ex( _current->get_comment_id() )->get_root_id();
       auto itr = com_by_root.lower_bound( root_id );
@@ -505,9 +510,9 @@ void database::process_comment_cashout()
           });
         }
       }
-    }
 
-    _current = cidx.begin();
+      _current = cidx.begin();
+    }
   }
   if( _benchmark_dumper.is_enabled() && count )
     _benchmark_dumper.end( "processing", "hive::protocol::comment_operation", count );
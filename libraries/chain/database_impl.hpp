@@ -13,6 +13,7 @@
 #include <atomic>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace hive { namespace chain {
 
@@ -49,6 +50,13 @@ class database_impl
       */
     fc::signal<void(const operation_notification&)>       _post_apply_operation_signal;
 
+    /**
+      *  Per operation type signals (indexed with operation::which(), empty for types nobody is interested in) for
+      *  handlers registered for selected operation types only.
+      */
+    std::vector< std::unique_ptr< fc::signal<void(const operation_notification&)> > > _pre_apply_typed_operation_signals;
+    std::vector< std::unique_ptr< fc::signal<void(const operation_notification&)> > > _post_apply_typed_operation_signals;
+
     fc::signal<void(const custom_operation_notification&)> _pre_apply_custom_operation_signal;
     fc::signal<void(const custom_operation_notification&)> _post_apply_custom_operation_signal;
 
@@ -129,6 +137,11 @@ class database_impl
       */
     fc::signal<void()>                                    _wipe_signal;
 
+    /**
+      *  This signal is emitted when state was modified outside of regular transaction/block processing (debug_node edits)
+      */
+    fc::signal<void()>                                    _debug_state_change_signal;
+
     /**
       *  This signal is emitted when storages have to be flushed
       */
@@ -240,7 +240,11 @@ void database::init_genesis()
 
     const auto init_witness = [&]( const account_name_type& account_name )
     {
-      create< account_object >( account_name, HIVE_GENESIS_TIME, init_public_key );
+      const auto& account = create< account_object >( account_name, HIVE_GENESIS_TIME );
+      modify_account_details( account, [&]( account_details_object& d )
+      {
+        d.memo_key = init_public_key;
+      } );
 
       create< account_authority_object >( [&]( account_authority_object& auth )
       {
@@ -276,7 +280,11 @@ void database::init_genesis()
     {
       const char* STEEM_ACCOUNT_NAME = "steem";
       auto STEEM_PUBLIC_KEY = public_key_type( HIVE_STEEM_PUBLIC_KEY_STR );
-      create< account_object >( STEEM_ACCOUNT_NAME, STEEM_PUBLIC_KEY, HIVE_GENESIS_TIME, HIVE_GENESIS_TIME, true, nullptr, true, VEST_asset( 0 ) );
+      const auto& steem_account = create< account_object >( STEEM_ACCOUNT_NAME, HIVE_GENESIS_TIME, HIVE_GENESIS_TIME, true, nullptr, true, VEST_asset( 0 ) );
+      modify_account_details( steem_account, [&]( account_details_object& d )
+      {
+        d.memo_key = STEEM_PUBLIC_KEY;
+      } );
       create< account_authority_object >( [&]( account_authority_object& auth )
       {
         auth.account = STEEM_ACCOUNT_NAME;
@@ -467,6 +475,39 @@ database::signal_connection_ptr database::add_post_apply_operation_handler( cons
   return hive::utilities::make_signal_connection_ptr( _my->_post_apply_operation_signal.connect(group, complex_func) );
 }
 
+database::signal_connection_ptr database::add_typed_apply_operation_handler( bool is_pre_operation, int64_t operation_tag,
+  const apply_operation_handler_t& func, const abstract_plugin& plugin, int32_t group )
+{
+  FC_ASSERT( operation_tag >= 0, "Invalid operation type" );
+  auto& typed_signals = is_pre_operation ? _my->_pre_apply_typed_operation_signals : _my->_post_apply_typed_operation_signals;
+  size_t which = operation_tag;
+  if( which >= typed_signals.size() )
+    typed_signals.resize( which + 1 );
+  if( !typed_signals[ which ] )
+    typed_signals[ which ] = std::make_unique< fc::signal<void(const operation_notification&)> >();
+
+  std::string context = is_pre_operation ?
+    util::advanced_benchmark_dumper::generate_context_desc< true >( plugin.get_name() ) :
+    util::advanced_benchmark_dumper::generate_context_desc< false >( plugin.get_name() );
+  auto complex_func = [this, func, context]( const operation_notification& o )
+  {
+    std::string name;
+
+    if (_benchmark_dumper.is_enabled())
+    {
+      name = o.op.get_stored_type_name();
+      _benchmark_dumper.begin();
+    }
+
+    func( o );
+
+    if (_benchmark_dumper.is_enabled())
+      _benchmark_dumper.end( context, name );
+  };
+
+  return hive::utilities::make_signal_connection_ptr( typed_signals[ which ]->connect(group, complex_func) );
+}
+
 database::signal_connection_ptr database::add_pre_apply_transaction_handler( const apply_transaction_handler_t& func,
   const abstract_plugin& plugin, int32_t group )
 {
@@ -569,6 +610,11 @@ database::signal_connection_ptr database::add_wipe_handler(const wipe_notificati
   return connect_signal_impl<false>(_my->_wipe_signal, func, _benchmark_dumper, plugin, group, "wipe storages");
 }
 
+database::signal_connection_ptr database::add_debug_state_change_handler(const debug_state_change_handler_t& func, const abstract_plugin& plugin, int32_t group)
+{
+  return connect_signal_impl<false>(_my->_debug_state_change_signal, func, _benchmark_dumper, plugin, group, "debug state change");
+}
+
 database::signal_connection_ptr database::add_flush_handler( const flush_handler_t& func,
   const abstract_plugin& plugin, int32_t group )
 {
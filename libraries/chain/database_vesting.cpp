@@ -14,6 +14,8 @@
 
 #include <hive/protocol/config.hpp>
 
+#include <boost/scope_exit.hpp>
+
 namespace hive { namespace chain {
 
 using hive::protocol::liquidity_reward_operation;
@@ -117,6 +119,12 @@ void database::process_vesting_withdrawals()
   const auto& cprops = get_dynamic_global_properties();
   auto now = cprops.time;
 
+  begin_witness_votes_batch();
+  BOOST_SCOPE_EXIT( this_ )
+  {
+    this_->_witness_votes_batch.reset();
+  } BOOST_SCOPE_EXIT_END
+
   int count = 0;
   if( _benchmark_dumper.is_enabled() )
     _benchmark_dumper.begin();
@@ -298,6 +306,7 @@ void database::process_vesting_withdrawals()
 
     post_push_virtual_operation( *this, vop );
   }
+  apply_witness_votes_batch();
   if( _benchmark_dumper.is_enabled() && count )
     _benchmark_dumper.end( "processing", "hive::protocol::withdraw_vesting_operation", count );
 }
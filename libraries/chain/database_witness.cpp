@@ -61,12 +61,25 @@ void database::adjust_witness_votes( const account_object& a, const share_type&
   auto itr = vidx.lower_bound( boost::make_tuple( a.get_name(), account_name_type() ) );
   while( itr != vidx.end() && itr->account == a.get_name() )
   {
-    adjust_witness_vote( get< witness_object, by_name >(itr->witness), delta );
+    const auto& witness = get< witness_object, by_name >( itr->witness );
+    if( _witness_votes_batch )
+    {
+      // total vesting shares change within the batch (power downs), so votes are checked after each step,
+      // with the value they would have at that point, just like when changes are applied immediately
+      share_type& batched_delta = _witness_votes_batch->witness_votes[ witness.get_id() ];
+      batched_delta += delta;
+      FC_ASSERT( witness.votes + batched_delta <= get_dynamic_global_properties().total_vesting_shares.amount, "",
+        ("w.votes", witness.votes + batched_delta)("props",get_dynamic_global_properties().total_vesting_shares) );
+    }
+    else
+    {
+      adjust_witness_vote( witness, delta );
+    }
     ++itr;
   }
 }
 
-void database::adjust_witness_vote( const witness_object& witness, share_type delta )
+void database::adjust_witness_vote( const witness_object& witness, share_type delta, bool check_total )
 {
   const witness_schedule_object& wso = has_hardfork(HIVE_HARDFORK_1_27_FIX_TIMESHARE_WITNESS_SCHEDULING) ?
                                        get_witness_schedule_object_for_irreversibility() : get_witness_schedule_object();
@@ -77,7 +90,8 @@ void database::adjust_witness_vote( const witness_object& witness, share_type de
 
     w.virtual_last_update = wso.current_virtual_time;
     w.votes += delta;
-    FC_ASSERT( w.votes <= get_dynamic_global_properties().total_vesting_shares.amount, "", ("w.votes", w.votes)("props",get_dynamic_global_properties().total_vesting_shares) );
+    if( check_total )
+      FC_ASSERT( w.votes <= get_dynamic_global_properties().total_vesting_shares.amount, "", ("w.votes", w.votes)("props",get_dynamic_global_properties().total_vesting_shares) );
 
     if( has_hardfork( HIVE_HARDFORK_0_2 ) )
       w.virtual_scheduled_time = w.virtual_last_update + (HIVE_VIRTUAL_SCHEDULE_LAP_LENGTH2 - w.virtual_position)/(w.votes.value+1);
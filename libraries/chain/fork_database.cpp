@@ -1,7 +1,6 @@
 #include <hive/chain/fork_database.hpp>
 
 #include <hive/chain/database_exceptions.hpp>
-#include <boost/range/algorithm/reverse.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
 namespace hive { namespace chain {
@@ -12,7 +11,7 @@ fork_database::fork_database()
 void fork_database::reset()
 {
   with_write_lock( [&]() {
-    _head.reset();
+    _set_head( item_ptr() );
     _index.clear();
   });
 }
@@ -23,7 +22,7 @@ void fork_database::pop_block()
     FC_ASSERT( _head, "cannot pop an empty fork database" );
     auto prev = _head->prev.lock();
     FC_ASSERT( prev, "popping head block would leave fork DB empty" );
-    _head = prev;
+    _set_head( prev );
   });
 }
 
@@ -32,7 +31,7 @@ void fork_database::start_block(const std::shared_ptr<full_block_type>& full_blo
   auto item = std::make_shared<fork_item>(full_block);
   with_write_lock([&]() {
     _index.insert(item);
-    _head = item;
+    _set_head( item );
   });
 }
 
@@ -101,7 +100,7 @@ void fork_database::_push_block(const item_ptr& item)
   // if we don't have a head block or this is the next block or on a longer fork than our head block
   //   make this the new head block
   if (!_head || item->get_block_num() > _head->get_block_num())
-    _head = item;
+    _set_head( item );
 
   _push_next(item); // check for any unlinked blocks that can now be linked to our fork
 }
@@ -116,6 +115,50 @@ shared_ptr<fork_item> fork_database::head_unlocked()const
   return _head;
 }
 
+void fork_database::_set_head( const item_ptr& new_head )
+{
+  _head = new_head;
+  if( !_head )
+  {
+    _main_branch.clear();
+    _main_branch_start = 0;
+    return;
+  }
+
+  // collect items of new branch down to common ancestor with old one (usually none or just new head)
+  std::vector<item_ptr> new_items;
+  item_ptr item = _head;
+  while( item && !_is_on_main_branch( item ) )
+  {
+    new_items.push_back( item );
+    if( !_main_branch.empty() && item->get_block_num() <= _main_branch_start )
+    {
+      item.reset(); // nothing older can be on main branch
+      break;
+    }
+    item = item->prev.lock();
+  }
+
+  if( item )
+  {
+    _main_branch.resize( item->get_block_num() - _main_branch_start + 1 );
+  }
+  else
+  {
+    _main_branch.clear();
+    _main_branch_start = new_items.back()->get_block_num();
+  }
+  for( const auto& new_item : boost::adaptors::reverse( new_items ) )
+    _main_branch.push_back( new_item );
+}
+
+bool fork_database::_is_on_main_branch( const item_ptr& item )const
+{
+  const uint32_t num = item->get_block_num();
+  return num >= _main_branch_start && num - _main_branch_start < _main_branch.size() &&
+    _main_branch[ num - _main_branch_start ] == item;
+}
+
 uint32_t fork_database::get_oldest_block_num_unlocked()const
 {
   auto const& block_num_idx = _index.get<block_num>();
@@ -130,6 +173,9 @@ uint32_t fork_database::get_oldest_block_num_unlocked()const
   */
 void fork_database::_push_next( const item_ptr& new_item )
 {
+    if( _unlinked_index.empty() )
+      return;
+
     auto& prev_idx = _unlinked_index.get<by_previous>();
 
     auto itr = prev_idx.find( new_item->get_block_id() );
@@ -182,6 +228,14 @@ void fork_database::set_max_size( uint32_t s )
         itr = by_num_idx.begin();
       }
     }
+    { /// main branch
+      while( _main_branch.size() > 1 &&
+             _main_branch_start <= std::max(int64_t(0),int64_t(_head->get_block_num()) - _max_size) )
+      {
+        _main_branch.pop_front();
+        ++_main_branch_start;
+      }
+    }
   });
 }
 
@@ -322,34 +376,29 @@ pair<fork_database::branch_type,fork_database::branch_type> fork_database::fetch
       second_branch = second_branch->prev.lock();
       FC_ASSERT(second_branch && "Can't lock");
     }
-    while( first_branch->previous_id() != second_branch->previous_id() )
+    // both branches are now at the same height; each block is represented by single item, so common ancestor is
+    // found by comparing items instead of their ids
+    while( first_branch != second_branch )
     {
       result.first.push_back(first_branch);
       result.second.push_back(second_branch);
+      if( first_branch->previous_id() == second_branch->previous_id() )
+        break; // common parent might be already pruned, no need to reach it
       first_branch = first_branch->prev.lock();
       FC_ASSERT(first_branch);
       second_branch = second_branch->prev.lock();
       FC_ASSERT(second_branch);
     }
-    if (first_branch && second_branch &&
-        first_branch->get_block_id() != second_branch->get_block_id())
-    {
-      result.first.push_back(first_branch);
-      result.second.push_back(second_branch);
-    }
     return result;
   });
 } FC_CAPTURE_AND_RETHROW( (first)(second) ) }
 
 shared_ptr<fork_item> fork_database::walk_main_branch_to_num_unlocked( uint32_t block_num )const
 {
-  shared_ptr<fork_item> next = _head; //don't call head(), we already have a read lock
-  if( block_num > next->get_block_num() )
+  // no need to actually walk, main branch is indexed by block number
+  if( block_num < _main_branch_start || block_num - _main_branch_start >= _main_branch.size() )
     return shared_ptr<fork_item>();
-
-  while( next.get() != nullptr && next->get_block_num() > block_num )
-    next = next->prev.lock();
-  return next;
+  return _main_branch[ block_num - _main_branch_start ];
 }
 
 shared_ptr<fork_item> fork_database::walk_main_branch_to_num( uint32_t block_num )const
@@ -368,13 +417,6 @@ shared_ptr<fork_item> fork_database::fetch_block_on_main_branch_by_number( uint3
 
 shared_ptr<fork_item> fork_database::fetch_block_on_main_branch_by_number_unlocked( uint32_t block_num )const
 {
-  if (!_head || block_num > _head->get_block_num())
-    return shared_ptr<fork_item>();
-  vector<item_ptr> blocks = fetch_block_by_number_unlocked(block_num);
-  if( blocks.size() == 1 )
-    return blocks[0];
-  if( blocks.size() == 0 )
-    return shared_ptr<fork_item>();
   return walk_main_branch_to_num_unlocked(block_num);
 }
 
@@ -393,27 +435,16 @@ vector<fork_item> fork_database::fetch_block_range_on_main_branch_by_number( con
     // but if the head block isn't to last_desired_block_num yet, the latest we can have is the head block
     const uint32_t last_block_num = std::min(last_desired_block_num, _head->get_block_num());
   
-    // look up that last block and see if we have it
-    const auto& block_num_idx = _index.get<block_num>();
-    const auto fork_items_for_last_block_num = boost::make_iterator_range(block_num_idx.equal_range(last_block_num));
-    // if we don't have it (it has already been moved to the block log), return an empty list
-    if (fork_items_for_last_block_num.empty())
+    // if we don't have that last block (it has already been moved to the block log), return an empty list
+    if (last_block_num < _main_branch_start)
       return results;
-    
-    // otherwise, walk backwards from that block, collecting blocks along the way.  Stop when
-    // we either reach the first block the caller asked for, or we run out of blocks in the fork database
-    shared_ptr<fork_item> item;
-    if (std::next(fork_items_for_last_block_num.begin()) == fork_items_for_last_block_num.end()) // if exactly one block numbered last_block_num
-      item = fork_items_for_last_block_num.front();
-    else
-      item = walk_main_branch_to_num_unlocked(last_block_num);
-  
-    for (; item && item->get_block_num() >= first_block_num; item = item->prev.lock())
-      results.push_back(*item);
-  
-    // we collected the blocks in descending order, reverse that order
-    boost::reverse(results);
-  
+
+    // otherwise collect blocks from the first the caller asked for, or the oldest one we still have
+    const uint32_t first_available_block_num = std::max(first_block_num, _main_branch_start);
+    results.reserve(last_block_num - first_available_block_num + 1);
+    for (uint32_t num = first_available_block_num; num <= last_block_num; ++num)
+      results.push_back(*_main_branch[num - _main_branch_start]);
+
     return results;
   }, wait_for_microseconds);
 }
@@ -421,7 +452,7 @@ vector<fork_item> fork_database::fetch_block_range_on_main_branch_by_number( con
 void fork_database::set_head(shared_ptr<fork_item> h)
 {
   with_write_lock( [&]() {
-    _head = std::move( h );
+    _set_head( h );
   });
 }
 
@@ -435,9 +466,19 @@ const item_ptr fork_database::get_head() const
 void fork_database::remove(block_id_type id)
 {
   with_write_lock( [&]() {
+    auto& index = _index.get<block_id>();
+    auto itr = index.find(id);
+    if (itr != index.end())
+    {
+      const item_ptr& item = *itr;
+      if (_is_on_main_branch(item)) // main branch can't lead through removed item anymore
+        _main_branch.resize(item->get_block_num() - _main_branch_start);
+      index.erase(itr);
+    }
     if (_head && _head->get_block_id() == id)
-      _head = _head->prev.lock();
-    _index.get<block_id>().erase(id);
+      _set_head(_head->prev.lock());
+    else
+      _set_head(_head);
   });
 }
 
@@ -523,14 +564,19 @@ std::vector<block_id_type> fork_database::get_blockchain_synopsis(block_id_type
 
     std::vector<block_id_type> block_ids_on_this_fork;
 
-    item_ptr next = *reference_point_iter;
-    while (next.get())
+    // when reference point is on main branch (e.g. our head block), blocks are taken directly from it
+    const bool reference_point_on_main_branch = _is_on_main_branch(*reference_point_iter) && low_block_num >= _main_branch_start;
+    if (!reference_point_on_main_branch)
     {
-      block_ids_on_this_fork.push_back(next->get_block_id());
-      next = next->prev.lock();
+      item_ptr next = *reference_point_iter;
+      while (next.get())
+      {
+        block_ids_on_this_fork.push_back(next->get_block_id());
+        next = next->prev.lock();
+      }
     }
 
-    // block_ids_on_this_fork now contains
+    // otherwise block_ids_on_this_fork now contains
     // [reference_point, ..., first_reversible_block, last_irreversible_block]
 
     // at this point:
@@ -543,7 +589,10 @@ std::vector<block_id_type> fork_database::get_blockchain_synopsis(block_id_type
     //idump((low_block_num)(reference_point_block_num)(true_high_block_num));
     do
     {
-      synopsis.push_back(block_ids_on_this_fork[block_ids_on_this_fork.size() - (low_block_num - last_irreversible_block_num) - 1]);
+      if (reference_point_on_main_branch)
+        synopsis.push_back(_main_branch[low_block_num - _main_branch_start]->get_block_id());
+      else
+        synopsis.push_back(block_ids_on_this_fork[block_ids_on_this_fork.size() - (low_block_num - last_irreversible_block_num) - 1]);
       low_block_num += (true_high_block_num - low_block_num + 2) / 2;
     }
     while (low_block_num <= reference_point_block_num);
@@ -63,6 +63,28 @@ full_block_type::~full_block_type()
   return full_block;
 }
 
+/* static */ std::shared_ptr<full_block_type> full_block_type::create_from_mapped_compressed_block_data(std::shared_ptr<const char> compressed_bytes,
+                                                                                                        size_t compressed_size,
+                                                                                                        const block_attributes_t& compression_attributes,
+                                                                                                        const std::optional<block_id_type> block_id /* = std::optional<block_id_type>() */)
+{
+  std::shared_ptr<full_block_type> full_block = std::make_shared<full_block_type>();
+  full_block->compressed_block.compression_attributes = compression_attributes;
+  full_block->compressed_block.mapped_compressed_bytes = std::move(compressed_bytes);
+  full_block->compressed_block.compressed_size = compressed_size;
+  full_block->has_compressed_block.store(true, std::memory_order_release);
+  if (!compression_attributes.dictionary_number)
+    full_block->has_alternate_compressed_block.store(true, std::memory_order_release);
+
+  if (block_id)
+  {
+    full_block->block_id = *block_id;
+    full_block->has_block_id.store(true, std::memory_order_release);
+  }
+
+  return full_block;
+}
+
 /* static */ std::shared_ptr<full_block_type> full_block_type::create_from_uncompressed_block_data(std::unique_ptr<char[]>&& raw_bytes, size_t raw_size,
                                                                                                    const std::optional<block_id_type> block_id /* = std::optional<block_id_type>() */)
 { try {
@@ -191,7 +213,7 @@ void full_block_type::decompress_block() const
 
     std::shared_ptr<decoded_block_storage_type> temp_decoded_block_storage = std::make_shared<decoded_block_storage_type>();
     std::tie(temp_decoded_block_storage->uncompressed_block.raw_bytes, temp_decoded_block_storage->uncompressed_block.raw_size) = 
-      block_log_compression::decompress_raw_block(compressed_block.compressed_bytes.get(), 
+      block_log_compression::decompress_raw_block(compressed_block.data(), 
                                                   compressed_block.compressed_size, 
                                                   compressed_block.compression_attributes);
 
@@ -468,7 +490,7 @@ void full_block_type::decode_block() const
     fc::unsigned_int number_of_transactions;
     fc::raw::unpack(datastream, number_of_transactions);
     decoded_block_storage->block->transactions.resize(number_of_transactions.value);
-    full_transactions.resize(number_of_transactions.value);
+    std::vector<serialized_transaction_data> serialized_transactions(number_of_transactions.value);
     for (unsigned i = 0; i < number_of_transactions.value; ++i)
     {
       // The transaction hierarchy is:
@@ -478,20 +500,20 @@ void full_block_type::decode_block() const
       // the transaction digest, transaction_id, and sig_digest are simply computed the fields in the `transaction` base 
       // class.  The `merkle_digest()` also includes the signatures, so just like the block, we need to decode the 
       // transaction in parts and record off the start/end points
-      serialized_transaction_data serialized_transaction;
+      serialized_transaction_data& serialized_transaction = serialized_transactions[i];
       serialized_transaction.begin = decoded_block_storage->uncompressed_block.raw_bytes.get() + datastream.tellp();
       fc::raw::unpack(datastream, (hive::protocol::transaction&)decoded_block_storage->block->transactions[i]);
       serialized_transaction.transaction_end = decoded_block_storage->uncompressed_block.raw_bytes.get() + datastream.tellp();
       fc::raw::unpack(datastream, decoded_block_storage->block->transactions[i].signatures);
       serialized_transaction.signed_transaction_end = decoded_block_storage->uncompressed_block.raw_bytes.get() + datastream.tellp();
-    
-      // if we're in live mode (as opposed to not syncing/replaying), use the transaction cache to see if transactions in this
-      // block were previously seen as standalone transactions.  If so, we can reuse their data and avoid re-validating the transaction
-      const bool use_transaction_cache = fc::time_point::now() - decoded_block_storage->block->timestamp < fc::minutes(1);
-      full_transactions[i] = full_transaction_type::create_from_block(decoded_block_storage, i, serialized_transaction, use_transaction_cache);
     }
     FC_ASSERT(datastream.remaining() == 0 && "Error: data leftover after decoding block");
 
+    // if we're in live mode (as opposed to not syncing/replaying), use the transaction cache to see if transactions in this
+    // block were previously seen as standalone transactions.  If so, we can reuse their data and avoid re-validating the transaction
+    const bool use_transaction_cache = fc::time_point::now() - decoded_block_storage->block->timestamp < fc::minutes(1);
+    full_transactions = full_transaction_type::create_from_block(decoded_block_storage, serialized_transactions, use_transaction_cache);
+
     fc::time_point decode_block_end = fc::time_point::now();
     decode_block_time = decode_block_end - decode_block_begin;
 
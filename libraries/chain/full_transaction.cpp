@@ -260,6 +260,32 @@ const hive::protocol::required_authorities_type& full_transaction_type::get_requ
   return required_authorities;
 }
 
+namespace
+{
+  // stream for fc::raw::pack that only checks if packed data is the same as given serialized bytes
+  class comparing_stream
+  {
+    public:
+      comparing_stream(const char* begin, const char* end) : pos(begin), end(end) {}
+
+      void write(const char* data, size_t size)
+      {
+        if (equal && size_t(end - pos) >= size && memcmp(pos, data, size) == 0)
+          pos += size;
+        else
+          equal = false;
+      }
+      void put(char c) { write(&c, 1); }
+
+      bool matches_whole() const { return equal && pos == end; }
+
+    private:
+      const char* pos;
+      const char* end;
+      bool equal = true;
+  };
+}
+
 bool full_transaction_type::is_legacy_pack() const
 {
   if (!has_is_packed_in_legacy_format.load(std::memory_order_consume))
@@ -268,18 +294,12 @@ bool full_transaction_type::is_legacy_pack() const
 
     if (!has_is_packed_in_legacy_format.load(std::memory_order_consume))
     {
+      // signatures are packed the same way in both formats, so only the transaction part needs to be checked;
+      // it is compared directly against serialized bytes, without packing into temporary buffer
       hive::protocol::serialization_mode_controller::pack_guard guard(hive::protocol::pack_type::legacy);
-      const hive::protocol::signed_transaction& transaction = get_transaction();
-      size_t packed_size = fc::raw::pack_size(transaction);
-      if (packed_size != get_transaction_size())
-        is_packed_in_legacy_format = false;
-      else
-      {
-        std::unique_ptr<char[]> packed_bytes(new char[packed_size]);
-        fc::datastream<char*> stream(packed_bytes.get(), packed_size);
-        fc::raw::pack(stream, transaction);
-        is_packed_in_legacy_format = memcmp(packed_bytes.get(), serialized_transaction.begin, packed_size) == 0;
-      }
+      comparing_stream stream(serialized_transaction.begin, serialized_transaction.transaction_end);
+      fc::raw::pack(stream, static_cast<const hive::protocol::transaction&>(get_transaction()));
+      is_packed_in_legacy_format = stream.matches_whole();
 
       has_is_packed_in_legacy_format.store(true, std::memory_order_release);
     }
@@ -331,8 +351,8 @@ void full_transaction_type::sign_transaction(const std::vector<hive::protocol::p
     }
   }
 
-  /// Now serialized buffer must be updated, since new signatures has been added.
-  serialized_transaction = fill_serialization_buffer(tx, serialization_type, &standalone_transaction.serialization_buffer);
+  /// Now serialized buffer must be updated, since new signatures has been added (transaction part stays the same).
+  serialized_transaction = replace_serialized_signatures(tx, serialized_transaction, &standalone_transaction.serialization_buffer);
   if( cache )
   {
     signature_info = std::move( new_signature_info );
@@ -340,16 +360,31 @@ void full_transaction_type::sign_transaction(const std::vector<hive::protocol::p
   }
 }
 
-/* static */ full_transaction_ptr full_transaction_type::create_from_block(const std::shared_ptr<decoded_block_storage_type>& block_storage, 
-                                                                           uint32_t index_in_block, 
-                                                                           const serialized_transaction_data& serialized_transaction,
-                                                                           bool use_transaction_cache)
+/* static */ std::vector<full_transaction_ptr> full_transaction_type::create_from_block(const std::shared_ptr<decoded_block_storage_type>& block_storage,
+                                                                                        const std::vector<serialized_transaction_data>& serialized_transactions,
+                                                                                        bool use_transaction_cache)
 {
-  full_transaction_ptr full_transaction = std::make_shared<full_transaction_type>();
-  full_transaction->storage = contained_in_block_info{block_storage, index_in_block};
-  full_transaction->serialized_transaction = serialized_transaction;
+  // all transactions of the block are allocated together (instead of separate allocation per transaction) and share
+  // control block, so they are released together when the last of them is no longer referenced; since each of them
+  // holds the decoded block anyway, it does not extend lifetime of the block data;
+  // it does extend lifetime of sibling transactions though - a single transaction that is still referenced (f.e. by
+  // pending transactions, p2p layer or a locked entry of transaction cache) keeps all other transactions of its block
+  // alive, together with their cached signature/authority/validation data
+  const uint32_t number_of_transactions = serialized_transactions.size();
+  std::shared_ptr<std::vector<full_transaction_type>> block_transactions = std::make_shared<std::vector<full_transaction_type>>(number_of_transactions);
+
+  std::vector<full_transaction_ptr> full_transactions;
+  full_transactions.reserve(number_of_transactions);
+  for (uint32_t index_in_block = 0; index_in_block < number_of_transactions; ++index_in_block)
+  {
+    full_transaction_type& transaction = (*block_transactions)[index_in_block];
+    transaction.storage = contained_in_block_info{block_storage, index_in_block};
+    transaction.serialized_transaction = serialized_transactions[index_in_block];
 
-  return use_transaction_cache ? full_transaction_cache::get_instance().add_to_cache(full_transaction) : full_transaction;
+    full_transaction_ptr full_transaction(block_transactions, &transaction);
+    full_transactions.push_back(use_transaction_cache ? full_transaction_cache::get_instance().add_to_cache(full_transaction) : full_transaction);
+  }
+  return full_transactions;
 }
 
 /*static*/full_transaction_ptr full_transaction_type::build_transaction_object(const hive::protocol::signed_transaction& transaction, hive::protocol::pack_type serialization_type)
@@ -385,6 +420,30 @@ void full_transaction_type::sign_transaction(const std::vector<hive::protocol::p
   return data;
 }
 
+/*static*/ serialized_transaction_data full_transaction_type::replace_serialized_signatures(const hive::protocol::signed_transaction& transaction,
+  const serialized_transaction_data& serialized_transaction, uncompressed_memory_buffer* serialization_buffer)
+{
+  FC_ASSERT(serialized_transaction.begin == serialization_buffer->raw_bytes.get(), "Serialized transaction has to be held by given buffer");
+  const size_t transaction_size = serialized_transaction.transaction_end - serialized_transaction.begin;
+
+  // signatures are packed the same way regardless of serialization type
+  uncompressed_memory_buffer new_buffer;
+  new_buffer.raw_size = transaction_size + fc::raw::pack_size(transaction.signatures);
+  new_buffer.raw_bytes.reset(new char[new_buffer.raw_size]);
+  memcpy(new_buffer.raw_bytes.get(), serialized_transaction.begin, transaction_size);
+
+  serialized_transaction_data data;
+
+  data.begin = new_buffer.raw_bytes.get();
+  data.transaction_end = data.begin + transaction_size;
+  fc::datastream<char*> stream(new_buffer.raw_bytes.get() + transaction_size, new_buffer.raw_size - transaction_size);
+  fc::raw::pack(stream, transaction.signatures);
+  data.signed_transaction_end = data.transaction_end + stream.tellp();
+
+  *serialization_buffer = std::move(new_buffer);
+  return data;
+}
+
 /*static*/ full_transaction_ptr full_transaction_type::create_from_transaction(const hive::protocol::transaction& transaction,
                                                                                hive::protocol::pack_type serialization_type)
 {
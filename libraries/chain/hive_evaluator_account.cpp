@@ -149,8 +149,16 @@ const account_object& create_account( database& db, const account_name_type& nam
   }
 
   HIVE_CHAIN_STATE_ASSERT( db.find_account( name ) == nullptr, name, "Account ${name} already exists.", ( name ) );
-  return db.create< account_object >( name, key, _creation_time, _block_creation_time, mined, recovery_account,
+  const auto& new_account = db.create< account_object >( name, _creation_time, _block_creation_time, mined, recovery_account,
     !db.has_hardfork( HIVE_HARDFORK_0_20__2539 ) /*voting mana 100%*/, initial_delegation, rc_adjustment_from_fee );
+  if( key != public_key_type() )
+  {
+    db.modify_account_details( new_account, [&]( account_details_object& d )
+    {
+      d.memo_key = key;
+    } );
+  }
+  return new_account;
 }
 
 void account_create_evaluator::do_apply( const account_create_operation& o )
@@ -338,12 +346,12 @@ void account_update_evaluator::do_apply( const account_update_operation& o )
     }
   }
 
-  _db.modify( account, [&]( account_object& acc )
+  _db.modify_account_details( account, [&]( account_details_object& d )
   {
     if( o.memo_key != public_key_type() )
-      acc.memo_key = o.memo_key;
+      d.memo_key = o.memo_key;
 
-    acc.last_account_update = _db.head_block_time(); //not needed for consensus
+    d.last_account_update = _db.head_block_time();
   } );
 
   if( o.active || *_auth_posting )
@@ -380,12 +388,12 @@ void account_update2_evaluator::do_apply( const account_update2_operation& o )
   if( o.posting )
     verify_authority_accounts_exist( _db, *o.posting, o.account, authority::posting );
 
-  _db.modify( account, [&]( account_object& acc )
+  _db.modify_account_details( account, [&]( account_details_object& d )
   {
     if( o.memo_key && *o.memo_key != public_key_type() )
-      acc.memo_key = *o.memo_key;
+      d.memo_key = *o.memo_key;
 
-    acc.last_account_update = _db.head_block_time(); //not needed for consensus
+    d.last_account_update = _db.head_block_time();
   } );
 
   if( o.active || o.posting )
@@ -582,8 +590,11 @@ void recover_account_evaluator::do_apply( const recover_account_operation& o )
   _db.modify( account, [&]( account_object& a )
   {
     a.set_last_account_recovery_time( _db.head_block_time() );
-    a.set_block_last_account_recovery_time( _db.get_current_timestamp() );
   });
+  _db.modify_account_details( account, [&]( account_details_object& d )
+  {
+    d.block_last_account_recovery = _db.get_current_timestamp();
+  } );
 }
 
 void change_recovery_account_evaluator::do_apply( const change_recovery_account_operation& o )
@@ -1,4 +1,11 @@
+#pragma once
+
+#include <fc/filesystem.hpp>
+#include <fc/reflect/reflect.hpp>
+
 #include <cstdint>
+#include <optional>
+#include <vector>
 
 extern "C"
 {
@@ -8,9 +15,33 @@ extern "C"
   typedef struct ZSTD_DDict_s ZSTD_DDict;
 }
 
+// dictionary numbers below are reserved for dictionaries built into hived, custom dictionaries (trained for particular
+// chain/block range and loaded at runtime) use numbers from here up; they are never advertised to or expected from peers
+#define HIVE_FIRST_CUSTOM_ZSTD_DICTIONARY_NUMBER 200
+
 namespace hive { namespace chain {
+  /// dictionary trained for given range of blocks, stored in a side file next to block log (see compress_block_log)
+  struct custom_zstd_dictionary
+  {
+    uint8_t           dictionary_number = HIVE_FIRST_CUSTOM_ZSTD_DICTIONARY_NUMBER;
+    uint32_t          first_block = 0; /// first block that should be compressed with the dictionary
+    uint32_t          last_block = 0; /// last block that should be compressed with the dictionary
+    std::vector<char> dictionary; /// raw (uncompressed) zstd dictionary
+  };
+
   std::optional<uint8_t> get_best_available_zstd_compression_dictionary_number_for_block(uint32_t block_number);
+  /// last of the dictionaries built into hived (custom dictionaries are not included)
   std::optional<uint8_t> get_last_available_zstd_compression_dictionary_number();
+  /// tells if block log can contain blocks compressed with given dictionary (built-in or custom one, even if not loaded yet)
+  bool is_plausible_zstd_compression_dictionary_number(uint8_t dictionary_number);
   ZSTD_CDict* get_zstd_compression_dictionary(uint8_t dictionary_number, int compression_level);
   ZSTD_DDict* get_zstd_decompression_dictionary(uint8_t dictionary_number);
+
+  /// makes custom dictionary available for (de)compression; has to be done before any block is compressed with it
+  void register_custom_zstd_compression_dictionary(const custom_zstd_dictionary& dictionary);
+  /// reads and registers all dictionaries from side file
+  std::vector<custom_zstd_dictionary> load_custom_zstd_compression_dictionaries(const fc::path& dictionaries_file);
+  void save_custom_zstd_compression_dictionaries(const fc::path& dictionaries_file, const std::vector<custom_zstd_dictionary>& dictionaries);
 } }
+
+FC_REFLECT( hive::chain::custom_zstd_dictionary, (dictionary_number)(first_block)(last_block)(dictionary) )
@@ -118,7 +118,8 @@ namespace hive { namespace chain {
                           bool enable_compression,
                           int compression_level,
                           bool enable_block_log_auto_fixing,
-                          hive::chain::blockchain_worker_thread_pool& thread_pool );
+                          hive::chain::blockchain_worker_thread_pool& thread_pool,
+                          bool enable_mmap_reads = false );
       void close();
       bool is_open()const;
 
@@ -134,6 +135,9 @@ namespace hive { namespace chain {
       void flush();
       std::tuple<std::unique_ptr<char[]>, size_t, block_log_artifacts::block_attributes_t> read_common_raw_block_data_by_num(uint32_t block_num) const;
       std::tuple<std::unique_ptr<char[]>, size_t, block_log_artifacts::artifacts_t> read_raw_block_data_by_num(uint32_t block_num) const;
+      /// Like above, but returns pointer directly into memory mapped block log (valid as long as the pointer is held).
+      /// Only available when block log was opened with mmap reads enabled.
+      std::tuple<std::shared_ptr<const char>, size_t, block_log_artifacts::artifacts_t> read_mapped_raw_block_data_by_num(uint32_t block_num) const;
       void multi_read_raw_block_data(uint32_t first_block_num, uint32_t last_block_num_from_disk,
         block_log_artifacts::artifact_container_t& plural_of_block_artifacts,
         std::unique_ptr<char[]>& block_data_buffer, size_t& block_data_buffer_size ) const;
@@ -156,12 +160,25 @@ namespace hive { namespace chain {
       /// Allows to process blocks in REVERSE order.
       void for_each_block_position(block_info_processor_t processor) const;
 
-      /// return true to continue processing, false to stop iteration.
-      /// Processor args: block_id, block_log_file_pos, block_num, block_attributes
-      typedef std::function<bool(const block_id_type&, const uint64_t, const uint32_t, const block_attributes_t)> artifacts_generation_processor;
-      /// processes blocks in REVERSE order.  This only reads the block_log file, and can be used for rebuilding the artifacts/index file
-      void read_blocks_data_for_artifacts_generation(artifacts_generation_processor processor, const uint32_t target_block_number, const uint32_t starting_block_number,
-                                                     const fc::optional<uint64_t> starting_block_position = fc::optional<uint64_t>()) const;
+      struct artifacts_generation_entry
+      {
+        uint64_t           block_log_file_pos;
+        uint32_t           block_num;
+        uint32_t           block_serialized_data_size;
+        block_attributes_t attributes;
+        block_id_type      block_id;
+      };
+      /// return true to continue processing, false to stop iteration (passed blocks count as processed either way).
+      /// Called concurrently from worker threads, each call receives consecutive blocks in decreasing block number order.
+      typedef std::function<bool(const std::vector<artifacts_generation_entry>&)> artifacts_generation_processor;
+      /// called (never concurrently) each time all blocks from starting one down to given block number were processed
+      typedef std::function<void(uint32_t)> artifacts_generation_progress_t;
+      /// processes blocks in REVERSE order, independent block ranges in parallel.  This only reads the block_log file, and can be used
+      /// for rebuilding the artifacts/index file. Returns lowest block number such that all blocks from starting one down to it were processed
+      /// (target_block_number unless processing was stopped).
+      uint32_t read_blocks_data_for_artifacts_generation(artifacts_generation_processor processor, artifacts_generation_progress_t progress,
+                                                         const uint32_t target_block_number, const uint32_t starting_block_number,
+                                                         const fc::optional<uint64_t> starting_block_position = fc::optional<uint64_t>()) const;
 
       /// return true to continue processing, false to stop iteration.
       typedef std::function<bool(const std::shared_ptr<full_block_type>&)> block_processor_t;
@@ -45,6 +45,7 @@ namespace hive { namespace chain {
       bool      enable_block_log_compression = true;
       int       block_log_compression_level = 15;
       bool      enable_block_log_auto_fixing = true;
+      bool      enable_block_log_mmap_reads = false;
       bool      load_snapshot = false;
       bool      replay = false;
       bool      force_replay = false;
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <hive/chain/block_read_interface.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/reflect/reflect.hpp>
+
+#include <list>
+#include <mutex>
+
+namespace hive { namespace chain {
+
+  class block_log_wrapper;
+
+  /**
+   * Read-only block log variant for archive storage. Instead of compressing each block separately (and relying on
+   * artifacts file for random access) blocks are grouped into chunks, each compressed as a single zstd frame, which
+   * gives much better ratio. Random access is provided by the chunk directory at the end of the file and by per-block
+   * index at the start of each chunk.
+   *
+   * +--------+---------+---------+-----+---------+-----------------+
+   * | header | chunk 1 | chunk 2 | ... | chunk N | chunk directory |
+   * +--------+---------+---------+-----+---------+-----------------+
+   *
+   * Decompressed chunk: number of blocks, then for each block its size and id, then serialized blocks one after another.
+   * Each directory entry holds checksum of compressed chunk, verified whenever chunk is read.
+   *
+   * Files are produced from regular block log (and converted back) with block_log_util.
+   */
+  class chunked_block_log final : public block_read_i
+  {
+  public:
+    static const std::string _chunked_extension; /// includes leading dot
+
+    struct file_header
+    {
+      uint64_t  magic = 0;
+      uint32_t  format_version = 0;
+      uint32_t  first_block_num = 0;
+      uint32_t  head_block_num = 0;
+      uint32_t  blocks_per_chunk = 0;
+      uint64_t  directory_offset = 0;
+    };
+
+    struct chunk_info
+    {
+      uint64_t  file_offset = 0;
+      uint32_t  compressed_size = 0;
+      uint32_t  uncompressed_size = 0;
+      uint32_t  first_block_num = 0;
+      uint32_t  block_count = 0;
+      uint64_t  checksum = 0;
+    };
+
+    /**
+     * @brief Writes blocks [first_block_num, last_block_num] of source block log into new chunked file.
+     * @param blocks_per_chunk bigger chunks compress better, but reading single block has to decompress whole chunk
+     */
+    static void create_from_block_log( const block_log_wrapper& source, const fc::path& output_file,
+      uint32_t first_block_num, uint32_t last_block_num, uint32_t blocks_per_chunk, int compression_level );
+    /// Appends all blocks from chunked file to (empty or ending right before first block of chunked file) block log.
+    static void write_to_block_log( const fc::path& chunked_file, block_log_wrapper& target,
+      blockchain_worker_thread_pool& thread_pool );
+
+    explicit chunked_block_log( const fc::path& file );
+    virtual ~chunked_block_log();
+
+    const file_header& get_header() const { return _header; }
+    const std::vector<chunk_info>& get_chunks() const { return _chunks; }
+    uint32_t tail_block_num() const { return _header.first_block_num; }
+    /// Reads and checks every chunk, throws on first corrupted one.
+    void verify() const;
+
+    // Methods implementing block_read_i interface (file contains irreversible blocks only):
+    virtual std::shared_ptr<full_block_type> head_block() const override;
+    virtual uint32_t head_block_num(
+      fc::microseconds wait_for_microseconds = fc::microseconds() ) const override;
+    virtual block_id_type head_block_id(
+      fc::microseconds wait_for_microseconds = fc::microseconds() ) const override;
+    virtual std::shared_ptr<full_block_type> read_block_by_num( uint32_t block_num ) const override;
+    virtual void process_blocks( uint32_t starting_block_number, uint32_t ending_block_number,
+                                 block_processor_t processor,
+                                 blockchain_worker_thread_pool& thread_pool ) const override;
+    virtual std::shared_ptr<full_block_type> fetch_block_by_id( const block_id_type& id ) const override;
+    virtual std::shared_ptr<full_block_type> get_block_by_number(
+      uint32_t block_num, fc::microseconds wait_for_microseconds = fc::microseconds() ) const override;
+    virtual std::vector<std::shared_ptr<full_block_type>> fetch_block_range( const uint32_t starting_block_num,
+      const uint32_t count, fc::microseconds wait_for_microseconds = fc::microseconds() ) const override;
+    virtual bool is_known_block( const block_id_type& id ) const override;
+    virtual std::deque<block_id_type>::const_iterator find_first_item_not_in_blockchain(
+      const std::deque<block_id_type>& item_hashes_received ) const override;
+    virtual block_id_type find_block_id_for_num( uint32_t block_num ) const override;
+    virtual std::vector<block_id_type> get_blockchain_synopsis(
+      const block_id_type& reference_point,
+      uint32_t number_of_blocks_after_reference_point ) const override;
+    virtual std::vector<block_id_type> get_block_ids(
+      const std::vector<block_id_type>& blockchain_synopsis,
+      uint32_t& remaining_item_count,
+      uint32_t limit) const override;
+
+  private:
+    struct decoded_chunk
+    {
+      uint32_t                    chunk_index = 0;
+      std::unique_ptr<char[]>     data;
+      size_t                      size = 0;
+      // per block: offset of its serialized data within `data`, its size and id
+      std::vector<uint32_t>       block_offsets;
+      std::vector<uint32_t>       block_sizes;
+      std::vector<block_id_type>  block_ids;
+
+      std::shared_ptr<full_block_type> create_block( uint32_t index_in_chunk ) const;
+    };
+    using decoded_chunk_ptr_t = std::shared_ptr<const decoded_chunk>;
+
+    uint32_t get_chunk_index( uint32_t block_num ) const;
+    decoded_chunk_ptr_t read_chunk( uint32_t chunk_index ) const;
+    decoded_chunk_ptr_t get_chunk( uint32_t chunk_index ) const;
+
+    fc::path                                _file;
+    int                                     _fd = -1;
+    file_header                             _header;
+    std::vector<chunk_info>                 _chunks;
+    std::shared_ptr<full_block_type>        _head_block;
+
+    // recently decoded chunks, so consecutive reads from the same chunk don't decompress it again
+    mutable std::mutex                      _cache_mutex;
+    mutable std::list<decoded_chunk_ptr_t>  _cache;
+  };
+
+} }
+
+FC_REFLECT( hive::chain::chunked_block_log::file_header,
+  (magic)(format_version)(first_block_num)(head_block_num)(blocks_per_chunk)(directory_offset) )
+FC_REFLECT( hive::chain::chunked_block_log::chunk_info,
+  (file_offset)(compressed_size)(uncompressed_size)(first_block_num)(block_count)(checksum) )
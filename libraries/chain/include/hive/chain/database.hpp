@@ -292,6 +292,11 @@ namespace chain {
       const account_object&  get_account(  const account_name_type& name )const;
       const account_object*  find_account( const account_name_type& name )const;
 
+      /// Gives part of account data not used by consensus (nullptr when it was never set - all its fields have default values)
+      const account_details_object* find_account_details( const account_object& account )const;
+      /// Modifies part of account data not used by consensus, creates it first if needed
+      void modify_account_details( const account_object& account, const std::function< void( account_details_object& ) >& modifier );
+
       const comment_object*  find_comment( comment_id_type comment_id )const;
 
       comment get_comment( const account_id_type& author, const shared_string& permlink )const;
@@ -400,12 +405,15 @@ namespace chain {
       using comment_reward_notification_handler_t = std::function < void(const comment_reward_notification&) >;
       using end_of_syncing_notification_handler_t = std::function < void(void) >;
       using wipe_notification_handler_t = std::function < void(void) >;
+      using debug_state_change_handler_t = std::function < void(void) >;
 
       void notify_prepare_snapshot_data_supplement(const prepare_snapshot_supplement_notification& n);
       void notify_load_snapshot_data_supplement(const load_snapshot_supplement_notification& n);
       void notify_comment_reward(const comment_reward_notification& note);
       void notify_end_of_syncing();
       void notify_wipe();
+      /// to be called after state was modified outside of regular transaction/block processing (debug_node edits)
+      void notify_debug_state_change();
       void notify_pre_reindex(const reindex_notification& note);
       void notify_post_reindex(const reindex_notification& note);
 
@@ -415,6 +423,28 @@ namespace chain {
 
       signal_connection_ptr add_pre_apply_operation_handler       ( const apply_operation_handler_t&           func, const abstract_plugin& plugin, int32_t group = -1 );
       signal_connection_ptr add_post_apply_operation_handler      ( const apply_operation_handler_t&           func, const abstract_plugin& plugin, int32_t group = -1 );
+      /**
+        * Handlers registered for selected operation types are called only for operations of those types. Plugins
+        * interested in few operations should use these instead of filtering all notifications themselves. One
+        * connection is returned per operation type.
+        * Note on ordering: typed handlers are always called after all handlers registered for all operations,
+        * no matter the group. Group only orders typed handlers among themselves (within the same operation type).
+        * Plugin that needs to run before some other plugin registered for all operations can't use typed handler.
+        */
+      template< typename... OperationTypes >
+      std::vector< signal_connection_ptr > add_pre_apply_operation_handler_for( const apply_operation_handler_t& func, const abstract_plugin& plugin, int32_t group = -1 )
+      {
+        std::vector< signal_connection_ptr > connections;
+        ( connections.emplace_back( add_typed_apply_operation_handler( true, operation::tag< OperationTypes >::value, func, plugin, group ) ), ... );
+        return connections;
+      }
+      template< typename... OperationTypes >
+      std::vector< signal_connection_ptr > add_post_apply_operation_handler_for( const apply_operation_handler_t& func, const abstract_plugin& plugin, int32_t group = -1 )
+      {
+        std::vector< signal_connection_ptr > connections;
+        ( connections.emplace_back( add_typed_apply_operation_handler( false, operation::tag< OperationTypes >::value, func, plugin, group ) ), ... );
+        return connections;
+      }
       signal_connection_ptr add_pre_apply_transaction_handler     ( const apply_transaction_handler_t&         func, const abstract_plugin& plugin, int32_t group = -1 );
       signal_connection_ptr add_post_apply_transaction_handler    ( const apply_transaction_handler_t&         func, const abstract_plugin& plugin, int32_t group = -1 );
       signal_connection_ptr add_pre_apply_block_handler           ( const apply_block_handler_t&               func, const abstract_plugin& plugin, int32_t group = -1 );
@@ -453,11 +483,18 @@ namespace chain {
       signal_connection_ptr add_end_of_syncing_handler            (const end_of_syncing_notification_handler_t& func, const abstract_plugin& plugin, int32_t group = -1);
 
       signal_connection_ptr add_wipe_handler                      (const wipe_notification_handler_t& func, const abstract_plugin& plugin, int32_t group = -1);
+      signal_connection_ptr add_debug_state_change_handler        (const debug_state_change_handler_t& func, const abstract_plugin& plugin, int32_t group = -1);
       signal_connection_ptr add_flush_handler                     ( const flush_handler_t& func, const abstract_plugin& plugin, int32_t group = -1 );
 
       /// Register a callback for plugin index initialization (called during initialize_indexes)
       signal_connection_ptr add_plugin_index_handler( const std::function<void()>& func );
 
+    private:
+      signal_connection_ptr add_typed_apply_operation_handler( bool is_pre_operation, int64_t operation_tag,
+        const apply_operation_handler_t& func, const abstract_plugin& plugin, int32_t group );
+
+    public:
+
       //////////////////// db_witness_schedule.cpp ////////////////////
 
       void flush_to_all_storages();
@@ -564,8 +601,9 @@ namespace chain {
       /** this is called by `adjust_proxied_witness_votes` when account proxy to self */
       void adjust_witness_votes( const account_object& a, const share_type& delta );
 
-      /** this updates the vote of a single witness as a result of a vote being added or removed*/
-      void adjust_witness_vote( const witness_object& obj, share_type delta );
+      /** this updates the vote of a single witness as a result of a vote being added or removed
+        * (check_total = false when new votes were already checked against total vesting shares, see witness_votes_batch) */
+      void adjust_witness_vote( const witness_object& obj, share_type delta, bool check_total = true );
 
       /** clears all vote records for a particular account but does not update the
         * witness vote totals.  Vote totals should be updated first via a call to
@@ -751,6 +789,24 @@ namespace chain {
 
       void process_delayed_voting(const block_notification& note );
 
+      /**
+        * Changes in votes collected during block-level processing of many accounts (power downs, maturing delayed votes).
+        * Within such phase current virtual time of witness schedule does not change and no one reads the votes, so
+        * collecting deltas per proxy (and proxy depth) and per witness and applying them once at the end gives the same
+        * state as applying each change immediately, just with single modification of each touched object.
+        */
+      struct witness_votes_batch
+      {
+        std::map< account_id_type, std::array< share_type, HIVE_MAX_PROXY_RECURSION_DEPTH > > proxied_votes;
+        std::map< witness_id_type, share_type > witness_votes;
+      };
+      std::optional< witness_votes_batch > _witness_votes_batch;
+
+      /// starts collecting changes in witness votes instead of applying them immediately
+      void begin_witness_votes_batch();
+      /// applies all changes collected since begin_witness_votes_batch() and stops collecting
+      void apply_witness_votes_batch();
+
       void process_recurrent_transfers();
 
       void update_global_dynamic_data( const signed_block& b );
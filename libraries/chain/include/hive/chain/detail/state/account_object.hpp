@@ -31,12 +31,12 @@ namespace hive { namespace chain {
       //constructor for creation of regular accounts
       template< typename Allocator >
       account_object( allocator< Allocator > a, uint64_t _id,
-        const account_name_type& _name, const public_key_type& _memo_key,
+        const account_name_type& _name,
         const time_point_sec& _creation_time, const time_point_sec& _block_creation_time, bool _mined,
         const account_object* _recovery_account,
         bool _fill_mana, const VEST_asset& incoming_delegation, int64_t _rc_adjustment = 0 )
       : id( _id ), name( _name ), rc_adjustment( _rc_adjustment ), created( _creation_time ), block_created( _block_creation_time ),
-        mined( _mined ), memo_key( _memo_key ), delayed_votes( a )
+        mined( _mined ), delayed_votes( a )
       {
         /*
           Explanation:
@@ -62,8 +62,8 @@ namespace hive { namespace chain {
       //minimal constructor used for creation of accounts at genesis and in tests
       template< typename Allocator >
       account_object( allocator< Allocator > a, uint64_t _id,
-        const account_name_type& _name, const time_point_sec& _creation_time, const public_key_type& _memo_key = public_key_type() )
-        : id( _id ), name( _name ), created( _creation_time ), block_created( _creation_time ), memo_key( _memo_key ), delayed_votes( a )
+        const account_name_type& _name, const time_point_sec& _creation_time )
+        : id( _id ), name( _name ), created( _creation_time ), block_created( _creation_time ), delayed_votes( a )
       {}
 
       //liquid HIVE balance
@@ -165,13 +165,6 @@ namespace hive { namespace chain {
         last_account_recovery = recovery_time;
       }
 
-      //time from a current block
-      time_point_sec get_block_last_account_recovery_time() const { return block_last_account_recovery; }
-      void set_block_last_account_recovery_time( time_point_sec block_recovery_time )
-      {
-        block_last_account_recovery = block_recovery_time;
-      }
-
       //members are organized in such a way that the object takes up as little space as possible (note that object starts with 4byte id).
 
     private:
@@ -179,7 +172,6 @@ namespace hive { namespace chain {
 
       account_id_type   recovery_account;
       time_point_sec    last_account_recovery;
-      time_point_sec    block_last_account_recovery; // REMOVE - not used by consensus checks (only API)
 
       account_name_type name;
 
@@ -206,9 +198,6 @@ namespace hive { namespace chain {
       VEST_asset        received_vesting_shares; ///< VESTS delegated to this account
       VEST_asset        vesting_withdraw_rate; ///< weekly power down rate
 
-      HIVE_asset        curation_rewards; ///< not used by consensus - sum of all curations (value before conversion to VESTS)
-      HIVE_asset        posting_rewards; ///< not used by consensus - sum of all author rewards (value before conversion to VESTS/HBD)
-
       VEST_asset        withdrawn; ///< VESTS already withdrawn in currently active power down (why do we even need this?)
       VEST_asset        to_withdraw; ///< VESTS yet to be withdrawn in currently active power down (withdown should just be subtracted from this)
 
@@ -229,7 +218,6 @@ namespace hive { namespace chain {
       time_point_sec    created; // REMOVE - not used by consensus checks (only unit tests)
       time_point_sec    block_created; // REMOVE - not used by consensus checks (only API and colony)
     public:
-      time_point_sec    last_account_update; // REMOVE - not used by consensus checks
       time_point_sec    last_post; //(we could probably remove limit on posting replies)
       time_point_sec    last_root_post; //influenced root comment reward between HF12 and HF17
       time_point_sec    last_post_edit; //(that limit could be coupled with last_post - no need for separate field; NOTE: requires HF)
@@ -254,8 +242,6 @@ namespace hive { namespace chain {
       bool              mined = true; // REMOVE - not used by consensus checks (only API)
 
     public:
-      public_key_type   memo_key; //33 bytes with alignment of 1; (it belongs to metadata as it is not used by consensus, but witnesses need it here since they don't use metadata plugin)
-
       fc::array<share_type, HIVE_MAX_PROXY_RECURSION_DEPTH> proxied_vsf_votes; ///< the total VFS votes proxied to this account
 
       using t_delayed_votes = t_vector< delayed_votes_data >;
@@ -336,6 +322,41 @@ namespace hive { namespace chain {
     CHAINBASE_UNPACK_CONSTRUCTOR(account_object, (delayed_votes));
   };
 
+  /**
+    * Part of account data that is not used by consensus checks, only by API. It is kept outside of account_object
+    * so the latter is smaller and cheaper to copy into undo state on every vote, transfer or payout. The object
+    * is created on first write to any of its fields - when it does not exist, all fields have default values.
+    * Use database::find_account_details/modify_account_details to access it.
+    */
+  class account_details_object : public object< account_details_object_type, account_details_object >
+  {
+    CHAINBASE_OBJECT( account_details_object );
+    public:
+      template< typename Allocator, typename Constructor >
+      account_details_object( allocator< Allocator > a, uint64_t _id, const account_object& _account, Constructor&& c )
+        : id( _id ), account( _account.get_id() )
+      {
+        c( *this );
+      }
+
+      //id of account the details belong to
+      account_id_type get_account() const { return account; }
+
+    private:
+      account_id_type   account;
+
+    public:
+      HIVE_asset        curation_rewards; ///< sum of all curations (value before conversion to VESTS)
+      HIVE_asset        posting_rewards; ///< sum of all author rewards (value before conversion to VESTS/HBD)
+
+      time_point_sec    last_account_update;
+      time_point_sec    block_last_account_recovery; ///< time of last owner authority recovery according to a block
+
+      public_key_type   memo_key;
+
+    CHAINBASE_UNPACK_CONSTRUCTOR(account_details_object);
+  };
+
   class account_authority_object : public object< account_authority_object_type, account_authority_object, std::true_type >
   {
     CHAINBASE_OBJECT( account_authority_object );
@@ -531,7 +552,7 @@ namespace hive { namespace chain {
 } }
 
 FC_REFLECT( hive::chain::account_object,
-          (id)(proxy)(recovery_account)(last_account_recovery)(block_last_account_recovery)
+          (id)(proxy)(recovery_account)(last_account_recovery)
           (name)
           (hbd_seconds)
           (savings_hbd_seconds)
@@ -544,21 +565,23 @@ FC_REFLECT( hive::chain::account_object,
           (savings_balance)(reward_vesting_balance)
           (vesting_shares)(delegated_vesting_shares)
           (received_vesting_shares)(vesting_withdraw_rate)
-          (curation_rewards)(posting_rewards)
           (withdrawn)(to_withdraw)
           (rc_adjustment)(delegated_rc)
           (received_rc)(last_max_rc)
           (pending_claimed_accounts)(sum_delayed_votes)
           (hbd_seconds_last_update)(hbd_last_interest_payment)(savings_hbd_seconds_last_update)(savings_hbd_last_interest_payment)
-          (created)(block_created)(last_account_update)(last_post)(last_root_post)
+          (created)(block_created)(last_post)(last_root_post)
           (last_post_edit)(last_vote_time)(next_vesting_withdrawal)(governance_vote_expiration_ts)
           (post_count)(post_bandwidth)(withdraw_routes)(pending_escrow_transfers)(open_recurrent_transfers)(witnesses_voted_for)
           (savings_withdraw_requests)(can_vote)(mined)
-          (memo_key)
           (proxied_vsf_votes)
           (delayed_votes)
         )
 
+FC_REFLECT( hive::chain::account_details_object,
+          (id)(account)(curation_rewards)(posting_rewards)(last_account_update)(block_last_account_recovery)(memo_key)
+        )
+
 FC_REFLECT( hive::chain::account_authority_object,
           (id)(account)(owner)(active)(posting)(previous_owner_update)(last_owner_update)
 )
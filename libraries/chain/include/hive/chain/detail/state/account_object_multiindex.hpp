@@ -47,6 +47,17 @@ namespace hive { namespace chain {
 
   struct by_account {};
 
+  typedef multi_index_container <
+    account_details_object,
+    indexed_by <
+      ordered_unique< tag< by_id >,
+        const_mem_fun< account_details_object, account_details_object::id_type, &account_details_object::get_id > >,
+      ordered_unique< tag< by_account >,
+        const_mem_fun< account_details_object, account_id_type, &account_details_object::get_account > >
+    >,
+    multi_index_allocator< account_details_object >
+  > account_details_index;
+
   typedef multi_index_container <
     owner_authority_history_object,
     indexed_by <
@@ -164,6 +175,7 @@ namespace hive { namespace chain {
 } }
 
 CHAINBASE_SET_INDEX_TYPE( hive::chain::account_object, hive::chain::account_index )
+CHAINBASE_SET_INDEX_TYPE( hive::chain::account_details_object, hive::chain::account_details_index )
 CHAINBASE_SET_INDEX_TYPE( hive::chain::account_authority_object, hive::chain::account_authority_index )
 CHAINBASE_SET_INDEX_TYPE( hive::chain::vesting_delegation_object, hive::chain::vesting_delegation_index )
 CHAINBASE_SET_INDEX_TYPE( hive::chain::vesting_delegation_expiration_object, hive::chain::vesting_delegation_expiration_index )
@@ -15,3 +15,4 @@ namespace hive { namespace chain {
 } } // hive::chain
 
 CHAINBASE_SET_INDEX_TYPE( hive::chain::dynamic_global_property_object, hive::chain::dynamic_global_property_index )
+CHAINBASE_SET_DIFF_UNDO( hive::chain::dynamic_global_property_object )
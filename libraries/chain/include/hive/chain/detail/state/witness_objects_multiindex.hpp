@@ -85,3 +85,4 @@ namespace hive { namespace chain {
 CHAINBASE_SET_INDEX_TYPE( hive::chain::witness_object, hive::chain::witness_index )
 CHAINBASE_SET_INDEX_TYPE( hive::chain::witness_vote_object, hive::chain::witness_vote_index )
 CHAINBASE_SET_INDEX_TYPE( hive::chain::witness_schedule_object, hive::chain::witness_schedule_index )
+CHAINBASE_SET_DIFF_UNDO( hive::chain::witness_schedule_object )
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace appbase
 {
 class abstract_plugin;
@@ -30,6 +32,17 @@ class state_snapshot_provider
     virtual void process_explicit_snapshot_dump_requests(const hive::chain::open_args& openArgs) = 0;
     virtual void process_explicit_snapshot_load_requests(const hive::chain::open_args& openArgs) = 0;
 
+    /** Replay checkpoints - snapshots taken periodically during replay, so interrupted (or crashed) replay can be
+        resumed from the last one instead of starting from scratch.
+    */
+    virtual void dump_replay_checkpoint() = 0;
+    /** Loads newest checkpoint that is ahead of current state, falling back to older ones when it fails to load.
+        Returns head block number of loaded checkpoint or 0 if none was loaded (state is cleared in such case when
+        failed load already touched it).
+    */
+    virtual uint32_t load_latest_replay_checkpoint(const hive::chain::open_args& openArgs) = 0;
+    virtual void remove_replay_checkpoints() = 0;
+
   protected:
     virtual ~state_snapshot_provider() = default;
 };
@@ -10,6 +10,8 @@
 
 #include <chainbase/chainbase.hpp>
 
+#include <deque>
+
 namespace hive { namespace chain {
 
   using hive::protocol::account_name_type;
@@ -203,12 +205,21 @@ namespace hive { namespace chain {
       /** @return a pointer to the newly pushed item */
       void _push_block(const item_ptr& b );
       void _push_next(const item_ptr& newly_inserted);
+      /// changes head and updates _main_branch, walking back from new head only until common ancestor with old one
+      void _set_head(const item_ptr& new_head);
+      bool _is_on_main_branch(const item_ptr& item)const;
 
       uint32_t                 _max_size = 1024;
 
       fork_multi_index_type    _unlinked_index;
       fork_multi_index_type    _index;
       item_ptr                 _head;
+      /**
+        * Items of the branch ending with _head, indexed by block number - _main_branch_start, so lookups on main
+        * branch by number don't need to walk back from head.
+        */
+      std::deque<item_ptr>     _main_branch;
+      uint32_t                 _main_branch_start = 0;
   };
 
 } } // hive::chain
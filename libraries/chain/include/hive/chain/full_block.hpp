@@ -26,7 +26,11 @@ struct compressed_block_data
 {
   block_attributes_t compression_attributes;
   std::unique_ptr<char[]> compressed_bytes;
+  // alternatively bytes can live in memory mapped block log (the pointer keeps the mapping alive)
+  std::shared_ptr<const char> mapped_compressed_bytes;
   size_t compressed_size;
+
+  const char* data() const { return compressed_bytes ? compressed_bytes.get() : mapped_compressed_bytes.get(); }
 };
 
 // stores a serialized block
@@ -120,6 +124,11 @@ class full_block_type
                                                                               size_t compressed_size,
                                                                               const block_attributes_t& compression_attributes,
                                                                               const std::optional<block_id_type> block_id = std::optional<block_id_type>());
+    /// like above, but without copying - compressed bytes stay where they are (in memory mapped block log)
+    static std::shared_ptr<full_block_type> create_from_mapped_compressed_block_data(std::shared_ptr<const char> compressed_bytes,
+                                                                                     size_t compressed_size,
+                                                                                     const block_attributes_t& compression_attributes,
+                                                                                     const std::optional<block_id_type> block_id = std::optional<block_id_type>());
     static std::shared_ptr<full_block_type> create_from_uncompressed_block_data(std::unique_ptr<char[]>&& raw_bytes, size_t raw_size,
                                                                                 const std::optional<block_id_type> block_id = std::optional<block_id_type>());
     static std::shared_ptr<full_block_type> create_from_signed_block(const signed_block& block);
@@ -109,6 +109,9 @@ struct full_transaction_type
     static full_transaction_ptr build_transaction_object(const signed_transaction& transaction, hive::protocol::pack_type serialization_type);
     static serialized_transaction_data fill_serialization_buffer(const signed_transaction& transaction, hive::protocol::pack_type serialization_type,
       uncompressed_memory_buffer* serialization_buffer);
+    /// Reserializes only signatures, reusing already serialized transaction part held by the buffer.
+    static serialized_transaction_data replace_serialized_signatures(const signed_transaction& transaction,
+      const serialized_transaction_data& serialized_transaction, uncompressed_memory_buffer* serialization_buffer);
 
   public:
     full_transaction_type();
@@ -153,8 +156,10 @@ struct full_transaction_type
       return runtime_expiration;
     }
 
-    static full_transaction_ptr create_from_block(const std::shared_ptr<decoded_block_storage_type>& block_storage, uint32_t index_in_block,
-                                                  const serialized_transaction_data& serialized_transaction, bool use_transaction_cache);
+    /// Creates objects for all transactions of decoded block (in one allocation - they are all released only when none is referenced).
+    static std::vector<full_transaction_ptr> create_from_block(const std::shared_ptr<decoded_block_storage_type>& block_storage,
+                                                               const std::vector<serialized_transaction_data>& serialized_transactions,
+                                                               bool use_transaction_cache);
     /// Allows to build a full_transaction object basing on not yet signed transaction 
     static full_transaction_ptr create_from_transaction(const hive::protocol::transaction& transaction, hive::protocol::pack_type serialization_type);
     /// Allows to build a full_transaction object from ALREADY signed transaction (pointed transaction object must contain at least one signature).
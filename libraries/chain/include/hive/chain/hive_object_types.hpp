@@ -86,6 +86,8 @@ enum object_type
   rc_usage_bucket_object_type,
   rc_stats_object_type,
   rc_expired_delegation_object_type,
+
+  account_details_object_type,
 };
 
 class dynamic_global_property_object;
@@ -128,6 +130,8 @@ class rc_usage_bucket_object;
 class rc_stats_object;
 class rc_expired_delegation_object;
 
+class account_details_object;
+
 typedef oid_ref< dynamic_global_property_object         > dynamic_global_property_id_type;
 typedef oid_ref< account_object                         > account_id_type;
 typedef oid_ref< account_authority_object               > account_authority_id_type;
@@ -169,6 +173,8 @@ typedef oid_ref< rc_usage_bucket_object                 > rc_cost_bucket_id_type
 typedef oid_ref< rc_stats_object                        > rc_stats_id_type;
 typedef oid_ref< rc_expired_delegation_object           > rc_expired_delegtion_id_type;
 
+typedef oid_ref< account_details_object                 > account_details_id_type;
+
 } } //hive::chain
 
 namespace fc
@@ -311,6 +317,8 @@ FC_REFLECT_ENUM( hive::chain::object_type,
             (rc_usage_bucket_object_type)
             (rc_stats_object_type)
             (rc_expired_delegation_object_type)
+
+            (account_details_object_type)
           )
 
 FC_REFLECT_TYPENAME( hive::chain::shared_string )
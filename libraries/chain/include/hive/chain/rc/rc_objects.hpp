@@ -58,18 +58,11 @@ class rc_pool_object : public object< rc_pool_object_type, rc_pool_object >
       recalculate_resource_weights( params );
     }
 
-    //sets resource amount in selected pool
-    void set_pool( int poolIdx, int64_t value )
+    //sets new content of all resource pools and per-block budgets at once
+    void set_pools( const resource_count_type& values, const resource_count_type& budgets )
     {
-      pool_array[ poolIdx ] = value;
-    }
-
-    //sets new value of per-block budget - returns if there was any change in value
-    bool set_budget( int poolIdx, int64_t value )
-    {
-      bool result = ( last_known_budget[ poolIdx ] != value );
-      last_known_budget[ poolIdx ] = value;
-      return result;
+      pool_array = values;
+      last_known_budget = budgets;
     }
 
     //accumulates usage statistics for given resource
@@ -77,6 +70,12 @@ class rc_pool_object : public object< rc_pool_object_type, rc_pool_object >
     {
       usage_in_window[ poolIdx ] += resource_consumed;
     }
+    //accumulates usage statistics for all resources at once
+    void add_usage( const resource_count_type& resources_consumed )
+    {
+      for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
+        usage_in_window[i] += resources_consumed[i];
+    }
     //should be called once per block after usage statistics are accumulated
     void recalculate_resource_weights( const rc_resource_param_object& params )
     {
@@ -240,6 +239,12 @@ class rc_usage_bucket_object : public object< rc_usage_bucket_object_type, rc_us
     {
       usage[ poolIdx ] += resource_consumed;
     }
+    //adds usage data on all resources at once
+    void add_usage( const resource_count_type& resources_consumed )
+    {
+      for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
+        usage[i] += resources_consumed[i];
+    }
 
     //timestamp of first block that this bucket refers to
     time_point_sec get_timestamp() const { return timestamp; }
@@ -337,6 +342,7 @@ FC_REFLECT( hive::chain::rc_pool_object,
   (sum_of_resource_weights)
 )
 CHAINBASE_SET_INDEX_TYPE( hive::chain::rc_pool_object, hive::chain::rc_pool_index )
+CHAINBASE_SET_DIFF_UNDO( hive::chain::rc_pool_object )
 
 FC_REFLECT( hive::chain::rc_stats_object,
   (id)
@@ -96,6 +96,16 @@ class resource_credits
       int64_t resource_count,
       int64_t rc_regen );
 
+    /** calculates cost of all resources at once given current state of pools and regen rate;
+      * applies resource units to usage (in place), fills detailed cost and returns total
+      */
+    static int64_t compute_cost(
+      const rc_resource_param_object& params_obj,
+      const rc_pool_object& pool_obj,
+      int64_t rc_regen,
+      resource_count_type& usage,
+      resource_cost_type& cost );
+
     // calculates cost of given resource consumption, applies resource units and adds detailed cost to buffer
     int64_t compute_cost( rc_transaction_info* usage_info ) const;
 
@@ -12,7 +12,7 @@ block_data_type& block_data_type::operator=( const full_block_type& new_block )
 {
   const compressed_block_data& new_cbd = new_block.get_compressed_block();
   size_t new_byte_size = new_cbd.compressed_size;
-  const char* new_bytes = new_cbd.compressed_bytes.get();
+  const char* new_bytes = new_cbd.data();
 
   _compression_attributes = new_cbd.compression_attributes;
   _byte_size = new_byte_size;
@@ -18,6 +18,18 @@ namespace hive { namespace chain {
 
 using fc::uint128_t;
 
+namespace {
+
+// 128-bit division is a slow library call, but in RC calculations operands almost always fit in 64 bits
+inline uint128_t divide( const uint128_t& num, const uint128_t& denom )
+{
+  if( ( ( num | denom ) >> 64 ) == 0 )
+    return uint64_t( num ) / uint64_t( denom );
+  return num / denom;
+}
+
+}
+
 resource_credits::report_type resource_credits::auto_report_type = resource_credits::report_type::REGULAR;
 resource_credits::report_output resource_credits::auto_report_output = resource_credits::report_output::ILOG;
 
@@ -276,45 +288,60 @@ int64_t resource_credits::compute_cost(
   // Negative pool doesn't increase price beyond p_max
   //   i.e. define p(x) = p(0) for all x < 0
   denom += (current_pool > 0) ? uint64_t(current_pool) : uint64_t(0);
-  uint128_t num_denom = num / denom;
+  uint128_t num_denom = divide( num, denom );
   // Add 1 to avoid 0 result in case of various rounding issues,
   // err on the side of rounding not in the user's favor
   // ilog( "result: ${r}", ("r", num_denom.to_uint64()+1) );
   return fc::uint128_to_uint64(num_denom)+1;
 }
 
-int64_t resource_credits::compute_cost( rc_transaction_info* usage_info ) const
+int64_t resource_credits::compute_cost(
+  const rc_resource_param_object& params_obj,
+  const rc_pool_object& pool_obj,
+  int64_t rc_regen,
+  resource_count_type& usage,
+  resource_cost_type& cost
+  )
 {
-  const dynamic_global_property_object& dgpo = db.get_dynamic_global_properties();
-  const rc_resource_param_object& params_obj = db.get< rc_resource_param_object, by_id >( rc_resource_param_id_type() );
-  const rc_pool_object& pool_obj = db.get< rc_pool_object, by_id >( rc_pool_id_type() );
+  // When rc_regen is 0, everything is free
+  if( rc_regen <= 0 )
+    return 0;
 
-  int64_t total_vests = dgpo.get_total_vesting_shares().amount.value;
-  int64_t rc_regen = ( total_vests / ( HIVE_RC_REGEN_TIME / HIVE_BLOCK_INTERVAL ) );
+  // each step is done for all resources before next one starts (independent lanes instead of
+  // one long dependency chain per resource)
+  for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
+    usage[i] *= int64_t( params_obj.resource_param_array[i].resource_dynamics_params.resource_unit );
 
-  int64_t total_cost = 0;
+  resource_count_type pool_regen_share;
+  const uint128_t weight_divisor = pool_obj.get_weight_divisor();
+  for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
+    pool_regen_share[i] = fc::uint128_to_int64( divide( uint128_t( rc_regen ) * pool_obj.get_weight(i), weight_divisor ) );
 
-  // When rc_regen is 0, everything is free
-  if( rc_regen > 0 )
+  int64_t total_cost = 0;
+  for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
   {
-    for( size_t i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
+    if( pool_regen_share[i] > 0 )
     {
-      const rc_resource_params& params = params_obj.resource_param_array[i];
-      int64_t pool = pool_obj.get_pool(i);
-
-      usage_info->usage[i] *= int64_t( params.resource_dynamics_params.resource_unit );
-      int64_t pool_regen_share = fc::uint128_to_int64( ( uint128_t( rc_regen ) * pool_obj.get_weight(i) ) / pool_obj.get_weight_divisor() );
-      if( pool_regen_share > 0 )
-      {
-        usage_info->cost[i] = compute_cost( params.price_curve_params, pool, usage_info->usage[i], pool_regen_share );
-        total_cost += usage_info->cost[i];
-      }
+      cost[i] = compute_cost( params_obj.resource_param_array[i].price_curve_params, pool_obj.get_pool(i),
+        usage[i], pool_regen_share[i] );
+      total_cost += cost[i];
     }
   }
-
   return total_cost;
 }
 
+int64_t resource_credits::compute_cost( rc_transaction_info* usage_info ) const
+{
+  const dynamic_global_property_object& dgpo = db.get_dynamic_global_properties();
+  const rc_resource_param_object& params_obj = db.get< rc_resource_param_object, by_id >( rc_resource_param_id_type() );
+  const rc_pool_object& pool_obj = db.get< rc_pool_object, by_id >( rc_pool_id_type() );
+
+  int64_t total_vests = dgpo.get_total_vesting_shares().amount.value;
+  int64_t rc_regen = ( total_vests / ( HIVE_RC_REGEN_TIME / HIVE_BLOCK_INTERVAL ) );
+
+  return compute_cost( params_obj, pool_obj, rc_regen, usage_info->usage, usage_info->cost );
+}
+
 void resource_credits::regenerate_rc_mana( const account_object& account, const fc::time_point_sec now ) const
 {
   // Since RC tracking is non-consensus, we must rely on consensus to forbid
@@ -750,38 +777,48 @@ void resource_credits::finalize_block() const
     active_bucket = &( *bucket_idx.begin() );
 
   const auto& rc_pool = db.get< rc_pool_object, by_id >( rc_pool_id_type() );
-  db.modify( rc_pool, [&]( rc_pool_object& pool_obj )
-  {
-    for( size_t i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
-    {
-      const rd_dynamics_params& params = params_obj.resource_param_array[i].resource_dynamics_params;
-      int64_t pool = pool_obj.get_pool(i);
+  const resource_count_type& usage = block_info.usage;
 
-      pool_obj.set_budget( i, params.budget_per_time_unit );
-      int64_t decay = rd_compute_pool_decay( params.decay_params, pool - block_info.usage[i], 1 );
-
-      // update global usage statistics
-      if( reset_bucket )
-        pool_obj.add_usage( i, -active_bucket->get_usage(i) );
-      pool_obj.add_usage( i, block_info.usage[i] );
+  // all resources are computed together on plain arrays first, so the pool object is touched just once
+  resource_count_type budget;
+  resource_count_type decay;
+  for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
+  {
+    const rd_dynamics_params& params = params_obj.resource_param_array[i].resource_dynamics_params;
+    budget[i] = params.budget_per_time_unit;
+    decay[i] = rd_compute_pool_decay( params.decay_params, rc_pool.get_pool(i) - usage[i], 1 );
+  }
 
-      int64_t new_pool = pool - decay + params.budget_per_time_unit - block_info.usage[i];
+  resource_count_type new_pool;
+  resource_count_type window_delta; // change in global usage statistics
+  for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
+  {
+    new_pool[i] = rc_pool.get_pool(i) - decay[i] + budget[i] - usage[i];
+    window_delta[i] = usage[i];
+  }
+  if( reset_bucket )
+  {
+    for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
+      window_delta[i] -= active_bucket->get_usage(i);
+  }
 
-      if( i == resource_new_accounts )
-      {
-        int64_t new_consensus_pool = dgpo.available_account_subsidies;
-        if( new_consensus_pool != new_pool )
-        {
-          ilog( "resource_new_accounts adjustment on block ${b}: ${a}",
-            ( "a", new_consensus_pool - new_pool )( "b", block_num ) );
-          new_pool = new_consensus_pool;
-        }
-      }
-      if( new_pool < 0 )
-        new_pool = 0;
+  int64_t new_consensus_pool = dgpo.available_account_subsidies;
+  if( new_consensus_pool != new_pool[ resource_new_accounts ] )
+  {
+    ilog( "resource_new_accounts adjustment on block ${b}: ${a}",
+      ( "a", new_consensus_pool - new_pool[ resource_new_accounts ] )( "b", block_num ) );
+    new_pool[ resource_new_accounts ] = new_consensus_pool;
+  }
+  for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
+  {
+    if( new_pool[i] < 0 )
+      new_pool[i] = 0;
+  }
 
-      pool_obj.set_pool( i, new_pool );
-    }
+  db.modify( rc_pool, [&]( rc_pool_object& pool_obj )
+  {
+    pool_obj.set_pools( new_pool, budget );
+    pool_obj.add_usage( window_delta );
     pool_obj.recalculate_resource_weights( params_obj );
   } );
 
@@ -791,8 +828,7 @@ void resource_credits::finalize_block() const
   {
     if( reset_bucket )
       bucket.reset( now ); //contents of bucket being reset was already subtracted from globals above
-    for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
-      bucket.add_usage( i, block_info.usage[i] );
+    bucket.add_usage( usage );
   } );
 }
 
@@ -64,47 +64,50 @@ void update_median_witness_props(database& db, const witness_schedule_object& ws
     active.push_back( &db.get_witness( wso.current_shuffled_witnesses[i] ) );
   }
 
-  /// sort them by account_creation_fee
-  std::sort( active.begin(), active.end(), [&]( const witness_object* a, const witness_object* b )
+  /// only median is needed, so instead of sorting whole set each time just median element is put in place
+  auto median = active.begin() + active.size()/2;
+
+  /// median by account_creation_fee
+  std::nth_element( active.begin(), median, active.end(), [&]( const witness_object* a, const witness_object* b )
   {
     return a->props.account_creation_fee.amount < b->props.account_creation_fee.amount;
   } );
-  HIVE_asset median_account_creation_fee = active[active.size()/2]->props.account_creation_fee;
+  HIVE_asset median_account_creation_fee = (*median)->props.account_creation_fee;
 
-  /// sort them by maximum_block_size
-  std::sort( active.begin(), active.end(), [&]( const witness_object* a, const witness_object* b )
+  /// median by maximum_block_size
+  std::nth_element( active.begin(), median, active.end(), [&]( const witness_object* a, const witness_object* b )
   {
     return a->props.maximum_block_size < b->props.maximum_block_size;
   } );
-  uint32_t median_maximum_block_size = active[active.size()/2]->props.maximum_block_size;
+  uint32_t median_maximum_block_size = (*median)->props.maximum_block_size;
 
-  /// sort them by hbd_interest_rate
-  std::sort( active.begin(), active.end(), [&]( const witness_object* a, const witness_object* b )
+  /// median by hbd_interest_rate
+  std::nth_element( active.begin(), median, active.end(), [&]( const witness_object* a, const witness_object* b )
   {
     return a->props.hbd_interest_rate < b->props.hbd_interest_rate;
   } );
-  uint16_t median_hbd_interest_rate = active[active.size()/2]->props.hbd_interest_rate;
+  uint16_t median_hbd_interest_rate = (*median)->props.hbd_interest_rate;
 
-  /// sort them by account_subsidy_budget
-  std::sort( active.begin(), active.end(), [&]( const witness_object* a, const witness_object* b )
+  /// median by account_subsidy_budget
+  std::nth_element( active.begin(), median, active.end(), [&]( const witness_object* a, const witness_object* b )
   {
     return a->props.account_subsidy_budget < b->props.account_subsidy_budget;
   } );
-  int32_t median_account_subsidy_budget = active[active.size()/2]->props.account_subsidy_budget;
+  int32_t median_account_subsidy_budget = (*median)->props.account_subsidy_budget;
 
-  /// sort them by account_subsidy_decay
-  std::sort( active.begin(), active.end(), [&]( const witness_object* a, const witness_object* b )
+  /// median by account_subsidy_decay
+  std::nth_element( active.begin(), median, active.end(), [&]( const witness_object* a, const witness_object* b )
   {
     return a->props.account_subsidy_decay < b->props.account_subsidy_decay;
   });
-  uint32_t median_account_subsidy_decay = active[active.size()/2]->props.account_subsidy_decay;
+  uint32_t median_account_subsidy_decay = (*median)->props.account_subsidy_decay;
 
-  // sort them by pool level
-  std::sort( active.begin(), active.end(), [&]( const witness_object* a, const witness_object* b )
+  // median by pool level
+  std::nth_element( active.begin(), median, active.end(), [&]( const witness_object* a, const witness_object* b )
   {
     return a->available_witness_account_subsidies < b->available_witness_account_subsidies;
   });
-  int64_t median_available_witness_account_subsidies = active[active.size()/2]->available_witness_account_subsidies;
+  int64_t median_available_witness_account_subsidies = (*median)->available_witness_account_subsidies;
 
   rd_system_params account_subsidy_system_params;
   account_subsidy_system_params.resource_unit = HIVE_ACCOUNT_SUBSIDY_PRECISION;
@@ -158,16 +161,24 @@ void update_witness_schedule4(database& db, const witness_schedule_object& wso)
   flat_set< witness_id_type > selected_voted;
   selected_voted.reserve( wso.max_voted_witnesses );
 
+  // witnesses mostly keep their role between rounds - modification (with its undo record) is only needed on change
+  auto set_schedule = [&]( const witness_object& witness, witness_object::witness_schedule_type schedule )
+  {
+    if( witness.schedule != schedule )
+      db.modify( witness, [&]( witness_object& wo ) { wo.schedule = schedule; } );
+  };
+  const bool skip_disabled = db.has_hardfork( HIVE_HARDFORK_0_14__278 );
+
   const auto& widx = db.get_index<witness_index>().indices().get<by_vote_name>();
   for( auto itr = widx.begin();
     itr != widx.end() && selected_voted.size() < wso.max_voted_witnesses;
     ++itr )
   {
-    if( db.has_hardfork( HIVE_HARDFORK_0_14__278 ) && (itr->is_disabled()) )
+    if( skip_disabled && (itr->is_disabled()) )
       continue;
     selected_voted.insert( itr->get_id() );
     active_witnesses.push_back( itr->owner) ;
-    db.modify( *itr, [&]( witness_object& wo ) { wo.schedule = witness_object::elected; } );
+    set_schedule( *itr, witness_object::elected );
   }
 
   auto num_elected = active_witnesses.size();
@@ -184,11 +195,11 @@ void update_witness_schedule4(database& db, const witness_schedule_object& wso)
     if( selected_voted.find( mitr->get_id() ) == selected_voted.end() )
     {
       // Only consider a miner who has a valid block signing key
-      if( !( db.has_hardfork( HIVE_HARDFORK_0_14__278 ) && db.get_witness( mitr->owner ).is_disabled() ) )
+      if( !( skip_disabled && mitr->is_disabled() ) )
       {
         selected_miners.insert( mitr->get_id() );
         active_witnesses.push_back(mitr->owner);
-        db.modify( *mitr, [&]( witness_object& wo ) { wo.schedule = witness_object::miner; } );
+        set_schedule( *mitr, witness_object::miner );
       }
     }
     // Remove processed miner from the queue
@@ -218,14 +229,14 @@ void update_witness_schedule4(database& db, const witness_schedule_object& wso)
     new_virtual_time = sitr->virtual_scheduled_time; /// everyone advances to at least this time
     processed_witnesses.push_back(sitr);
 
-    if( db.has_hardfork( HIVE_HARDFORK_0_14__278 ) && sitr->is_disabled() )
+    if( skip_disabled && sitr->is_disabled() )
       continue; /// skip witnesses without a valid block signing key
 
     if( selected_miners.find( sitr->get_id() ) == selected_miners.end()
       && selected_voted.find( sitr->get_id() ) == selected_voted.end() )
     {
       active_witnesses.push_back(sitr->owner);
-      db.modify( *sitr, [&]( witness_object& wo ) { wo.schedule = witness_object::timeshare; } );
+      set_schedule( *sitr, witness_object::timeshare );
       ++witness_count;
     }
   }
@@ -459,10 +470,13 @@ void update_witness_schedule(database& db)
         active_witnesses.push_back(itr->owner);
 
         /// don't consider the top 19 for the purpose of virtual time scheduling
-        db.modify( *itr, [&]( witness_object& wo )
+        if( itr->virtual_scheduled_time != fc::uint128_max_value() )
         {
-          wo.virtual_scheduled_time = fc::uint128_max_value();
-        } );
+          db.modify( *itr, [&]( witness_object& wo )
+          {
+            wo.virtual_scheduled_time = fc::uint128_max_value();
+          } );
+        }
       }
 
       /// add the virtual scheduled witness, reseeting their position to 0 and their time to completion
@@ -25,10 +25,13 @@
 
 #include <fc/exception/exception.hpp>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <new>
 #include <stdexcept>
 #include <typeindex>
 #include <typeinfo>
@@ -204,6 +207,18 @@ namespace chainbase {
   #define CHAINBASE_SET_INDEX_TYPE( OBJECT_TYPE, INDEX_TYPE )  \
   namespace chainbase { template<> struct get_index_type<OBJECT_TYPE> { typedef INDEX_TYPE type; }; }
 
+  /**
+    * Undo session normally keeps full copy of every object modified in it. Objects marked with CHAINBASE_SET_DIFF_UNDO
+    * (use next to CHAINBASE_SET_INDEX_TYPE) only keep old content of those fixed size segments of the object that
+    * actually changed (when most of the object changes, full copy is kept anyway). Use it for big objects that are
+    * modified often, but only in few fields at a time. Objects with dynamic allocations can't be marked.
+    **/
+  template<typename T>
+  struct use_diff_undo_records : std::false_type {};
+
+  #define CHAINBASE_SET_DIFF_UNDO( OBJECT_TYPE )  \
+  namespace chainbase { template<> struct use_diff_undo_records<OBJECT_TYPE> : std::true_type {}; }
+
   #define CHAINBASE_OBJECT_1( object_class ) CHAINBASE_OBJECT_false( object_class )
   #define CHAINBASE_OBJECT_2( object_class, allow_default ) CHAINBASE_OBJECT_##allow_default( object_class )
   #define CHAINBASE_OBJECT_true( object_class ) CHAINBASE_OBJECT_COMMON( object_class ); public: object_class() : id(0) {} private:
@@ -340,23 +355,36 @@ namespace chainbase {
       typedef typename value_type::id_type                          id_type;
       typedef allocator< generic_index >                            allocator_type;
 
+      static constexpr bool     use_diff_undo = use_diff_undo_records< value_type >::value;
+      static_assert( !use_diff_undo || !value_type::has_dynamic_alloc_t::value,
+        "Objects with dynamic allocations have to use full copies in undo records" );
+      static constexpr uint32_t diff_segment_size = 16;
+      static constexpr uint32_t diff_segment_count = ( sizeof( value_type ) + diff_segment_size - 1 ) / diff_segment_size;
+
+      typedef std::pair< id_type, uint32_t >                        diff_key_type; ///< object id and index of segment
+      typedef std::array< char, diff_segment_size >                 diff_segment_type;
+
       struct undo_state
       {
         typedef undo_allocator_carrier< std::pair<const id_type, value_type> > id_value_allocator_type;
-        typedef undo_allocator_carrier< id_type >                              id_allocator_type;
+        typedef undo_allocator_carrier< std::pair<const diff_key_type, diff_segment_type> > id_diff_allocator_type;
 
         undo_state( generic_index& index )
         : old_values( id_value_allocator_type( index._shared_undo_object_allocator ) ),
           removed_values( id_value_allocator_type( index._shared_undo_object_allocator ) ),
-          new_ids( id_allocator_type( index._shared_undo_id_allocator ) )
+          old_segments( id_diff_allocator_type( index._shared_undo_diff_allocator ) )
         {}
 
         typedef t_map< id_type, value_type, std::less<id_type>, id_value_allocator_type > id_value_type_map;
-        typedef t_set< id_type, std::less<id_type>, id_allocator_type >                   id_type_set;
+        typedef t_map< diff_key_type, diff_segment_type, std::less<diff_key_type>, id_diff_allocator_type > id_diff_map;
 
         id_value_type_map            old_values;
         id_value_type_map            removed_values;
-        id_type_set                  new_ids;
+        // only for objects with diff undo records - content of changed segments from before modification; object
+        // has either its segments here or full copy in old_values, never both
+        id_diff_map                  old_segments;
+        // ids are assigned in increasing order, so objects created in the session are exactly those with id
+        // not lower than old_next_id - they don't need separate undo records
         id_type                      old_next_id = id_type( 0 );
         int64_t                      revision = 0;
       };
@@ -365,7 +393,7 @@ namespace chainbase {
       generic_index( const Allocator& a, bfs::path p )
       : _stack( get_allocator_helper_t<value_type>::get_generic_allocator(a) ),
         _shared_undo_object_allocator( a ),
-        _shared_undo_id_allocator( a ),
+        _shared_undo_diff_allocator( a ),
         _indices( a, p ),
         _size_of_value_type( sizeof(value_type) ),
         _size_of_this(sizeof(*this)) {}
@@ -374,7 +402,7 @@ namespace chainbase {
       generic_index( const Allocator& a )
       : _stack( get_allocator_helper_t<value_type>::get_generic_allocator(a) ),
         _shared_undo_object_allocator( a ),
-        _shared_undo_id_allocator( a ),
+        _shared_undo_diff_allocator( a ),
         _indices( a ),
         _size_of_value_type( sizeof(value_type) ),
         _size_of_this(sizeof(*this)) {}
@@ -441,7 +469,17 @@ namespace chainbase {
 
       template<typename Modifier>
       void modify( const value_type& obj, Modifier&& m ) {
-        on_modify( obj );
+        // content of object from before modification, used when undo record is to be in form of changed segments
+        alignas( value_type ) char old_content[ use_diff_undo ? sizeof( value_type ) : 1 ];
+        bool record_segments = false;
+        if constexpr( use_diff_undo )
+        {
+          record_segments = needs_segment_record( obj );
+          if( record_segments )
+            std::memcpy( old_content, &obj, sizeof( value_type ) );
+        }
+        if( !record_segments )
+          on_modify( obj );
 
         fc::exception_ptr fc_exception_ptr;
         std::exception_ptr std_exception_ptr;
@@ -470,6 +508,17 @@ namespace chainbase {
         if constexpr( value_type::has_dynamic_alloc_t::value )
           new_size = obj.get_dynamic_alloc();
 
+        if constexpr( use_diff_undo )
+        {
+          if( record_segments )
+          {
+            if( ok )
+              on_modify_segments( obj, old_content );
+            else
+              on_remove( as_object( old_content ) ); // failed modification erased the object from index
+          }
+        }
+
         if(fc_exception_ptr)
           fc_exception_ptr->dynamic_rethrow_exception();
         else if(std_exception_ptr)
@@ -610,6 +659,28 @@ namespace chainbase {
 
         auto& head = _stack.back();
 
+        if constexpr( use_diff_undo )
+        {
+          for( auto item = head.old_segments.begin(); item != head.old_segments.end(); )
+          {
+            const id_type id = item->first.first;
+            const auto segments_end = head.old_segments.lower_bound( diff_key_type( id, diff_segment_count ) );
+            auto itr = _indices.find( id );
+            // when object is removed its segments are turned into full copy, so object has to be present
+            bool ok = itr != _indices.end() && _indices.modify( itr, [&]( value_type& v )
+            {
+              for( ; item != segments_end; ++item )
+                restore_segment( reinterpret_cast< char* >( &v ), item->first.second, item->second );
+            } );
+            if( !ok )
+            {
+              CHAINBASE_THROW_EXCEPTION(std::logic_error(
+                "Could not restore object from segments, most likely a uniqueness constraint was violated inside index holding types: "
+                  + get_type_name()));
+            }
+          }
+        }
+
         for( auto& item : head.old_values )
         {
           bool ok = false;
@@ -645,20 +716,12 @@ namespace chainbase {
             _item_additional_allocation += new_size - old_size;
         }
 
-        for( const auto& id : head.new_ids )
+        for( auto position = _indices.lower_bound( head.old_next_id ); position != _indices.end(); )
         {
-          auto position = _indices.find(id);
-
-          if(position == _indices.end())
-          {
-            CHAINBASE_THROW_EXCEPTION(std::logic_error("unable to find object with id: " +
-              std::to_string(id) + "in the index holding types: " + get_type_name()));
-          }
-
           size_t size = 0;
           if constexpr( value_type::has_dynamic_alloc_t::value )
             size = position->get_dynamic_alloc();
-          _indices.erase( position );
+          position = _indices.erase( position );
           if constexpr( value_type::has_dynamic_alloc_t::value )
             _item_additional_allocation -= size;
         }
@@ -682,8 +745,8 @@ namespace chainbase {
         if( keep_alive )
         {
           head.old_values.clear();
-          head.new_ids.clear();
           head.removed_values.clear();
+          head.old_segments.clear();
           //head.old_next_id stays the same
           //head.revision and _revision stay the same
         }
@@ -710,8 +773,8 @@ namespace chainbase {
           {
             auto& head = _stack.back();
             head.old_values.clear();
-            head.new_ids.clear();
             head.removed_values.clear();
+            head.old_segments.clear();
             head.old_next_id = _next_id;
             ++_revision;
             head.revision = _revision;
@@ -727,7 +790,7 @@ namespace chainbase {
         auto& prev_state = _stack[_stack.size()-2];
 
         // An object's relationship to a state can be:
-        // in new_ids            : new
+        // id >= old_next_id     : new
         // in old_values (was=X) : upd(was=X)
         // in removed (was=X)    : del(was=X)
         // not in any of above   : nop
@@ -770,7 +833,7 @@ namespace chainbase {
 
         for( auto& item : state.old_values )
         {
-          if( prev_state.new_ids.find( item.second.get_id() ) != prev_state.new_ids.end() )
+          if( is_created_in( prev_state, item.second.get_id() ) )
           {
             // new+upd -> new, type A
             continue;
@@ -783,20 +846,44 @@ namespace chainbase {
           // del+upd -> N/A
           assert( prev_state.removed_values.find( item.second.get_id() ) == prev_state.removed_values.end() );
           // nop+upd(was=Y) -> upd(was=Y), type B
+          // (when A holds X in form of segments: upd(was=X) + upd(was=Y) -> upd(was=X), where X is Y with segments applied)
+          if constexpr( use_diff_undo )
+            apply_and_drop_segments( prev_state.old_segments, item.first, reinterpret_cast< char* >( &item.second ) );
           prev_state.old_values.emplace( std::move(item) );
         }
 
-        // *+new, but we assume the N/A cases don't happen, leaving type B nop+new -> new
-        for( const auto& id : state.new_ids )
-          prev_state.new_ids.insert(id);
+        if constexpr( use_diff_undo )
+        {
+          for( auto& item : state.old_segments )
+          {
+            const id_type& id = item.first.first;
+            if( is_created_in( prev_state, id ) )
+            {
+              // new+upd -> new, type A
+              continue;
+            }
+            if( prev_state.old_values.find( id ) != prev_state.old_values.end() )
+            {
+              // upd(was=X) + upd(was=Y) -> upd(was=X), type A
+              continue;
+            }
+            // del+upd -> N/A
+            assert( prev_state.removed_values.find( id ) == prev_state.removed_values.end() );
+            // upd(was=X) + upd(was=Y) -> upd(was=X) per segment: segment recorded in A holds older content, so it
+            // stays; segment not recorded in A did not change in A, so its content from B is also content from before A
+            prev_state.old_segments.emplace( item.first, item.second );
+          }
+        }
+
+        // *+new, but we assume the N/A cases don't happen, leaving type B nop+new -> new; since ids created in B
+        // are above B.old_next_id, they are also above A.old_next_id, so there is nothing to move
 
         // *+del
         for( auto& obj : state.removed_values )
         {
-          if( prev_state.new_ids.find( obj.second.get_id() ) != prev_state.new_ids.end() )
+          if( is_created_in( prev_state, obj.second.get_id() ) )
           {
-            // new + del -> nop (type C)
-            prev_state.new_ids.erase( obj.second.get_id() );
+            // new + del -> nop (type C), object is already gone from the index
             continue;
           }
           auto it = prev_state.old_values.find( obj.second.get_id() );
@@ -810,14 +897,17 @@ namespace chainbase {
           // del + del -> N/A
           assert( prev_state.removed_values.find( obj.second.get_id() ) == prev_state.removed_values.end() );
           // nop + del(was=Y) -> del(was=Y)
+          // (when A holds X in form of segments: upd(was=X) + del(was=Y) -> del(was=X), where X is Y with segments applied)
+          if constexpr( use_diff_undo )
+            apply_and_drop_segments( prev_state.old_segments, obj.first, reinterpret_cast< char* >( &obj.second ) );
           prev_state.removed_values.emplace( std::move(obj) ); //[obj.second->get_id()] = std::move(obj.second);
         }
 
         if( keep_alive )
         {
           state.old_values.clear();
-          state.new_ids.clear();
           state.removed_values.clear();
+          state.old_segments.clear();
           state.old_next_id = _next_id;
           //head.revision and _revision stay the same
         }
@@ -867,7 +957,7 @@ namespace chainbase {
 
         auto& head = _stack.back();
 
-        if( head.new_ids.find( v.get_id() ) != head.new_ids.end() )
+        if( is_created_in( head, v.get_id() ) )
           return;
 
         auto itr = head.old_values.find( v.get_id() );
@@ -882,11 +972,8 @@ namespace chainbase {
         if( !enabled() ) return;
 
         auto& head = _stack.back();
-        if( head.new_ids.count( v.get_id() ) )
-        {
-          head.new_ids.erase( v.get_id() );
+        if( is_created_in( head, v.get_id() ) )
           return;
-        }
 
         auto itr = head.old_values.find( v.get_id() );
         if( itr != head.old_values.end() )
@@ -899,21 +986,104 @@ namespace chainbase {
         if( head.removed_values.count( v.get_id() ) )
           return;
 
+        if constexpr( use_diff_undo )
+        {
+          // turn segments (if any) into full copy of object from before the session
+          alignas( value_type ) char content[ sizeof( value_type ) ];
+          std::memcpy( content, &v, sizeof( value_type ) );
+          apply_and_drop_segments( head.old_segments, v.get_id(), content );
+          head.removed_values.emplace( v.get_id(), as_object( content ).copy_chain_object() );
+          return;
+        }
+
         head.removed_values.emplace( v.get_id(), v.copy_chain_object() );
       }
 
-      void on_create( const value_type& v )
+      // tells if modification of given object needs to be recorded in form of changed segments
+      bool needs_segment_record( const value_type& v ) const
+      {
+        if( !enabled() ) return false;
+
+        const auto& head = _stack.back();
+        return !is_created_in( head, v.get_id() ) && head.old_values.find( v.get_id() ) == head.old_values.end();
+      }
+
+      void on_modify_segments( const value_type& v, const char* old_content )
       {
-        if( !enabled() ) return;
         auto& head = _stack.back();
+        const char* new_content = reinterpret_cast< const char* >( &v );
+
+        size_t segments = std::distance( head.old_segments.lower_bound( diff_key_type( v.get_id(), 0 ) ),
+          head.old_segments.lower_bound( diff_key_type( v.get_id(), diff_segment_count ) ) );
+        for( uint32_t segment = 0; segment < diff_segment_count; ++segment )
+        {
+          const uint32_t offset = segment * diff_segment_size;
+          if( std::memcmp( old_content + offset, new_content + offset, segment_size( segment ) ) == 0 )
+            continue;
+          const diff_key_type key( v.get_id(), segment );
+          // segment recorded by previous modification in the same session already holds older content
+          if( head.old_segments.find( key ) != head.old_segments.end() )
+            continue;
+          diff_segment_type data;
+          std::memcpy( data.data(), old_content + offset, segment_size( segment ) );
+          head.old_segments.emplace( key, data );
+          ++segments;
+        }
+
+        // node of each map entry carries tree links on top of the value
+        constexpr size_t node_overhead = 4 * sizeof( void* );
+        constexpr size_t segment_cost = sizeof( typename undo_state::id_diff_map::value_type ) + node_overhead;
+        constexpr size_t full_copy_cost = sizeof( typename undo_state::id_value_type_map::value_type ) + node_overhead;
+        if( segments * segment_cost >= full_copy_cost )
+        {
+          // most of the object changed - full copy is cheaper
+          alignas( value_type ) char content[ sizeof( value_type ) ];
+          std::memcpy( content, old_content, sizeof( value_type ) );
+          apply_and_drop_segments( head.old_segments, v.get_id(), content );
+          head.old_values.emplace( v.get_id(), as_object( content ).copy_chain_object() );
+        }
+      }
 
-        head.new_ids.insert( v.get_id() );
+      static constexpr uint32_t segment_size( uint32_t segment )
+      {
+        return std::min< uint32_t >( diff_segment_size, sizeof( value_type ) - segment * diff_segment_size );
+      }
+
+      static void restore_segment( char* content, uint32_t segment, const diff_segment_type& data )
+      {
+        std::memcpy( content + segment * diff_segment_size, data.data(), segment_size( segment ) );
+      }
+
+      // puts old content of all recorded segments of given object into given content and removes segments from records
+      static void apply_and_drop_segments( typename undo_state::id_diff_map& segments, const id_type& id, char* content )
+      {
+        auto itr = segments.lower_bound( diff_key_type( id, 0 ) );
+        while( itr != segments.end() && itr->first.first == id )
+        {
+          restore_segment( content, itr->first.second, itr->second );
+          itr = segments.erase( itr );
+        }
+      }
+
+      static const value_type& as_object( const char* content )
+      {
+        return *std::launder( reinterpret_cast< const value_type* >( content ) );
+      }
+
+      void on_create( const value_type& )
+      {
+        // nothing to record, new objects are recognized by their ids (see is_created_in)
+      }
+
+      static bool is_created_in( const undo_state& state, const id_type& id )
+      {
+        return !( id < state.old_next_id );
       }
 
       t_deque< undo_state > _stack;
       // Shared allocators used as 'impl' in all undo_state layers
       undo_state_allocator<typename undo_state::id_value_type_map::stored_allocator_type::value_type> _shared_undo_object_allocator;
-      undo_state_allocator<typename undo_state::id_type_set::stored_allocator_type::value_type> _shared_undo_id_allocator;
+      undo_state_allocator<typename undo_state::id_diff_map::stored_allocator_type::value_type> _shared_undo_diff_allocator;
 
       /**
         *  Each new session increments the revision, a squash will decrement the revision by combining
@@ -11,6 +11,7 @@
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 
+#include <array>
 #include <iostream>
 
 using namespace chainbase;
@@ -56,6 +57,44 @@ inline void unpack(Stream& s, book& id, uint32_t depth = 0, bool limit_is_disabl
   }
 }}
 
+/// object with diff undo records (big enough to be split into many segments)
+class page : public chainbase::object<1, page>
+{
+  CHAINBASE_OBJECT( page );
+
+public:
+  CHAINBASE_DEFAULT_CONSTRUCTOR( page )
+
+  int number = 0;
+  std::array< int64_t, 32 > words = {};
+};
+
+typedef multi_index_container<
+  page,
+  indexed_by<
+    ordered_unique< tag< by_id >, const_mem_fun<page,page::id_type,&page::get_id> >,
+    ordered_non_unique< BOOST_MULTI_INDEX_MEMBER(page,int,number) >
+  >,
+  chainbase::multi_index_allocator<page>
+> page_index;
+
+CHAINBASE_SET_INDEX_TYPE( page, page_index )
+CHAINBASE_SET_DIFF_UNDO( page )
+
+FC_REFLECT(page, (id)(number))
+
+namespace fc {namespace raw {
+template<typename Stream>
+inline void pack(Stream& s, const page&)
+  {
+  }
+
+template<typename Stream>
+inline void unpack(Stream& s, page& id, uint32_t depth = 0, bool limit_is_disabled = false)
+  {
+  }
+}}
+
 
 BOOST_AUTO_TEST_CASE( open_and_create ) {
   boost::filesystem::path temp = boost::filesystem::unique_path();
@@ -154,8 +193,107 @@ BOOST_AUTO_TEST_CASE( open_and_create ) {
   }
 }
 
+BOOST_AUTO_TEST_CASE( diff_undo_records ) {
+  boost::filesystem::path temp = boost::filesystem::unique_path();
+  try {
+    chainbase::database db;
+    db.open( temp, 0, 1024*1024*8 );
+    db.add_index< page_index >();
+
+    const auto& new_page = db.create<page>( []( page& p ) {
+        p.number = 1;
+        for( size_t i = 0; i < p.words.size(); ++i )
+          p.words[i] = i;
+    } );
+    const auto original = new_page.copy_chain_object();
+    auto is_original = [&]( const page& p ) {
+      return p.number == original.number && p.words == original.words;
+    };
+
+    BOOST_TEST_MESSAGE( "Few modifications of the same object in one session" );
+    {
+      auto session = db.start_undo_session();
+      db.modify( new_page, []( page& p ) { p.words[0] = 100; } );
+      db.modify( new_page, []( page& p ) { p.words[0] = 101; p.words[31] = 102; } );
+      db.modify( new_page, []( page& p ) { p.number = 2; } );
+      BOOST_REQUIRE_EQUAL( new_page.words[0], 101 );
+      BOOST_REQUIRE_EQUAL( new_page.number, 2 );
+    }
+    BOOST_REQUIRE( is_original( new_page ) );
+
+    BOOST_TEST_MESSAGE( "Whole object modified (full copy is used instead of segments)" );
+    {
+      auto session = db.start_undo_session();
+      db.modify( new_page, []( page& p ) { p.words[5] = 100; } );
+      db.modify( new_page, []( page& p ) {
+        for( auto& word : p.words )
+          word = -word - 1;
+      } );
+      db.modify( new_page, []( page& p ) { p.words[5] = 200; } );
+    }
+    BOOST_REQUIRE( is_original( new_page ) );
+
+    BOOST_TEST_MESSAGE( "Squash of sessions with overlapping segments" );
+    {
+      auto outer = db.start_undo_session();
+      db.modify( new_page, []( page& p ) { p.words[1] = 100; } );
+      {
+        auto inner = db.start_undo_session();
+        db.modify( new_page, []( page& p ) { p.words[1] = 200; p.words[20] = 200; } );
+        inner.squash();
+      }
+      BOOST_REQUIRE_EQUAL( new_page.words[1], 200 );
+      BOOST_REQUIRE_EQUAL( new_page.words[20], 200 );
+    }
+    BOOST_REQUIRE( is_original( new_page ) );
+
+    BOOST_TEST_MESSAGE( "Squash of full copy over segments" );
+    {
+      auto outer = db.start_undo_session();
+      db.modify( new_page, []( page& p ) { p.words[2] = 100; } );
+      {
+        auto inner = db.start_undo_session();
+        db.modify( new_page, []( page& p ) {
+          for( auto& word : p.words )
+            word = 300;
+        } );
+        inner.squash();
+      }
+    }
+    BOOST_REQUIRE( is_original( new_page ) );
+
+    BOOST_TEST_MESSAGE( "Removal of object modified in the same session" );
+    {
+      auto session = db.start_undo_session();
+      db.modify( new_page, []( page& p ) { p.words[3] = 100; } );
+      db.remove( new_page );
+      BOOST_CHECK_THROW( db.get( page::id_type(0) ), std::out_of_range );
+    }
+    BOOST_REQUIRE( is_original( db.get( page::id_type(0) ) ) );
+
+    BOOST_TEST_MESSAGE( "Squash of removal over segments" );
+    {
+      auto outer = db.start_undo_session();
+      db.modify( db.get( page::id_type(0) ), []( page& p ) { p.words[4] = 100; } );
+      {
+        auto inner = db.start_undo_session();
+        db.modify( db.get( page::id_type(0) ), []( page& p ) { p.words[30] = 100; } );
+        db.remove( db.get( page::id_type(0) ) );
+        inner.squash();
+      }
+      BOOST_CHECK_THROW( db.get( page::id_type(0) ), std::out_of_range );
+    }
+    BOOST_REQUIRE( is_original( db.get( page::id_type(0) ) ) );
+  } catch ( ... ) {
+    bfs::remove_all( temp );
+    throw;
+  }
+  bfs::remove_all( temp );
+}
+
 // Explicit template instantiations for chainbase::database methods
 template const chainbase::generic_index<book_index>& chainbase::database::get_index<book_index>() const;
 template chainbase::generic_index<book_index>& chainbase::database::get_mutable_index<book_index>();
 
-// BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+// BOOST_AUTO_TEST_SUITE_END()template const chainbase::generic_index<page_index>& chainbase::database::get_index<page_index>() const;
+template chainbase::generic_index<page_index>& chainbase::database::get_mutable_index<page_index>();
@@ -126,7 +126,7 @@ namespace graphene { namespace net {
       data[1] = *compressed_data.compression_attributes.dictionary_number;
     }
 
-    memcpy(&data[COMPRESSED_BLOCK_COMPRESSION_METADATA_SIZE], compressed_data.compressed_bytes.get(), compressed_data.compressed_size);
+    memcpy(&data[COMPRESSED_BLOCK_COMPRESSION_METADATA_SIZE], compressed_data.data(), compressed_data.compressed_size);
     size = data.size();
   }
 
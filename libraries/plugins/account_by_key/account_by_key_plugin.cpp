@@ -38,8 +38,8 @@ class account_by_key_plugin_impl
     flat_set< public_key_type >   cached_keys;
     database&                     _db;
     account_by_key_plugin&        _self;
-    chain::database::signal_connection_ptr   _pre_apply_operation_conn;
-    chain::database::signal_connection_ptr   _post_apply_operation_conn;
+    std::vector< chain::database::signal_connection_ptr > _pre_apply_operation_conns;
+    std::vector< chain::database::signal_connection_ptr > _post_apply_operation_conns;
 };
 
 struct pre_operation_visitor
@@ -297,8 +297,17 @@ void account_by_key_plugin::plugin_initialize( const boost::program_options::var
     ilog( "Initializing account_by_key plugin" );
     chain::database& db = get_app().get_plugin< hive::plugins::chain::chain_plugin >().db();
 
-    my->_pre_apply_operation_conn = db.add_pre_apply_operation_handler( [&]( const operation_notification& note ){ my->on_pre_apply_operation( note ); }, *this, 0 );
-    my->_post_apply_operation_conn = db.add_post_apply_operation_handler( [&]( const operation_notification& note ){ my->on_post_apply_operation( note ); }, *this, 0 );
+    // only operations handled by visitors are subscribed to
+    my->_pre_apply_operation_conns = db.add_pre_apply_operation_handler_for<
+      account_create_operation, account_create_with_delegation_operation, account_update_operation,
+      account_update2_operation, create_claimed_account_operation, recover_account_operation,
+      pow_operation, pow2_operation >(
+        [&]( const operation_notification& note ){ my->on_pre_apply_operation( note ); }, *this, 0 );
+    my->_post_apply_operation_conns = db.add_post_apply_operation_handler_for<
+      account_create_operation, account_create_with_delegation_operation, account_update_operation,
+      account_update2_operation, create_claimed_account_operation, recover_account_operation,
+      pow_operation, pow2_operation, hardfork_operation >(
+        [&]( const operation_notification& note ){ my->on_post_apply_operation( note ); }, *this, 0 );
 
     HIVE_ADD_PLUGIN_INDEX(db, key_lookup_index);
 
@@ -311,8 +320,8 @@ void account_by_key_plugin::plugin_startup() {}
 
 void account_by_key_plugin::plugin_shutdown()
 {
-  hive::utilities::disconnect_signal( my->_pre_apply_operation_conn );
-  hive::utilities::disconnect_signal( my->_post_apply_operation_conn );
+  hive::utilities::disconnect_signal( my->_pre_apply_operation_conns );
+  hive::utilities::disconnect_signal( my->_post_apply_operation_conns );
 }
 
 } } } // hive::plugins::account_by_key
@@ -338,6 +338,7 @@ account_history_api::account_history_api( appbase::application& app )
 {
   my = std::make_unique< detail::account_history_api_rocksdb_impl >( app );
   JSON_RPC_REGISTER_API( HIVE_ACCOUNT_HISTORY_API_PLUGIN_NAME );
+  JSON_RPC_REGISTER_BINARY_API( HIVE_ACCOUNT_HISTORY_API_PLUGIN_NAME );
 }
 
 account_history_api::~account_history_api() {}
@@ -339,3 +339,31 @@ FC_REFLECT( hive::plugins::account_history::ops_array_wrapper, (block)(irreversi
 
 FC_REFLECT( hive::plugins::account_history::enum_virtual_ops_return,
   (ops)(ops_by_block)(next_block_range_begin)(next_operation_begin) )
+
+namespace fc { namespace raw {
+
+// binary form of get_ops_in_block_return (std::multiset is not covered by generic fc::raw serialization)
+template< typename Stream >
+void pack( Stream& s, const hive::plugins::account_history::get_ops_in_block_return& r )
+{
+  fc::raw::pack( s, unsigned_int( (uint32_t)r.ops.size() ) );
+  for( const auto& op : r.ops )
+    fc::raw::pack( s, op );
+}
+
+template< typename Stream >
+void unpack( Stream& s, hive::plugins::account_history::get_ops_in_block_return& r, uint32_t depth = 0, bool limit_is_disabled = false )
+{
+  depth++;
+  unsigned_int size;
+  fc::raw::unpack( s, size, depth );
+  r.ops.clear();
+  for( uint32_t i = 0; i < size.value; ++i )
+  {
+    hive::plugins::account_history::api_operation_object op;
+    fc::raw::unpack( s, op, depth );
+    r.ops.insert( std::move( op ) );
+  }
+}
+
+} } // fc::raw
@@ -7,8 +7,25 @@
 
 #include <hive/protocol/get_config.hpp>
 
+#include <hive/chain/notifications.hpp>
+
+#include <hive/utilities/signal.hpp>
+
+#include <fc/thread/thread.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 namespace hive { namespace plugins { namespace block_api {
 
+using hive::chain::block_notification;
+using hive::chain::operation_notification;
+
 //////////////////////////////////////////////////////////////////////
 //                                                                  //
 // api_signed_block_object constructor                              //
@@ -26,6 +43,231 @@ api_signed_block_object::api_signed_block_object(const std::shared_ptr<hive::cha
     transaction_ids.push_back(full_transaction->get_transaction_id());
 }
 
+/**
+  * Pushes blocks (and their virtual operations) to websocket subscribers.
+  * Notifications are collected on the writer thread only when there are subscribers, then
+  * serialized and delivered on dedicated thread, so slow subscribers never block block processing.
+  */
+class block_stream
+{
+  public:
+    block_stream( appbase::application& app, const hive::chain::block_read_i& block_reader );
+    ~block_stream();
+
+    subscribe_blocks_return subscribe( const subscribe_blocks_args& args, const json_rpc::subscription_sink& sink );
+    void stop();
+
+  private:
+    using operations_ptr = std::shared_ptr< const vector< hive::protocol::operation > >;
+
+    struct subscriber
+    {
+      subscribe_blocks_args        args;
+      json_rpc::subscription_sink  sink;
+    };
+
+    // writer thread
+    void on_pre_apply_block( const block_notification& note );
+    void on_post_apply_operation( const operation_notification& note );
+    void on_post_apply_block( const block_notification& note );
+    void on_irreversible_block( uint32_t block_num );
+
+    // stream thread
+    void publish( const std::shared_ptr< hive::chain::full_block_type >& full_block, const operations_ptr& virtual_ops, bool irreversible );
+
+    const hive::chain::block_read_i&                _block_reader;
+
+    std::atomic< uint32_t >                         _subscriber_count = { 0 };
+    std::atomic< uint64_t >                         _next_subscription_id = { 1 };
+
+    // collected by writer thread while block is applied (only when there are subscribers)
+    bool                                            _collecting = false;
+    std::shared_ptr< vector< hive::protocol::operation > > _block_virtual_ops;
+
+    // owned by stream thread
+    std::map< uint64_t, subscriber >                _subscribers;
+    std::map< uint32_t, operations_ptr >            _reversible_virtual_ops; // waiting for blocks to become irreversible
+    uint32_t                                        _last_irreversible_published = 0;
+
+    boost::asio::io_context                         _ios;
+    using work_guard_type = boost::asio::executor_work_guard< boost::asio::io_context::executor_type >;
+    std::unique_ptr< work_guard_type >              _work;
+    std::thread                                     _thread;
+
+    hive::chain::database::signal_connection_ptr    _pre_apply_block_conn;
+    hive::chain::database::signal_connection_ptr    _post_apply_operation_conn;
+    hive::chain::database::signal_connection_ptr    _post_apply_block_conn;
+    hive::chain::database::signal_connection_ptr    _irreversible_block_conn;
+};
+
+block_stream::block_stream( appbase::application& app, const hive::chain::block_read_i& block_reader )
+  : _block_reader( block_reader ), _work( new work_guard_type( _ios.get_executor() ) )
+{
+  auto& db = app.get_plugin< hive::plugins::chain::chain_plugin >().db();
+  const auto& plugin = app.get_plugin< block_api_plugin >();
+
+  _pre_apply_block_conn = db.add_pre_apply_block_handler(
+    [&]( const block_notification& note ){ on_pre_apply_block( note ); }, plugin, 0 );
+  _post_apply_operation_conn = db.add_post_apply_operation_handler(
+    [&]( const operation_notification& note ){ on_post_apply_operation( note ); }, plugin, 0 );
+  _post_apply_block_conn = db.add_post_apply_block_handler(
+    [&]( const block_notification& note ){ on_post_apply_block( note ); }, plugin, 0 );
+  _irreversible_block_conn = db.add_irreversible_block_handler(
+    [&]( uint32_t block_num ){ on_irreversible_block( block_num ); }, plugin, 0 );
+
+  _thread = std::thread( [this]()
+  {
+    fc::set_thread_name( "block_stream" );
+    fc::thread::current().set_name( "block_stream" );
+    _ios.run();
+  } );
+}
+
+block_stream::~block_stream()
+{
+  stop();
+}
+
+void block_stream::stop()
+{
+  hive::utilities::disconnect_signal( _pre_apply_block_conn );
+  hive::utilities::disconnect_signal( _post_apply_operation_conn );
+  hive::utilities::disconnect_signal( _post_apply_block_conn );
+  hive::utilities::disconnect_signal( _irreversible_block_conn );
+
+  if( _thread.joinable() )
+  {
+    _work.reset();
+    _ios.stop();
+    _thread.join();
+  }
+  _subscribers.clear();
+  _subscriber_count = 0;
+}
+
+subscribe_blocks_return block_stream::subscribe( const subscribe_blocks_args& args, const json_rpc::subscription_sink& sink )
+{
+  FC_ASSERT( _thread.joinable(), "Block streaming is not active" );
+
+  subscribe_blocks_return result;
+  result.subscription_id = _next_subscription_id++;
+  ++_subscriber_count;
+  boost::asio::post( _ios, [this, id = result.subscription_id, s = subscriber{ args, sink }]()
+  {
+    _subscribers.emplace( id, s );
+  } );
+  return result;
+}
+
+void block_stream::on_pre_apply_block( const block_notification& note )
+{
+  _collecting = _subscriber_count.load( std::memory_order_relaxed ) > 0;
+  if( _collecting )
+    _block_virtual_ops = std::make_shared< vector< hive::protocol::operation > >();
+}
+
+void block_stream::on_post_apply_operation( const operation_notification& note )
+{
+  // virtual operations of pending transactions are not part of any block
+  if( _collecting && note.virtual_op )
+    _block_virtual_ops->push_back( note.op );
+}
+
+void block_stream::on_post_apply_block( const block_notification& note )
+{
+  if( !_collecting )
+    return;
+  _collecting = false;
+
+  boost::asio::post( _ios, [this, full_block = note.full_block, virtual_ops = operations_ptr( std::move( _block_virtual_ops ) )]()
+  {
+    _reversible_virtual_ops[ full_block->get_block_num() ] = virtual_ops; // in case of fork replaces ops of popped block
+    publish( full_block, virtual_ops, false );
+  } );
+}
+
+void block_stream::on_irreversible_block( uint32_t block_num )
+{
+  if( _subscriber_count.load( std::memory_order_relaxed ) == 0 )
+    return;
+
+  boost::asio::post( _ios, [this, block_num]()
+  {
+    if( _last_irreversible_published == 0 || _last_irreversible_published >= block_num )
+      _last_irreversible_published = block_num - 1;
+
+    bool irreversible_subscribers = std::any_of( _subscribers.begin(), _subscribers.end(),
+      []( const auto& s ){ return s.second.args.only_irreversible; } );
+
+    try
+    {
+      for( uint32_t num = _last_irreversible_published + 1; irreversible_subscribers && num <= block_num; ++num )
+      {
+        std::shared_ptr< hive::chain::full_block_type > full_block = _block_reader.get_block_by_number( num, fc::seconds( 1 ) );
+        if( !full_block )
+          continue;
+
+        operations_ptr virtual_ops;
+        auto ops_itr = _reversible_virtual_ops.find( num );
+        if( ops_itr != _reversible_virtual_ops.end() )
+          virtual_ops = ops_itr->second;
+        publish( full_block, virtual_ops, true );
+      }
+    }
+    FC_CAPTURE_AND_LOG( (block_num) )
+    _last_irreversible_published = block_num;
+    _reversible_virtual_ops.erase( _reversible_virtual_ops.begin(), _reversible_virtual_ops.upper_bound( block_num ) );
+  } );
+}
+
+void block_stream::publish( const std::shared_ptr< hive::chain::full_block_type >& full_block, const operations_ptr& virtual_ops, bool irreversible )
+{
+  // each notification variant is serialized at most once, no matter how many subscribers want it
+  fc::optional< std::string > with_ops, without_ops;
+  auto get_message = [&]( bool include_virtual_ops ) -> const std::string&
+  {
+    fc::optional< std::string >& message = include_virtual_ops ? with_ops : without_ops;
+    if( !message.valid() )
+    {
+      on_block_notification notification;
+      notification.params.irreversible = irreversible;
+      notification.params.block = api_signed_block_object( full_block );
+      if( include_virtual_ops && virtual_ops )
+        notification.params.virtual_ops = *virtual_ops;
+      message = fc::json::to_string( notification );
+    }
+    return *message;
+  };
+
+  for( auto itr = _subscribers.begin(); itr != _subscribers.end(); )
+  {
+    const subscriber& s = itr->second;
+    if( s.args.only_irreversible != irreversible )
+    {
+      ++itr;
+      continue;
+    }
+
+    bool delivered = false;
+    try
+    {
+      delivered = s.sink( get_message( s.args.include_virtual_ops ) );
+    }
+    FC_CAPTURE_AND_LOG( (itr->first) )
+
+    if( delivered )
+    {
+      ++itr;
+    }
+    else
+    {
+      dlog( "Dropping block stream subscription ${id}", ( "id", itr->first ) );
+      itr = _subscribers.erase( itr );
+      --_subscriber_count;
+    }
+  }
+}
+
 class block_api_impl
 {
   public:
@@ -39,6 +281,7 @@ class block_api_impl
     )
 
     const hive::chain::block_read_i& _block_reader;
+    block_stream                     _stream;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -51,12 +294,31 @@ block_api::block_api( appbase::application& app )
   : my( new block_api_impl( app ) )
 {
   JSON_RPC_REGISTER_API( HIVE_BLOCK_API_PLUGIN_NAME );
+  JSON_RPC_REGISTER_BINARY_API( HIVE_BLOCK_API_PLUGIN_NAME );
+
+  app.get_plugin< json_rpc::json_rpc_plugin >().add_subscription_method( HIVE_BLOCK_API_PLUGIN_NAME, "subscribe_blocks",
+    [this]( const fc::variant& args, const json_rpc::subscription_sink& sink ) -> fc::variant
+    {
+      return fc::variant( subscribe_blocks( args.as< subscribe_blocks_args >(), sink ) );
+    },
+    json_rpc::api_method_signature{ fc::variant( subscribe_blocks_args() ), fc::variant( subscribe_blocks_return() ) } );
 }
 
 block_api::~block_api() {}
 
+subscribe_blocks_return block_api::subscribe_blocks( const subscribe_blocks_args& args, const json_rpc::subscription_sink& sink )
+{
+  return my->_stream.subscribe( args, sink );
+}
+
+void block_api::stop_streaming()
+{
+  my->_stream.stop();
+}
+
 block_api_impl::block_api_impl( appbase::application& app )
-  : _block_reader( app.get_plugin< hive::plugins::chain::chain_plugin >().block_reader() ) {}
+  : _block_reader( app.get_plugin< hive::plugins::chain::chain_plugin >().block_reader() ),
+    _stream( app, _block_reader ) {}
 
 block_api_impl::~block_api_impl() {}
 
@@ -17,6 +17,10 @@ void block_api_plugin::plugin_initialize( const variables_map& options )
 
 void block_api_plugin::plugin_startup() {}
 
-void block_api_plugin::plugin_shutdown() {}
+void block_api_plugin::plugin_shutdown()
+{
+  if( api )
+    api->stop_streaming();
+}
 
 } } } // hive::plugins::block_api
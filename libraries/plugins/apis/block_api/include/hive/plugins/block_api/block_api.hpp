@@ -1,6 +1,7 @@
 #pragma once
 
 #include <hive/plugins/json_rpc/utility.hpp>
+#include <hive/plugins/json_rpc/json_rpc_plugin.hpp>
 
 #include <hive/plugins/block_api/block_api_args.hpp>
 
@@ -50,6 +51,18 @@ class block_api
       (get_block_range)
     )
 
+    /**
+    * @brief Subscribe to stream of blocks (available only over websocket)
+    * @param only_irreversible when set, blocks are pushed once they become irreversible, otherwise as soon as they are applied
+    * @param include_virtual_ops when set, virtual operations generated by each block are pushed together with it
+    * @return id of subscription; notifications are then pushed as "block_api.on_block" calls (see on_block_notification)
+    *         until the connection is closed (subscriber that does not keep up is disconnected)
+    */
+    subscribe_blocks_return subscribe_blocks( const subscribe_blocks_args& args, const json_rpc::subscription_sink& sink );
+
+    /// Stops pushing notifications to subscribers
+    void stop_streaming();
+
   private:
     std::unique_ptr< block_api_impl > my;
 };
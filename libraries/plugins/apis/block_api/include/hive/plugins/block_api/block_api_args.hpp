@@ -4,6 +4,7 @@
 #include <hive/protocol/types.hpp>
 #include <hive/protocol/transaction.hpp>
 #include <hive/protocol/block_header.hpp>
+#include <hive/protocol/operations.hpp>
 
 #include <hive/plugins/json_rpc/utility.hpp>
 
@@ -48,6 +49,35 @@ struct get_block_range_return
   vector<api_signed_block_object> blocks;
 };
 
+/* subscribe_blocks */
+struct subscribe_blocks_args
+{
+  bool only_irreversible = false;
+  bool include_virtual_ops = true;
+};
+
+struct subscribe_blocks_return
+{
+  uint64_t subscription_id = 0;
+};
+
+/// content of notification pushed to subscribers for each new (or newly irreversible) block
+struct on_block_params
+{
+  bool                                        irreversible = false;
+  api_signed_block_object                     block;
+  /// not set when virtual operations were not requested or are not known (block was applied before subscription)
+  optional< vector< hive::protocol::operation > > virtual_ops;
+};
+
+/// JSON-RPC notification (request without id) as sent over websocket
+struct on_block_notification
+{
+  std::string     jsonrpc = "2.0";
+  std::string     method = "block_api.on_block";
+  on_block_params params;
+};
+
 } } } // hive::block_api
 
 FC_REFLECT( hive::plugins::block_api::get_block_header_args,
@@ -69,3 +99,20 @@ FC_REFLECT( hive::plugins::block_api::get_block_range_args,
 FC_REFLECT( hive::plugins::block_api::get_block_range_return,
   (blocks) )
 
+
+FC_REFLECT( hive::plugins::block_api::subscribe_blocks_args,
+  (only_irreversible)
+  (include_virtual_ops) )
+
+FC_REFLECT( hive::plugins::block_api::subscribe_blocks_return,
+  (subscription_id) )
+
+FC_REFLECT( hive::plugins::block_api::on_block_params,
+  (irreversible)
+  (block)
+  (virtual_ops) )
+
+FC_REFLECT( hive::plugins::block_api::on_block_notification,
+  (jsonrpc)
+  (method)
+  (params) )
@@ -374,7 +374,7 @@ namespace detail
       auto itr = idx.find( name );
       if ( itr != idx.end() )
       {
-        results.emplace_back( extended_account( database_api::api_account_object( *itr, _db, _metadata_plugin, delayed_votes_active ) ) );
+        results.emplace_back( extended_account( _database_api->get_api_account_object( *itr, delayed_votes_active ) ) );
 
         if(_reputation_api)
         {
@@ -415,7 +415,7 @@ namespace detail
 
       if( itr )
       {
-        result.push_back( api_account_object( database_api::api_account_object( *itr, _db, _metadata_plugin, delayed_votes_active ) ) );
+        result.push_back( api_account_object( _database_api->get_api_account_object( *itr, delayed_votes_active ) ) );
       }
       else
       {
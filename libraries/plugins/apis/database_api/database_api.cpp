@@ -1,12 +1,14 @@
 #include <hive/plugins/database_api/database_api_impl.hpp>
 
 #include <hive/chain/comment_object.hpp>
+#include <hive/chain/notifications.hpp>
 #include <hive/chain/global_property_object.hpp>
 #include <hive/chain/detail/state/feed_history_object_multiindex.hpp>
 #include <hive/chain/detail/state/reward_fund_object_multiindex.hpp>
 #include <hive/chain/witness_objects.hpp>
 
 #include <hive/utilities/git_revision.hpp>
+#include <hive/utilities/signal.hpp>
 
 namespace hive { namespace plugins { namespace database_api {
 
@@ -43,13 +45,25 @@ database_api::database_api( appbase::application& app )
   : my( new database_api_impl( app ) ), theApp( app )
 {
   JSON_RPC_REGISTER_API( HIVE_DATABASE_API_PLUGIN_NAME );
+  JSON_RPC_REGISTER_BINARY_API( HIVE_DATABASE_API_PLUGIN_NAME );
 }
 
 database_api::~database_api() {}
 
+void database_api::enable_object_cache( size_t max_size )
+{
+  my->enable_object_cache( max_size );
+}
+
+api_account_object database_api::get_api_account_object( const account_object& a, bool delayed_votes_active )
+{
+  return my->get_api_account_object( a, delayed_votes_active );
+}
+
 void database_api::api_startup()
 {
   my->initialize_metadata_plugin();
+  my->start_head_state_publication();
 }
 
 database_api_impl::database_api_impl( appbase::application& app )
@@ -62,7 +76,96 @@ void database_api_impl::initialize_metadata_plugin()
   _metadata_plugin = _app.find_plugin< hive::plugins::metadata::metadata_plugin >();
 }
 
-database_api_impl::~database_api_impl() {}
+void database_api_impl::enable_object_cache( size_t max_size )
+{
+  _account_cache.set_max_size( max_size );
+  _dgpo_cache.set_max_size( 1 );
+
+  const auto& plugin = _app.get_plugin< database_api_plugin >();
+  _post_apply_block_conn = _db.add_post_apply_block_handler(
+    [&]( const block_notification& ){ ++_state_generation; }, plugin, 0 );
+  // pending transactions change state between blocks as well
+  _post_apply_transaction_conn = _db.add_post_apply_transaction_handler(
+    [&]( const transaction_notification& ){ ++_state_generation; }, plugin, 0 );
+  // state is rolled back when block fails, and it can also be edited directly by debug_node
+  _fail_apply_block_conn = _db.add_fail_apply_block_handler(
+    [&]( const block_notification& ){ ++_state_generation; }, plugin, 0 );
+  _debug_state_change_conn = _db.add_debug_state_change_handler(
+    [&](){ ++_state_generation; }, plugin, 0 );
+}
+
+api_account_object database_api_impl::get_api_account_object( const account_object& a, bool delayed_votes_active )
+{
+  return _account_cache.get( std::make_pair( a.get_name(), delayed_votes_active ), _state_generation.load(),
+    [&](){ return api_account_object( a, _db, get_metadata_plugin(), delayed_votes_active ); } );
+}
+
+void database_api_impl::start_head_state_publication()
+{
+  const auto& plugin = _app.get_plugin< database_api_plugin >();
+  // runs on write thread at the end of _apply_block, so chain objects can be read without extra locking
+  _head_state_post_apply_block_conn = _db.add_post_apply_block_handler(
+    [&]( const block_notification& )
+    {
+      if( _db.is_replaying_block() )
+        publish_head_state( nullptr ); // no one is asking during replay, don't waste time
+      else
+        publish_head_state( std::make_shared< const head_state_snapshot >( _db ) );
+    }, plugin );
+  _head_state_fail_apply_block_conn = _db.add_fail_apply_block_handler(
+    [&]( const block_notification& ){ publish_head_state( nullptr ); }, plugin );
+  _head_state_switch_fork_conn = _db.add_switch_fork_handler(
+    [&]( uint32_t ){ publish_head_state( nullptr ); }, plugin );
+  _head_state_debug_state_change_conn = _db.add_debug_state_change_handler(
+    [&](){ publish_head_state( nullptr ); }, plugin );
+}
+
+/* static */ size_t database_api_impl::get_worker_pool_size()
+{
+  static const size_t size = std::max( 1u, std::thread::hardware_concurrency() );
+  return size;
+}
+
+/* static */ boost::asio::thread_pool& database_api_impl::get_worker_pool()
+{
+  static boost::asio::thread_pool pool( get_worker_pool_size() );
+  return pool;
+}
+
+database_api_impl::~database_api_impl()
+{
+  hive::utilities::disconnect_signal( _post_apply_block_conn );
+  hive::utilities::disconnect_signal( _post_apply_transaction_conn );
+  hive::utilities::disconnect_signal( _fail_apply_block_conn );
+  hive::utilities::disconnect_signal( _debug_state_change_conn );
+  hive::utilities::disconnect_signal( _head_state_post_apply_block_conn );
+  hive::utilities::disconnect_signal( _head_state_fail_apply_block_conn );
+  hive::utilities::disconnect_signal( _head_state_switch_fork_conn );
+  hive::utilities::disconnect_signal( _head_state_debug_state_change_conn );
+}
+
+head_state_snapshot::head_state_snapshot( const database& db )
+  : _dgpo( db.get_dynamic_global_properties(), db ),
+    _witness_schedule( db.get_witness_schedule_object(), db.get_witness_schedule_object(), false, db ),
+    _hardfork_properties( db.get_hardfork_property_object() ),
+    _current_price_feed( db.get_feed_history().current_median_history.to_price() ),
+    _feed_history( db.get_feed_history() )
+{
+  if( db.has_hardfork( HIVE_HARDFORK_1_26 ) )
+    _full_witness_schedule = api_witness_schedule_object( db.get_witness_schedule_object(), db.get_future_witness_schedule_object(), true, db );
+
+  const auto& rf_idx = db.get_index< reward_fund_index, by_id >();
+  for( const auto& rf : rf_idx )
+    _reward_funds.funds.emplace_back( rf, db );
+}
+
+get_witness_schedule_return head_state_snapshot::get_witness_schedule( const get_witness_schedule_args& args ) const
+{
+  if( !args.include_future )
+    return _witness_schedule;
+  FC_ASSERT( _full_witness_schedule.valid(), "Future witnesses only become available after HF26" );
+  return *_full_witness_schedule;
+}
 
 //////////////////////////////////////////////////////////////////////
 //                                                                  //
@@ -88,7 +191,8 @@ DEFINE_API_IMPL( database_api_impl, get_version )
 
 DEFINE_API_IMPL( database_api_impl, get_dynamic_global_properties )
 {
-  return api_dynamic_global_property_object( _db.get_dynamic_global_properties(), _db );
+  return _dgpo_cache.get( _db.head_block_num(), _state_generation.load(),
+    [&](){ return api_dynamic_global_property_object( _db.get_dynamic_global_properties(), _db ); } );
 }
 
 #define FILL_FIELD(field) if( active.field != future.field ) { filled = true; field = future.field; }
@@ -177,21 +281,46 @@ DEFINE_API_IMPL( database_api_impl, get_feed_history )
 //                                                                  //
 //////////////////////////////////////////////////////////////////////
 
+// Served from head_state_snapshot when called with lock (from outside), so there is no competition with
+// the writer for chainbase lock. Internal calls (already under lock) read current state directly.
+#define DEFINE_HEAD_STATE_API_HELPER( r, class, method )                                                  \
+BOOST_PP_CAT( method, _return ) class :: method ( const BOOST_PP_CAT( method, _args )& args, bool lock ) \
+{                                                                                                        \
+  if( lock )                                                                                            \
+  {                                                                                                     \
+    auto head_state = my->get_head_state();                                                             \
+    if( head_state )                                                                                    \
+      return head_state->method( args );                                                               \
+    return my->_db.with_read_lock( [&args, this](){ return my->method( args ); }, fc::seconds(1));     \
+  }                                                                                                     \
+  else                                                                                                  \
+  {                                                                                                     \
+    return my->method( args );                                                                         \
+  }                                                                                                     \
+}
+
 DEFINE_LOCKLESS_APIS( database_api, (get_config)(get_version) )
 
-DEFINE_READ_APIS( database_api,
+BOOST_PP_SEQ_FOR_EACH( DEFINE_HEAD_STATE_API_HELPER, database_api,
   (get_dynamic_global_properties)
   (get_witness_schedule)
   (get_hardfork_properties)
   (get_reward_funds)
   (get_current_price_feed)
   (get_feed_history)
+)
+
+#undef DEFINE_HEAD_STATE_API_HELPER
+
+DEFINE_READ_APIS( database_api,
   (list_witnesses)
   (find_witnesses)
   (list_witness_votes)
+  (export_witness_votes)
   (get_active_witnesses)
   (list_accounts)
   (find_accounts)
+  (export_accounts)
   (list_owner_histories)
   (find_owner_histories)
   (list_account_recovery_requests)
@@ -218,6 +347,7 @@ DEFINE_READ_APIS( database_api,
   (list_limit_orders)
   (find_limit_orders)
   (list_proposals)
+  (export_proposals)
   (find_proposals)
   (list_proposal_votes)
   (get_order_book)
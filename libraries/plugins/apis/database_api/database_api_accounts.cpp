@@ -142,6 +142,29 @@ DEFINE_API_IMPL( database_api_impl, list_witness_votes )
   return result;
 }
 
+DEFINE_API_IMPL( database_api_impl, export_witness_votes )
+{
+  FC_ASSERT( 0 < args.limit && args.limit <= DATABASE_API_EXPORT_QUERY_LIMIT, "limit not set or too big" );
+
+  export_witness_votes_return result;
+
+  switch( args.order )
+  {
+    case( by_account_witness ):
+      result.next_cursor = export_results< chain::witness_vote_index, chain::by_account_witness >( args.cursor, result.votes, args.limit,
+        &database_api_impl::on_push_default< api_witness_vote_object, witness_vote_object > );
+      break;
+    case( by_witness_account ):
+      result.next_cursor = export_results< chain::witness_vote_index, chain::by_witness_account >( args.cursor, result.votes, args.limit,
+        &database_api_impl::on_push_default< api_witness_vote_object, witness_vote_object > );
+      break;
+    default:
+      FC_ASSERT( false, "Unknown or unsupported sort order '${o}'", ( "o", args.order ) );
+  }
+
+  return result;
+}
+
 DEFINE_API_IMPL( database_api_impl, get_active_witnesses )
 {
   FC_ASSERT( _db.has_hardfork( HIVE_HARDFORK_1_26 ) || !args.include_future, "Future witnesses only become available after HF26" );
@@ -187,7 +210,7 @@ DEFINE_API_IMPL( database_api_impl, list_accounts )
         start,
         result.accounts,
         args.limit,
-        [&]( const account_object& a, const database& db ){ return api_account_object( a, db, get_metadata_plugin(), args.delayed_votes_active ); },
+        [&]( const account_object& a, const database& ){ return get_api_account_object( a, args.delayed_votes_active ); },
         &database_api_impl::filter_default< account_object > );
       break;
     }
@@ -210,7 +233,7 @@ DEFINE_API_IMPL( database_api_impl, list_accounts )
         start,
         result.accounts,
         args.limit,
-        [&]( const account_object& a, const database& db ){ return api_account_object( a, db, get_metadata_plugin(), args.delayed_votes_active ); },
+        [&]( const account_object& a, const database& ){ return get_api_account_object( a, args.delayed_votes_active ); },
         &database_api_impl::filter_default< account_object > );
       break;
     }
@@ -226,7 +249,7 @@ DEFINE_API_IMPL( database_api_impl, list_accounts )
         start,
         result.accounts,
         args.limit,
-        [&]( const account_object& a, const database& db ){ return api_account_object( a, db, get_metadata_plugin(), args.delayed_votes_active ); },
+        [&]( const account_object& a, const database& ){ return get_api_account_object( a, args.delayed_votes_active ); },
         &database_api_impl::filter_default< account_object > );
       break;
     }
@@ -247,7 +270,36 @@ DEFINE_API_IMPL( database_api_impl, find_accounts )
   {
     auto acct = _db.find< chain::account_object, chain::by_name >( a );
     if( acct != nullptr )
-      result.accounts.emplace_back( *acct, _db, get_metadata_plugin(), args.delayed_votes_active );
+      result.accounts.emplace_back( get_api_account_object( *acct, args.delayed_votes_active ) );
+  }
+
+  return result;
+}
+
+DEFINE_API_IMPL( database_api_impl, export_accounts )
+{
+  FC_ASSERT( 0 < args.limit && args.limit <= DATABASE_API_EXPORT_QUERY_LIMIT, "limit not set or too big" );
+
+  export_accounts_return result;
+  // objects are constructed in parallel, so they don't go through (shared) api object cache
+  auto on_push = [&]( const account_object& a, const database& db )
+  {
+    return api_account_object( a, db, get_metadata_plugin(), args.delayed_votes_active );
+  };
+
+  switch( args.order )
+  {
+    case( by_name ):
+      result.next_cursor = export_results< chain::account_index, chain::by_name >( args.cursor, result.accounts, args.limit, on_push );
+      break;
+    case( by_proxy ):
+      result.next_cursor = export_results< chain::account_index, chain::by_proxy >( args.cursor, result.accounts, args.limit, on_push );
+      break;
+    case( by_next_vesting_withdrawal ):
+      result.next_cursor = export_results< chain::account_index, chain::by_next_vesting_withdrawal >( args.cursor, result.accounts, args.limit, on_push );
+      break;
+    default:
+      FC_ASSERT( false, "Unknown or unsupported sort order '${o}'", ( "o", args.order ) );
   }
 
   return result;
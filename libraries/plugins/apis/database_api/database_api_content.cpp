@@ -209,6 +209,36 @@ DEFINE_API_IMPL( database_api_impl, list_proposals )
   return result;
 }
 
+DEFINE_API_IMPL( database_api_impl, export_proposals )
+{
+  FC_ASSERT( 0 < args.limit && args.limit <= DATABASE_API_EXPORT_QUERY_LIMIT, "limit not set or too big" );
+
+  export_proposals_return result;
+
+  const auto current_time = _db.head_block_time();
+  auto on_push = [&]( const proposal_object& po, const database& db ){ return api_proposal_object( po, current_time ); };
+
+  switch( args.order )
+  {
+    case by_creator:
+      result.next_cursor = export_results< hive::chain::proposal_index, hive::chain::by_creator >( args.cursor, result.proposals, args.limit, on_push );
+      break;
+    case by_start_date:
+      result.next_cursor = export_results< hive::chain::proposal_index, hive::chain::by_start_date >( args.cursor, result.proposals, args.limit, on_push );
+      break;
+    case by_end_date:
+      result.next_cursor = export_results< hive::chain::proposal_index, hive::chain::by_end_date >( args.cursor, result.proposals, args.limit, on_push );
+      break;
+    case by_total_votes:
+      result.next_cursor = export_results< hive::chain::proposal_index, hive::chain::by_total_votes >( args.cursor, result.proposals, args.limit, on_push );
+      break;
+    default:
+      FC_ASSERT( false, "Unknown or unsupported sort order '${o}'", ( "o", args.order ) );
+  }
+
+  return result;
+}
+
 DEFINE_API_IMPL( database_api_impl, find_proposals )
 {
   FC_ASSERT( 0 < args.proposal_ids.size() && args.proposal_ids.size() <= DATABASE_API_SINGLE_QUERY_LIMIT,
@@ -200,13 +200,10 @@ api_change_recovery_account_request_object::api_change_recovery_account_request_
 api_account_object::api_account_object( const account_object& a, const database& db, const metadata::metadata_plugin* metadata_plugin, bool delayed_votes_active ) :
   id( a.get_id() ),
   name( a.get_name() ),
-  memo_key( a.memo_key ),
   proxy( HIVE_PROXY_TO_SELF_ACCOUNT ),
-  last_account_update( a.last_account_update ),
   created( a.get_block_creation_time() ),
   mined( a.was_mined() ),
   reset_account( HIVE_NULL_ACCOUNT ),
-  last_account_recovery( a.get_block_last_account_recovery_time() ),
   post_count( a.post_count ),
   can_vote( a.can_vote ),
   voting_manabar( a.voting_manabar ),
@@ -226,8 +223,6 @@ api_account_object::api_account_object( const account_object& a, const database&
   reward_hive_balance( a.get_hive_rewards().to_asset() ),
   reward_vesting_balance( a.get_vest_rewards().to_asset() ),
   reward_vesting_hive( a.get_vest_rewards_as_hive().to_asset() ),
-  curation_rewards( a.curation_rewards.amount ),
-  posting_rewards( a.posting_rewards.amount ),
   vesting_shares( a.vesting_shares.to_asset() ),
   delegated_vesting_shares( a.delegated_vesting_shares.to_asset() ),
   received_vesting_shares( a.received_vesting_shares.to_asset() ),
@@ -257,6 +252,16 @@ api_account_object::api_account_object( const account_object& a, const database&
   for( size_t i=0; i<n; i++ )
     proxied_vsf_votes.push_back( a.proxied_vsf_votes[i] );
 
+  const auto* details = db.find_account_details( a );
+  if( details != nullptr )
+  {
+    memo_key = details->memo_key;
+    last_account_update = details->last_account_update;
+    last_account_recovery = details->block_last_account_recovery;
+    curation_rewards = details->curation_rewards.amount;
+    posting_rewards = details->posting_rewards.amount;
+  }
+
   const auto& auth = db.get< account_authority_object, by_account >( name );
   owner = authority( auth.owner );
   active = authority( auth.active );
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+
+namespace hive { namespace plugins { namespace database_api {
+
+/**
+  * Cache of constructed API objects, valid as long as state does not change.
+  * Each lookup passes current state generation (see database_api_impl::_state_generation);
+  * when it differs from generation of cached entries, whole content is dropped. Since state
+  * only changes under write lock and API calls read under read lock, all concurrent readers
+  * always pass the same generation.
+  * Cache with max_size of 0 is disabled and just constructs objects.
+  */
+template< typename KeyType, typename ValueType >
+class api_object_cache
+{
+  public:
+    void set_max_size( size_t max_size ) { _max_size = max_size; }
+    bool is_enabled() const { return _max_size > 0; }
+
+    template< typename Constructor >
+    ValueType get( const KeyType& key, uint64_t generation, Constructor&& construct )
+    {
+      if( !is_enabled() )
+        return construct();
+
+      {
+        std::lock_guard< std::mutex > guard( _mutex );
+        if( _generation == generation )
+        {
+          auto itr = _entries.find( key );
+          if( itr != _entries.end() )
+            return itr->second;
+        }
+      }
+
+      ValueType value = construct();
+
+      std::lock_guard< std::mutex > guard( _mutex );
+      if( _generation != generation )
+      {
+        _entries.clear();
+        _generation = generation;
+      }
+      if( _entries.size() < _max_size )
+        _entries.emplace( key, value );
+      return value;
+    }
+
+  private:
+    std::mutex                    _mutex;
+    std::map< KeyType, ValueType > _entries;
+    uint64_t                      _generation = 0;
+    size_t                        _max_size = 0;
+};
+
+} } } // hive::plugins::database_api
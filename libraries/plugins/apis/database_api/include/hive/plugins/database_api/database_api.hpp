@@ -47,6 +47,12 @@ class database_api
       (list_witnesses)
       (find_witnesses)
       (list_witness_votes)
+
+      /**
+      * @brief Export whole witness vote index ordered by specified key in chunks of up to 10000 votes.
+      * Keys of witness votes never change, so chunks follow each other exactly even if blocks are applied in between.
+      */
+      (export_witness_votes)
       (get_active_witnesses)
 
       //////////////
@@ -63,6 +69,14 @@ class database_api
       * @brief Find accounts by primary key (account name)
       */
       (find_accounts)
+
+      /**
+      * @brief Export whole account index ordered by specified key in chunks of up to 10000 accounts.
+      * Each call returns cursor to pass to the next one, so no key needs to be re-seeked between chunks.
+      * Only by_name export is stable between calls - by_proxy and by_next_vesting_withdrawal keys can
+      * change when blocks are applied in between, so such export can skip or repeat accounts.
+      */
+      (export_accounts)
       (list_owner_histories)
       (find_owner_histories)
       (list_account_recovery_requests)
@@ -103,6 +117,13 @@ class database_api
       /////////
 
       (list_proposals)
+
+      /**
+      * @brief Export all proposals (regardless of status) ordered by specified key in chunks of up to 10000 proposals.
+      * Only by_creator and by_start_date export is stable between calls - total votes and end date of proposals
+      * can change when blocks are applied in between, so such export can skip or repeat proposals.
+      */
+      (export_proposals)
       (find_proposals)
       (list_proposal_votes)
 
@@ -150,10 +171,14 @@ class database_api
       (is_known_transaction)
     )
 
+    /// Constructs API object for given account (served from cache when enabled, see api-object-cache-size option)
+    api_account_object get_api_account_object( const account_object& a, bool delayed_votes_active );
+
   private:
 
     friend class database_api_plugin;
     void api_startup();
+    void enable_object_cache( size_t max_size );
 
     std::unique_ptr< database_api_impl > my;
 
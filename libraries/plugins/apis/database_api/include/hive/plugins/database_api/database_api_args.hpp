@@ -9,6 +9,7 @@
 
 #define DATABASE_API_DEFAULT_QUERY_LIMIT 0
 #define DATABASE_API_SINGLE_QUERY_LIMIT 1000
+#define DATABASE_API_EXPORT_QUERY_LIMIT 10000
 
 namespace hive { namespace plugins { namespace database_api {
 
@@ -82,6 +83,13 @@ struct list_object_args_type
   fc::enum_type<int, sort_order_type> order = not_set;
 };
 
+struct export_object_args_type
+{
+  fc::optional< uint64_t >            cursor; ///< next_cursor from previous call, export starts from beginning of index when not set
+  uint32_t                            limit = DATABASE_API_DEFAULT_QUERY_LIMIT;
+  fc::enum_type<int, sort_order_type> order = not_set;
+};
+
 /* get_config */
 
 typedef void_type          get_config_args;
@@ -164,6 +172,15 @@ struct list_witness_votes_return
 };
 
 
+typedef export_object_args_type export_witness_votes_args;
+
+struct export_witness_votes_return
+{
+  vector< api_witness_vote_object > votes;
+  fc::optional< uint64_t >          next_cursor; ///< not set when end of index was reached
+};
+
+
 struct get_active_witnesses_args
 {
   bool include_future = false;
@@ -201,6 +218,22 @@ struct find_accounts_args
 typedef list_accounts_return find_accounts_return;
 
 
+struct export_accounts_args
+{
+  fc::optional< uint64_t >            cursor; ///< next_cursor from previous call, export starts from beginning of index when not set;
+                                              ///< by_proxy/by_next_vesting_withdrawal keys can change between calls (rows skipped/repeated)
+  uint32_t                            limit = DATABASE_API_DEFAULT_QUERY_LIMIT;
+  fc::enum_type<int, sort_order_type> order = not_set;
+  bool                                delayed_votes_active = true;
+};
+
+struct export_accounts_return
+{
+  vector< api_account_object > accounts;
+  fc::optional< uint64_t >     next_cursor; ///< not set when end of index was reached
+};
+
+
 /* Owner Auth History */
 
 struct list_owner_histories_args
@@ -488,6 +521,15 @@ struct find_proposals_args
 typedef list_proposals_return find_proposals_return;
 
 
+typedef export_object_args_type export_proposals_args;
+
+struct export_proposals_return
+{
+  vector< api_proposal_object > proposals;
+  fc::optional< uint64_t >      next_cursor; ///< not set when end of index was reached
+};
+
+
 /* Proposal Votes */
 
 typedef list_proposals_args list_proposal_votes_args;
@@ -672,6 +714,9 @@ FC_REFLECT_ENUM( hive::plugins::database_api::order_direction_type,
 FC_REFLECT( hive::plugins::database_api::list_object_args_type,
   (start)(limit)(order) )
 
+FC_REFLECT( hive::plugins::database_api::export_object_args_type,
+  (cursor)(limit)(order) )
+
 FC_REFLECT( hive::plugins::database_api::list_accounts_args,
   (start)(limit)(order)(delayed_votes_active) )
 
@@ -690,6 +735,9 @@ FC_REFLECT( hive::plugins::database_api::find_witnesses_args,
 FC_REFLECT( hive::plugins::database_api::list_witness_votes_return,
   (votes) )
 
+FC_REFLECT( hive::plugins::database_api::export_witness_votes_return,
+  (votes)(next_cursor) )
+
 FC_REFLECT( hive::plugins::database_api::get_active_witnesses_args,
   (include_future) )
 
@@ -702,6 +750,12 @@ FC_REFLECT( hive::plugins::database_api::list_accounts_return,
 FC_REFLECT( hive::plugins::database_api::find_accounts_args,
   (accounts)(delayed_votes_active) )
 
+FC_REFLECT( hive::plugins::database_api::export_accounts_args,
+  (cursor)(limit)(order)(delayed_votes_active) )
+
+FC_REFLECT( hive::plugins::database_api::export_accounts_return,
+  (accounts)(next_cursor) )
+
 FC_REFLECT( hive::plugins::database_api::list_owner_histories_args,
   (start)(limit) )
 
@@ -801,6 +855,9 @@ FC_REFLECT( hive::plugins::database_api::list_proposals_args,
 FC_REFLECT( hive::plugins::database_api::list_proposals_return,
   (proposals) )
 
+FC_REFLECT( hive::plugins::database_api::export_proposals_return,
+  (proposals)(next_cursor) )
+
 FC_REFLECT( hive::plugins::database_api::find_proposals_args,
   (proposal_ids) )
 
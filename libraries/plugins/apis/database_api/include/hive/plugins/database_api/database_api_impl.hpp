@@ -6,6 +6,7 @@
 
 #include <hive/plugins/database_api/database_api.hpp>
 #include <hive/plugins/database_api/database_api_plugin.hpp>
+#include <hive/plugins/database_api/api_object_cache.hpp>
 
 #include <hive/protocol/get_config.hpp>
 #include <hive/protocol/exceptions.hpp>
@@ -16,13 +17,49 @@
 #include <hive/chain/database.hpp>
 #include <hive/chain/dhf_objects.hpp>
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
 
 namespace hive { namespace plugins { namespace database_api {
 
 using namespace hive::chain;
 using namespace hive::protocol;
 
+/**
+  * Immutable copy of chain singletons taken by the write thread once block is applied.
+  * Published through atomic shared_ptr so API calls can read it without the chainbase lock.
+  * Reflects state of head block, that is, without effects of pending transactions.
+  */
+class head_state_snapshot
+{
+  public:
+    explicit head_state_snapshot( const database& db );
+
+    get_dynamic_global_properties_return get_dynamic_global_properties( const get_dynamic_global_properties_args& ) const { return _dgpo; }
+    get_witness_schedule_return get_witness_schedule( const get_witness_schedule_args& args ) const;
+    get_hardfork_properties_return get_hardfork_properties( const get_hardfork_properties_args& ) const { return _hardfork_properties; }
+    get_reward_funds_return get_reward_funds( const get_reward_funds_args& ) const { return _reward_funds; }
+    get_current_price_feed_return get_current_price_feed( const get_current_price_feed_args& ) const { return _current_price_feed; }
+    get_feed_history_return get_feed_history( const get_feed_history_args& ) const { return _feed_history; }
+
+  private:
+    api_dynamic_global_property_object             _dgpo;
+    api_witness_schedule_object                    _witness_schedule;
+    fc::optional< api_witness_schedule_object >    _full_witness_schedule; // with future witnesses, only after HF26
+    api_hardfork_property_object                   _hardfork_properties;
+    get_reward_funds_return                        _reward_funds;
+    price                                          _current_price_feed;
+    api_feed_history_object                        _feed_history;
+};
+
 class database_api_impl
 {
   public:
@@ -42,9 +79,11 @@ class database_api_impl
       (list_witnesses)
       (find_witnesses)
       (list_witness_votes)
+      (export_witness_votes)
       (get_active_witnesses)
       (list_accounts)
       (find_accounts)
+      (export_accounts)
       (list_owner_histories)
       (find_owner_histories)
       (list_account_recovery_requests)
@@ -72,6 +111,7 @@ class database_api_impl
       (find_limit_orders)
       (get_order_book)
       (list_proposals)
+      (export_proposals)
       (find_proposals)
       (list_proposal_votes)
       (find_recurrent_transfers)
@@ -170,9 +210,139 @@ class database_api_impl
       }
     }
 
+    /// threads shared by all calls to run_in_parallel, so their number is limited regardless of API load
+    static boost::asio::thread_pool& get_worker_pool();
+    static size_t get_worker_pool_size();
+
+    /**
+      * Calls f( i ) for i in [0, count). Large ranges are split into contiguous parts processed by
+      * the calling thread and threads of shared worker pool (when all of them are busy with other calls,
+      * parts just wait in the pool queue). Caller is responsible for holding the lock for the whole time.
+      */
+    template< typename Lambda >
+    static void run_in_parallel( size_t count, Lambda&& f )
+    {
+      const size_t min_part_size = 64;
+      const size_t num_parts = std::min< size_t >( get_worker_pool_size() + 1, ( count + min_part_size - 1 ) / min_part_size );
+      if( num_parts <= 1 )
+      {
+        for( size_t i = 0; i < count; ++i )
+          f( i );
+        return;
+      }
+
+      std::vector< std::exception_ptr > errors( num_parts );
+      const size_t part_size = ( count + num_parts - 1 ) / num_parts;
+      auto run_part = [&]( size_t part )
+      {
+        try
+        {
+          const size_t end = std::min( ( part + 1 ) * part_size, count );
+          for( size_t i = part * part_size; i < end; ++i )
+            f( i );
+        }
+        catch( ... )
+        {
+          errors[ part ] = std::current_exception();
+        }
+      };
+
+      // set before anything is posted - workers decrement it as soon as they are done
+      const size_t used_parts = ( count + part_size - 1 ) / part_size;
+      std::mutex mutex;
+      std::condition_variable all_done;
+      size_t pending_parts = used_parts - 1;
+      for( size_t part = 1; part < used_parts; ++part )
+      {
+        boost::asio::post( get_worker_pool(), [&, part]()
+        {
+          run_part( part );
+          std::lock_guard< std::mutex > guard( mutex );
+          if( --pending_parts == 0 )
+            all_done.notify_one(); // under lock, so the caller can't destroy all_done before we are done with it
+        } );
+      }
+      run_part( 0 );
+      {
+        std::unique_lock< std::mutex > lock( mutex );
+        all_done.wait( lock, [&](){ return pending_parts == 0; } );
+      }
+
+      for( auto& e : errors )
+        if( e )
+          std::rethrow_exception( e );
+    }
+
+    /**
+      * Fills result with up to limit objects following given order, starting at object with id pointed by cursor
+      * (or from the start of index). Objects are only collected during index walk, construction of result
+      * objects (the expensive part) is done in parallel on contiguous ranges.
+      * Returns id of the object that should start next chunk (not set if there are no more objects).
+      * Cursor only remembers the object, not its key, so when key of that or other objects changes
+      * between calls (mutable orders), next chunk starts at new position of the object in the index.
+      */
+    template< typename IndexType, typename OrderType, typename ResultType, typename OnPushType >
+    fc::optional< uint64_t > export_results(
+      const fc::optional< uint64_t >& cursor,
+      std::vector< ResultType >& result,
+      uint32_t limit,
+      OnPushType&& on_push )
+    {
+      typedef typename IndexType::value_type object_type;
+
+      const auto& idx = _db.get_index< IndexType, OrderType >();
+      auto itr = idx.begin();
+      if( cursor.valid() )
+      {
+        typename object_type::id_type id( *cursor );
+        const auto& id_idx = _db.get_index< IndexType, hive::chain::by_id >();
+        auto id_itr = id_idx.find( id );
+        FC_ASSERT( id_itr != id_idx.end(), "Object pointed to by cursor ${c} no longer exists", ( "c", *cursor ) );
+        itr = idx.iterator_to( *id_itr );
+      }
+
+      std::vector< const object_type* > objects;
+      objects.reserve( limit );
+      for( ; itr != idx.end() && objects.size() < limit; ++itr )
+        objects.push_back( &( *itr ) );
+
+      fc::optional< uint64_t > next_cursor;
+      if( itr != idx.end() )
+        next_cursor = itr->get_id().get_value();
+
+      result.resize( objects.size() );
+      run_in_parallel( objects.size(), [&]( size_t i ){ result[i] = on_push( *objects[i], _db ); } );
+      return next_cursor;
+    }
+
     chain::database& _db;
     appbase::application& _app;
 
+    /// turns on caching of constructed API objects (see api_object_cache)
+    void enable_object_cache( size_t max_size );
+    api_account_object get_api_account_object( const account_object& a, bool delayed_votes_active );
+
+    // changes every time state might have changed (new block or transaction applied, failed block undone, debug edit)
+    std::atomic< uint64_t > _state_generation = { 1 };
+    api_object_cache< std::pair< account_name_type, bool >, api_account_object > _account_cache;
+    api_object_cache< uint32_t, api_dynamic_global_property_object > _dgpo_cache;
+    chain::database::signal_connection_ptr _post_apply_block_conn;
+    chain::database::signal_connection_ptr _post_apply_transaction_conn;
+    chain::database::signal_connection_ptr _fail_apply_block_conn;
+    chain::database::signal_connection_ptr _debug_state_change_conn;
+
+    /// starts publishing head_state_snapshot after each applied block
+    void start_head_state_publication();
+    /// last published snapshot or nullptr when there is none (before first block, during replay, after fork switch)
+    std::shared_ptr< const head_state_snapshot > get_head_state() const { return std::atomic_load( &_head_state ); }
+    void publish_head_state( std::shared_ptr< const head_state_snapshot > head_state ) { std::atomic_store( &_head_state, std::move( head_state ) ); }
+
+    std::shared_ptr< const head_state_snapshot > _head_state;
+    chain::database::signal_connection_ptr _head_state_post_apply_block_conn;
+    chain::database::signal_connection_ptr _head_state_fail_apply_block_conn;
+    chain::database::signal_connection_ptr _head_state_switch_fork_conn;
+    chain::database::signal_connection_ptr _head_state_debug_state_change_conn;
+
     const metadata::metadata_plugin* _metadata_plugin = nullptr;
 
     void initialize_metadata_plugin();
@@ -80,6 +80,7 @@ struct api_reward_fund_object
 
 struct api_witness_vote_object
 {
+  api_witness_vote_object() = default;
   api_witness_vote_object( const witness_vote_object& o, const database& db );
 
   witness_vote_id_type id;
@@ -27,11 +27,23 @@ class database_api_plugin : public plugin< database_api_plugin >
 
     virtual void set_program_options(
       options_description& cli,
-      options_description& cfg ) override {}
+      options_description& cfg ) override
+    {
+      cfg.add_options()
+        ( "api-object-cache-size", bpo::value< uint32_t >()->default_value( 0 ),
+          "Maximum number of constructed account API objects cached until state changes (next block or transaction). 0 disables the cache." );
+    }
 
     virtual void plugin_initialize( const variables_map& options ) override
     {
       api = std::make_shared< database_api >( get_app() );
+
+      uint32_t cache_size = options.at( "api-object-cache-size" ).as< uint32_t >();
+      if( cache_size > 0 )
+      {
+        ilog( "API object cache enabled for up to ${cache_size} objects", (cache_size) );
+        api->enable_object_cache( cache_size );
+      }
     }
 
     virtual void plugin_startup() override
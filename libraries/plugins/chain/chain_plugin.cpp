@@ -3,6 +3,7 @@
 #include <appbase/application.hpp>
 
 #include <hive/chain/blockchain_worker_thread_pool.hpp>
+#include <hive/chain/block_compression_dictionaries.hpp>
 #include <hive/chain/block_storage_interface.hpp>
 #include <hive/chain/notifications.hpp>
 #include <hive/chain/rc/rc_utility.hpp>
@@ -155,10 +156,12 @@ class chain_plugin_impl
     bool                             validate_during_replay = false;
     uint32_t                         benchmark_interval = 0;
     uint32_t                         flush_interval = 0;
+    uint32_t                         replay_checkpoint_interval = 0;
     bool                             replay_in_memory = false;
     std::vector< std::string >       replay_memory_indices{};
     bool                             enable_block_log_compression = true;
     bool                             enable_block_log_auto_fixing = true;
+    bool                             enable_block_log_mmap_reads = false;
     bool                             load_snapshot = false;
     bool                             dump_snapshot = false;
     int                              block_log_compression_level = 15;
@@ -867,6 +870,7 @@ void chain_plugin_impl::initial_settings()
   bl_open_args.data_dir = db_open_args.data_dir;
   bl_open_args.enable_block_log_compression = enable_block_log_compression;
   bl_open_args.enable_block_log_auto_fixing = enable_block_log_auto_fixing;
+  bl_open_args.enable_block_log_mmap_reads = enable_block_log_mmap_reads;
   bl_open_args.block_log_compression_level = block_log_compression_level;
   bl_open_args.load_snapshot = load_snapshot;
   bl_open_args.replay = replay;
@@ -1273,6 +1277,15 @@ uint32_t chain_plugin_impl::reindex_internal( const open_args& args,
     db.apply_block(full_block, skip_flags);
     last_applied_block = full_block;
 
+    if( replay_checkpoint_interval > 0 && snapshot_provider != nullptr &&
+        current_block_num % replay_checkpoint_interval == 0 && current_block_num < last_block_num &&
+        !theApp.is_interrupt_request() )
+    {
+      // LIB data is normally set once at the end of replay, but snapshot stores it, so it has to be current
+      db.set_last_irreversible_block_data( full_block );
+      snapshot_provider->dump_replay_checkpoint();
+    }
+
     return !theApp.is_interrupt_request();
   };
 
@@ -1341,6 +1354,11 @@ bool chain_plugin_impl::replay_blockchain( const block_read_i& block_reader, hiv
       ilog("Stopped blockchain replaying on user request. Last applied block number: ${n}.", ("n", last_block_number));
     }
 
+    // replay stopped early (by signal or at requested block) can still be resumed from checkpoints
+    if( replay_checkpoint_interval > 0 && snapshot_provider != nullptr && !theApp.is_interrupt_request() &&
+        ( stop_replay_at == 0 || stop_replay_at > last_block_number ) )
+      snapshot_provider->remove_replay_checkpoints();
+
     /*
       Returns information if the replay is last operation.
     */
@@ -1496,9 +1514,13 @@ void chain_plugin::set_program_options(options_description& cli, options_descrip
       ("checkpoint,c", bpo::value<vector<string>>()->composing(), "Pairs of [BLOCK_NUM,BLOCK_ID] that should be enforced as checkpoints.")
       ("flush-state-interval", bpo::value<uint32_t>(),
         "flush shared memory changes to disk every N blocks")
+      ("replay-checkpoint-interval", bpo::value<uint32_t>()->default_value(0),
+        "Dump state snapshot (requires state_snapshot plugin) every N blocks during replay. Interrupted replay is then resumed from the last usable such checkpoint, even with --force-replay. Checkpoints are removed once replay reaches the end of block log. 0 disables checkpoints." )
       ("enable-block-log-compression", boost::program_options::value<bool>()->default_value(true), "Compress blocks using zstd as they're added to the block log" )
       ("enable-block-log-auto-fixing", boost::program_options::value<bool>()->default_value(true), "If enabled, corrupted block_log will try to fix itself automatically." )
+      ("enable-block-log-mmap-reads", boost::program_options::value<bool>()->default_value(false), "If enabled, blocks are read from memory mapped block_log without copying (helps API nodes serving many get_block requests)." )
       ("block-log-compression-level", bpo::value<int>()->default_value(15), "Block log zstd compression level 0 (fast, low compression) - 22 (slow, high compression)" )
+      ("block-log-compression-dictionaries", bpo::value<bfs::path>()->value_name("file"), "File with custom zstd dictionaries trained by compress_block_log --train-dictionaries (absolute path or relative to application data dir). Required to read block log compressed with such dictionaries." )
       ("blockchain-thread-pool-size", bpo::value<uint32_t>()->default_value(8)->value_name("size"), "Number of worker threads used to pre-validate transactions and blocks")
       ("block-stats-report-type", bpo::value<string>()->default_value("FULL"), "Level of detail of block stat reports: NONE, MINIMAL, REGULAR, FULL. Default FULL (recommended for API nodes)." )
       ("block-stats-report-output", bpo::value<string>()->default_value("ILOG"), "Where to put block stat reports: DLOG, ILOG, NOTIFY, LOG_NOTIFY. Default ILOG." )
@@ -1565,6 +1587,14 @@ void chain_plugin::plugin_initialize(const variables_map& options)
       my->shared_memory_dir = sfd;
   }
 
+  if( options.count( "block-log-compression-dictionaries" ) )
+  {
+    auto dictionaries_file = options.at( "block-log-compression-dictionaries" ).as<bfs::path>();
+    if( dictionaries_file.is_relative() )
+      dictionaries_file = get_app().data_dir() / dictionaries_file;
+    hive::chain::load_custom_zstd_compression_dictionaries( dictionaries_file );
+  }
+
   my->comments_storage_path = my->shared_memory_dir / "comments-rocksdb-storage";
 
   if( options.count( "comments-rocksdb-path" ) )
@@ -1611,6 +1641,7 @@ void chain_plugin::plugin_initialize(const variables_map& options)
   my->dump_memory_details = options.at( "dump-memory-details" ).as<bool>();
   my->enable_block_log_compression = options.at( "enable-block-log-compression" ).as<bool>();
   my->enable_block_log_auto_fixing = options.at( "enable-block-log-auto-fixing" ).as<bool>();
+  my->enable_block_log_mmap_reads = options.at( "enable-block-log-mmap-reads" ).as<bool>();
   my->block_log_compression_level = options.at( "block-log-compression-level" ).as<int>();
   my->force_live_sync = options.at( "force-live-sync" ).as<bool>();
 
@@ -1636,6 +1667,8 @@ void chain_plugin::plugin_initialize(const variables_map& options)
   else
     my->flush_interval = 10000;
 
+  my->replay_checkpoint_interval = options.at( "replay-checkpoint-interval" ).as<uint32_t>();
+
   if( options.count( "checkpoint" ) )
   {
     auto cps = options.at( "checkpoint" ).as<vector<string>>();
@@ -1888,6 +1921,21 @@ void chain_plugin::plugin_startup()
       ( "block_num", my->checkpoints.rbegin()->first )( "block_id", my->checkpoints.rbegin()->second ) );
   }
 
+  if( my->replay && my->replay_checkpoint_interval > 0 )
+  {
+    if( my->snapshot_provider == nullptr )
+      wlog( "Option `replay-checkpoint-interval` requires state_snapshot plugin to be enabled - replay checkpoints are disabled." );
+    else
+    {
+      uint32_t checkpoint_block_num = my->snapshot_provider->load_latest_replay_checkpoint( my->db_open_args );
+      if( checkpoint_block_num > 0 )
+      {
+        ilog( "Replay checkpoint at block ${b} loaded, replay continues from there.", ( "b", checkpoint_block_num ) );
+        my->db_open_args.force_replay = false;
+      }
+    }
+  }
+
   if( my->replay || force_replay_after_snapshot_loading )
   {
     std::shared_ptr< block_write_i > reindex_block_writer =
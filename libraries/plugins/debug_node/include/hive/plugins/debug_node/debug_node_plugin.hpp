@@ -82,10 +82,12 @@ class debug_node_plugin : public plugin< debug_node_plugin >
             "Pending tx session should have been opened when related internal transaction was created" );
           callback( database() );
           _pending_tx_session->second.squash( true );
+          database().notify_debug_state_change();
         }
         catch( ... )
         {
           _pending_tx_session->second.undo( true );
+          database().notify_debug_state_change();
           // remove faulty callback from list for transaction
           _debug_updates.at( dummy_tx_id ).callbacks.pop_back();
           throw;
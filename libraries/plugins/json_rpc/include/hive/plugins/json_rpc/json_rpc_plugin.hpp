@@ -3,7 +3,10 @@
 #include <appbase/application.hpp>
 
 #include <fc/variant.hpp>
+#include <fc/variant_object.hpp>
 #include <fc/io/json.hpp>
+#include <fc/io/raw.hpp>
+#include <fc/io/raw_variant.hpp>
 #include <fc/reflect/variant.hpp>
 #include <fc/exception/exception.hpp>
 
@@ -33,6 +36,12 @@
   *
   * For methods that do not require arguments, use api_void_args
   * as the argument type.
+  *
+  * An API can additionally expose its methods in binary form with
+  * JSON_RPC_REGISTER_BINARY_API. Such methods take the fc::raw packed
+  * *_args struct and return the fc::raw packed *_return struct, skipping
+  * JSON parsing and variant conversion completely. They are meant for
+  * co-located consumers (see unix socket endpoint of webserver plugin).
   */
 
 #define HIVE_JSON_RPC_PLUGIN_NAME "json_rpc"
@@ -51,6 +60,14 @@
   for_each_api( vtor );                                                                         \
 }
 
+// Registers binary (fc::raw based) versions of all methods of the API. Must be used next to
+// JSON_RPC_REGISTER_API, only for APIs whose args and return types are fully packable
+#define JSON_RPC_REGISTER_BINARY_API( API_NAME )                                                \
+{                                                                                               \
+  hive::plugins::json_rpc::detail::register_binary_api_method_visitor vtor( API_NAME, app );    \
+  for_each_api( vtor );                                                                         \
+}
+
 #define JSON_RPC_PARSE_ERROR        (-32700)
 #define JSON_RPC_INVALID_REQUEST    (-32600)
 #define JSON_RPC_METHOD_NOT_FOUND   (-32601)
@@ -73,6 +90,30 @@ using namespace appbase;
   */
 typedef std::function< fc::variant(const fc::variant&) > api_method;
 
+/**
+  * @brief Internal type used to bind binary versions of api methods
+  * to names.
+  *
+  * Arguments: fc::raw packed args struct, returns fc::raw packed return struct
+  */
+typedef std::function< std::vector< char >(const std::vector< char >&) > binary_api_method;
+
+/**
+  * @brief Delivers a notification (complete JSON message) to a subscriber.
+  *
+  * Returns false when the notification could not be delivered, i.e. the subscriber
+  * disconnected or was disconnected for not keeping up. Such subscription should be dropped.
+  */
+typedef std::function< bool(const string&) > subscription_sink;
+
+/**
+  * @brief Internal type used to bind subscription methods to names.
+  *
+  * Subscription methods are only callable over connections that can push notifications
+  * (websocket). Arguments: variant object of proper arg type and sink for notifications
+  */
+typedef std::function< fc::variant(const fc::variant&, const subscription_sink&) > subscription_method;
+
 /**
   * @brief An API, containing APIs and Methods
   *
@@ -112,7 +153,13 @@ class json_rpc_plugin : public appbase::plugin< json_rpc_plugin >
 
     void add_api_method( const string& api_name, const string& method_name, const api_method& api, const api_method_signature& sig );
     void add_early_api_method( const string& api_name, const string& method_name, const api_method& api, const api_method_signature& sig );
+    void add_binary_api_method( const string& api_name, const string& method_name, const binary_api_method& api );
+    void add_subscription_method( const string& api_name, const string& method_name, const subscription_method& api, const api_method_signature& sig );
     string call( const string& body );
+    /// same as above, but also allows calls to subscription methods, that will push notifications to given sink
+    string call( const string& body, const subscription_sink& sink );
+    /// method is in "api.method" form, body contains packed args; throws on unknown method or unpack failure
+    std::vector< char > call_binary( const string& method, const std::vector< char >& body );
 
     void add_serialization_status( const std::function<bool()>& serialization_status );
 
@@ -154,6 +201,48 @@ namespace detail {
 
   using register_api_method_visitor = register_api_method_visitor_template<&json_rpc_plugin::add_api_method>;
   using register_early_api_method_visitor = register_api_method_visitor_template<&json_rpc_plugin::add_early_api_method>;
+
+  template< typename Ret >
+  inline std::vector< char > pack_binary_result( const Ret& ret )
+  {
+    return fc::raw::pack_to_vector( ret );
+  }
+
+  // mutable_variant_object has no binary form of its own
+  inline std::vector< char > pack_binary_result( const fc::mutable_variant_object& ret )
+  {
+    return fc::raw::pack_to_vector( fc::variant_object( ret ) );
+  }
+
+  class register_binary_api_method_visitor
+  {
+    public:
+      register_binary_api_method_visitor( const std::string& api_name, appbase::application& app )
+        : _api_name( api_name ),
+          _json_rpc_plugin( app.get_plugin< hive::plugins::json_rpc::json_rpc_plugin >() )
+      {}
+
+      template< typename Plugin, typename Method, typename Args, typename Ret >
+      void operator()(
+        Plugin& plugin,
+        const std::string& method_name,
+        Method method,
+        Args* args,
+        Ret* ret )
+      {
+        _json_rpc_plugin.add_binary_api_method( _api_name, method_name,
+          [&plugin,method]( const std::vector< char >& packed_args ) -> std::vector< char >
+          {
+            Args _args;
+            fc::raw::unpack_from_vector( packed_args, _args );
+            return pack_binary_result( (plugin.*method)( _args, /* lock= */ true ) );
+          } );
+      }
+
+    private:
+      std::string _api_name;
+      hive::plugins::json_rpc::json_rpc_plugin& _json_rpc_plugin;
+  };
 }
 
 } } } // hive::plugins::json_rpc
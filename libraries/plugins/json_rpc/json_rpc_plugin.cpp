@@ -230,6 +230,8 @@ namespace detail
       map< string, api_description >                     _registered_apis;
       vector< string >                                   _methods;
       map< string, map< string, api_method_signature > > _method_sigs;
+      map< string, binary_api_method >                   _binary_methods; // keyed by canonical "api.method" name
+      map< string, subscription_method >                 _subscription_methods; // keyed by canonical "api.method" name
     } data, proxy_data;
 
     detail::rpc_obfuscator obfuscator;
@@ -240,14 +242,18 @@ namespace detail
 
       void add_api_method( const string& api_name, const string& method_name, const api_method& api, const api_method_signature& sig );
       void add_early_api_method( const string& api_name, const string& method_name, const api_method& api, const api_method_signature& sig );
+      void add_binary_api_method( const string& api_name, const string& method_name, const binary_api_method& api );
+      void add_subscription_method( const string& api_name, const string& method_name, const subscription_method& api, const api_method_signature& sig );
       void plugin_finalize_startup();
       void plugin_pre_shutdown();
 
       api_method* find_api_method( const std::string& api, const std::string& method );
+      binary_api_method* find_binary_api_method( const std::string& method );
+      subscription_method* find_subscription_method( const std::string& method );
       api_method* process_params( string method, const fc::variant_object& request, fc::variant& func_args, string* method_name );
       void rpc_id( const fc::variant_object& request, json_rpc_response& response );
-      bool rpc_jsonrpc( const fc::variant_object& request, json_rpc_response& response );
-      json_rpc_response rpc( const fc::variant& message );
+      bool rpc_jsonrpc( const fc::variant_object& request, json_rpc_response& response, const subscription_sink& sink );
+      json_rpc_response rpc( const fc::variant& message, const subscription_sink& sink );
 
       void initialize();
 
@@ -293,6 +299,24 @@ namespace detail
     add_api_method(api_name, method_name, api, sig);
   }
 
+  void json_rpc_plugin_impl::add_binary_api_method( const string& api_name, const string& method_name, const binary_api_method& api )
+  {
+    proxy_data._binary_methods[ api_name + '.' + method_name ] = api;
+  }
+
+  void json_rpc_plugin_impl::add_subscription_method( const string& api_name, const string& method_name, const subscription_method& api, const api_method_signature& sig )
+  {
+    // regular entry makes the method visible in get_methods/get_signature, but calling it without
+    // a way to push notifications is an error
+    add_api_method( api_name, method_name,
+      [api_name, method_name]( const fc::variant& ) -> fc::variant
+      {
+        FC_THROW_EXCEPTION( fc::assert_exception, "Method ${api}.${method} is a subscription, it is only available over websocket",
+          ("api", api_name)("method", method_name) );
+      }, sig );
+    proxy_data._subscription_methods[ api_name + '.' + method_name ] = api;
+  }
+
   void json_rpc_plugin_impl::plugin_finalize_startup()
   {
     std::sort( proxy_data._methods.begin(), proxy_data._methods.end() );
@@ -300,6 +324,8 @@ namespace detail
     data._registered_apis = std::move( proxy_data._registered_apis );
     data._methods         = std::move( proxy_data._methods );
     data._method_sigs     = std::move( proxy_data._method_sigs );
+    data._binary_methods  = std::move( proxy_data._binary_methods );
+    data._subscription_methods = std::move( proxy_data._subscription_methods );
   }
 
   void json_rpc_plugin_impl::plugin_pre_shutdown()
@@ -307,6 +333,8 @@ namespace detail
     data._registered_apis.clear();
     data._methods.clear();
     data._method_sigs.clear();
+    data._binary_methods.clear();
+    data._subscription_methods.clear();
   }
 
   void json_rpc_plugin_impl::initialize()
@@ -350,6 +378,21 @@ namespace detail
     return &(method_itr->second);
   }
 
+  binary_api_method* json_rpc_plugin_impl::find_binary_api_method( const std::string& method )
+  {
+    STATSD_START_TIMER( "jsonrpc", "overhead", "find_binary_api_method", 1.0f, theApp );
+    auto method_itr = data._binary_methods.find( method );
+    FC_ASSERT( method_itr != data._binary_methods.end(), "Could not find binary method ${method}", ("method", method) );
+
+    return &(method_itr->second);
+  }
+
+  subscription_method* json_rpc_plugin_impl::find_subscription_method( const std::string& method )
+  {
+    auto method_itr = data._subscription_methods.find( method );
+    return method_itr != data._subscription_methods.end() ? &(method_itr->second) : nullptr;
+  }
+
   api_method* json_rpc_plugin_impl::process_params( string method, const fc::variant_object& request, fc::variant& func_args, string* method_name )
   {
     STATSD_START_TIMER( "jsonrpc", "overhead", "process_params", 1.0f, theApp );
@@ -413,7 +456,7 @@ namespace detail
     }
   }
 
-  bool json_rpc_plugin_impl::rpc_jsonrpc( const fc::variant_object& request, json_rpc_response& response )
+  bool json_rpc_plugin_impl::rpc_jsonrpc( const fc::variant_object& request, json_rpc_response& response, const subscription_sink& sink )
   {
     bool _result = false;
 
@@ -449,10 +492,15 @@ namespace detail
               {
                 STATSD_START_TIMER( "jsonrpc", "api", method_name, 1.0f, theApp );
 
+                subscription_method* subscribe = sink ? find_subscription_method( method_name ) : nullptr;
+
                 bool _change_of_serialization_is_allowed = false;
                 try
                 {
-                  response.result = (*call)( func_args );
+                  if( subscribe )
+                    response.result = (*subscribe)( func_args, sink );
+                  else
+                    response.result = (*call)( func_args );
                 }
                 catch( fc::bad_cast_exception& e )
                 {
@@ -523,7 +571,7 @@ namespace detail
   return _result;
   }
 
-  json_rpc_response json_rpc_plugin_impl::rpc( const fc::variant& message )
+  json_rpc_response json_rpc_plugin_impl::rpc( const fc::variant& message, const subscription_sink& sink )
   {
     json_rpc_response response;
 
@@ -547,7 +595,7 @@ namespace detail
       try
       {
         if( !response.error.valid() )
-          _logged = rpc_jsonrpc( request, response );
+          _logged = rpc_jsonrpc( request, response, sink );
       }
       catch( fc::exception& e )
       {
@@ -644,7 +692,30 @@ void json_rpc_plugin::add_early_api_method( const string& api_name, const string
   my->add_early_api_method( api_name, method_name, api, sig );
 }
 
+void json_rpc_plugin::add_binary_api_method( const string& api_name, const string& method_name, const binary_api_method& api )
+{
+  my->add_binary_api_method( api_name, method_name, api );
+}
+
+void json_rpc_plugin::add_subscription_method( const string& api_name, const string& method_name, const subscription_method& api, const api_method_signature& sig )
+{
+  my->add_subscription_method( api_name, method_name, api, sig );
+}
+
+std::vector< char > json_rpc_plugin::call_binary( const string& method, const std::vector< char >& body )
+{
+  binary_api_method* call = my->find_binary_api_method( method );
+
+  STATSD_START_TIMER( "jsonrpc", "api", method, 1.0f, get_app() );
+  return (*call)( body );
+}
+
 string json_rpc_plugin::call( const string& message )
+{
+  return call( message, subscription_sink() );
+}
+
+string json_rpc_plugin::call( const string& message, const subscription_sink& sink )
 {
   STATSD_START_TIMER( "jsonrpc", "overhead", "call", 1.0f, get_app() );
   try
@@ -661,7 +732,7 @@ string json_rpc_plugin::call( const string& message )
         responses.reserve( messages.size() );
 
         for( auto& m : messages )
-          responses.push_back( my->rpc( m ) );
+          responses.push_back( my->rpc( m, sink ) );
 
         return fc::json::to_string( responses );
       }
@@ -675,7 +746,7 @@ string json_rpc_plugin::call( const string& message )
     }
     else
     {
-      return fc::json::to_string( my->rpc( v ) );
+      return fc::json::to_string( my->rpc( v, sink ) );
     }
   }
   catch( fc::exception& e )
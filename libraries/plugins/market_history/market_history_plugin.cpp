@@ -41,7 +41,7 @@ class market_history_plugin_impl
     flat_set<uint32_t>            _tracked_buckets = flat_set<uint32_t>  { 15, 60, 300, 3600, 86400 };
     int32_t                       _maximum_history_per_bucket_size = 86400 / 15; // smallest buckets should
       // cover at least 24 hours, otherwise get_ticker/get_volume api calls won't work properly
-    chain::database::signal_connection_ptr   _post_apply_operation_conn;
+    std::vector< chain::database::signal_connection_ptr > _post_apply_operation_conns;
 };
 
 void market_history_plugin_impl::on_post_apply_operation( const operation_notification& o )
@@ -173,7 +173,7 @@ void market_history_plugin::plugin_initialize( const boost::program_options::var
     ilog( "market_history: plugin_initialize() begin" );
     my = std::make_unique< detail::market_history_plugin_impl >( get_app() );
 
-    my->_post_apply_operation_conn = my->_db.add_post_apply_operation_handler( [&]( const operation_notification& note ){ my->on_post_apply_operation( note ); }, *this, 0 );
+    my->_post_apply_operation_conns = my->_db.add_post_apply_operation_handler_for< fill_order_operation >( [&]( const operation_notification& note ){ my->on_post_apply_operation( note ); }, *this, 0 );
     HIVE_ADD_PLUGIN_INDEX(my->_db, bucket_index);
     HIVE_ADD_PLUGIN_INDEX(my->_db, order_history_index);
 
@@ -202,7 +202,7 @@ void market_history_plugin::plugin_startup() {}
 
 void market_history_plugin::plugin_shutdown()
 {
-  hive::utilities::disconnect_signal( my->_post_apply_operation_conn );
+  hive::utilities::disconnect_signal( my->_post_apply_operation_conns );
 }
 
 const flat_set< uint32_t >& market_history_plugin::get_tracked_buckets() const
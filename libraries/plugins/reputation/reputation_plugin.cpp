@@ -42,8 +42,8 @@ class reputation_plugin_impl
 
     chain::database&              _db;
     reputation_plugin&            _self;
-    chain::database::signal_connection_ptr   _pre_apply_operation_conn;
-    chain::database::signal_connection_ptr   _post_apply_operation_conn;
+    std::vector< chain::database::signal_connection_ptr > _pre_apply_operation_conns;
+    std::vector< chain::database::signal_connection_ptr > _post_apply_operation_conns;
 };
 
 struct pre_operation_visitor
@@ -208,8 +208,8 @@ void reputation_plugin::plugin_initialize( const boost::program_options::variabl
 
     my = std::make_unique< detail::reputation_plugin_impl >( *this, get_app() );
 
-    my->_pre_apply_operation_conn = my->_db.add_pre_apply_operation_handler( [&]( const operation_notification& note ){ my->pre_operation( note ); }, *this, 0 );
-    my->_post_apply_operation_conn = my->_db.add_post_apply_operation_handler( [&]( const operation_notification& note ){ my->post_operation( note ); }, *this, 0 );
+    my->_pre_apply_operation_conns = my->_db.add_pre_apply_operation_handler_for< vote_operation >( [&]( const operation_notification& note ){ my->pre_operation( note ); }, *this, 0 );
+    my->_post_apply_operation_conns = my->_db.add_post_apply_operation_handler_for< vote_operation >( [&]( const operation_notification& note ){ my->post_operation( note ); }, *this, 0 );
     HIVE_ADD_PLUGIN_INDEX(my->_db, reputation_index);
 
     get_app().get_plugin< chain::chain_plugin >().report_state_options( name(), fc::variant_object() );
@@ -221,8 +221,8 @@ void reputation_plugin::plugin_startup() {}
 
 void reputation_plugin::plugin_shutdown()
 {
-  hive::utilities::disconnect_signal( my->_pre_apply_operation_conn );
-  hive::utilities::disconnect_signal( my->_post_apply_operation_conn );
+  hive::utilities::disconnect_signal( my->_pre_apply_operation_conns );
+  hive::utilities::disconnect_signal( my->_post_apply_operation_conns );
 }
 
 } } } // hive::plugins::reputation
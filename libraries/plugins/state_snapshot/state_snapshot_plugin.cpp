@@ -40,10 +40,12 @@
 #include <boost/bind/bind.hpp>
 #include <boost/type.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/asio.hpp>
 
 #include <limits>
+#include <map>
 #include <string>
 #include <typeindex>
 #include <typeinfo>
@@ -883,13 +885,16 @@ class state_snapshot_plugin::impl final : protected chain::state_snapshot_provid
         }, _self, 0);
       }
 
-    void prepare_snapshot(const std::string& snapshotName);
+    bool prepare_snapshot(const std::string& snapshotName);
     void load_snapshot(const std::string& snapshotName, const hive::chain::open_args& openArgs);
 
   protected:
     /// chain::state_snapshot_provider implementation:
     virtual void process_explicit_snapshot_dump_requests(const hive::chain::open_args& openArgs) override;
     virtual void process_explicit_snapshot_load_requests(const hive::chain::open_args& openArgs) override;
+    virtual void dump_replay_checkpoint() override;
+    virtual uint32_t load_latest_replay_checkpoint(const hive::chain::open_args& openArgs) override;
+    virtual void remove_replay_checkpoints() override;
 
     private:
       void collectOptions(const bpo::variables_map& options);
@@ -905,6 +910,9 @@ class state_snapshot_plugin::impl final : protected chain::state_snapshot_provid
 
       void load_snapshot_impl(const std::string& snapshotName, const hive::chain::open_args& openArgs);
 
+      /// Returns complete replay checkpoints (block number -> directory name), removes leftovers of unfinished ones.
+      std::map<uint32_t, std::string> collect_replay_checkpoints() const;
+
     private:
       state_snapshot_plugin&  _self;
       database&               _mainDb;
@@ -917,6 +925,8 @@ class state_snapshot_plugin::impl final : protected chain::state_snapshot_provid
       bool                    _do_immediate_dump = false;
       std::exception_ptr      _exception;
       std::atomic_bool        _is_error{false};
+      /// set when snapshot load wiped the state (so failed load leaves it unusable)
+      bool                    _state_replaced = false;
   };
 
 void state_snapshot_plugin::impl::collectOptions(const bpo::variables_map& options)
@@ -1465,7 +1475,7 @@ void state_snapshot_plugin::impl::safe_spawn_snapshot_load(chainbase::abstract_i
   }
   }
 
-void state_snapshot_plugin::impl::prepare_snapshot(const std::string& snapshotName)
+bool state_snapshot_plugin::impl::prepare_snapshot(const std::string& snapshotName)
   {
   try
   {
@@ -1551,11 +1561,12 @@ void state_snapshot_plugin::impl::prepare_snapshot(const std::string& snapshotNa
     ("sf", measure.shm_free));
 
   ilog("Snapshot generation finished");
-  return;
+  return true;
   }
   FC_CAPTURE_AND_LOG(());
 
   elog("Snapshot generation FAILED.");
+  return false;
   }
 
 void state_snapshot_plugin::impl::load_snapshot_impl(const std::string& snapshotName, const hive::chain::open_args& openArgs)
@@ -1602,6 +1613,7 @@ void state_snapshot_plugin::impl::load_snapshot_impl(const std::string& snapshot
   const std::string& full_loaded_blockchain_configuration_json = std::get<3>(snapshotManifest);
 
   wlog("Snapshot state definitions matches current app version - wiping DB.");
+  _state_replaced = true;
   _mainDb.close();
   _mainDb.wipe(openArgs.shared_mem_dir);
   _mainDb.pre_open(openArgs);
@@ -1719,6 +1731,148 @@ void state_snapshot_plugin::impl::process_explicit_snapshot_load_requests(const
     }
   }
 
+namespace {
+  const std::string REPLAY_CHECKPOINT_PREFIX = "replay_checkpoint_";
+  const std::string REPLAY_CHECKPOINT_TMP_SUFFIX = ".tmp";
+  /// older checkpoints are removed - last one is what we need, the one before is kept in case the last is unusable
+  const size_t REPLAY_CHECKPOINTS_TO_KEEP = 2;
+} /// namespace anonymous
+
+std::map<uint32_t, std::string> state_snapshot_plugin::impl::collect_replay_checkpoints() const
+  {
+  std::map<uint32_t, std::string> checkpoints;
+
+  if(bfs::exists(_storagePath) == false)
+    return checkpoints;
+
+  for(const auto& entry : bfs::directory_iterator(_storagePath))
+  {
+    const std::string name = entry.path().filename().string();
+    if(bfs::is_directory(entry.path()) == false || boost::starts_with(name, REPLAY_CHECKPOINT_PREFIX) == false)
+      continue;
+
+    if(boost::ends_with(name, REPLAY_CHECKPOINT_TMP_SUFFIX))
+    {
+      /// Dump was interrupted before completion - such checkpoint can't be used.
+      wlog("Removing incomplete replay checkpoint: `${p}'", ("p", entry.path().string()));
+      bfs::remove_all(entry.path());
+      continue;
+    }
+
+    try
+    {
+      checkpoints.emplace(boost::lexical_cast<uint32_t>(name.substr(REPLAY_CHECKPOINT_PREFIX.size())), name);
+    }
+    catch(const boost::bad_lexical_cast&)
+    {
+      wlog("Ignoring unexpected directory `${p}' in the snapshot directory", ("p", entry.path().string()));
+    }
+  }
+
+  return checkpoints;
+  }
+
+void state_snapshot_plugin::impl::dump_replay_checkpoint()
+  {
+  const uint32_t blockNo = _mainDb.head_block_num();
+  char blockNoStr[16];
+  snprintf(blockNoStr, sizeof(blockNoStr), "%010u", blockNo); /// padded, so checkpoints are also sorted by name
+  const std::string name = REPLAY_CHECKPOINT_PREFIX + blockNoStr;
+  const std::string tmpName = name + REPLAY_CHECKPOINT_TMP_SUFFIX;
+
+  ilog("Dumping replay checkpoint at block ${b}...", ("b", blockNo));
+
+  /// Checkpoint is dumped under temporary name and renamed when complete, so after a crash in the middle of the dump
+  /// we never see partial checkpoint as valid one.
+  bfs::remove_all(_storagePath / tmpName);
+  _exception = nullptr;
+  _is_error = false;
+
+  if(prepare_snapshot(tmpName) == false)
+  {
+    wlog("Replay checkpoint at block ${b} was not created, replay continues", ("b", blockNo));
+    bfs::remove_all(_storagePath / tmpName);
+    return;
+  }
+
+  bfs::remove_all(_storagePath / name);
+  bfs::rename(_storagePath / tmpName, _storagePath / name);
+
+  auto checkpoints = collect_replay_checkpoints();
+  while(checkpoints.size() > REPLAY_CHECKPOINTS_TO_KEEP)
+  {
+    ilog("Removing old replay checkpoint `${n}'", ("n", checkpoints.begin()->second));
+    bfs::remove_all(_storagePath / checkpoints.begin()->second);
+    checkpoints.erase(checkpoints.begin());
+  }
+  }
+
+uint32_t state_snapshot_plugin::impl::load_latest_replay_checkpoint(const hive::chain::open_args& openArgs)
+  {
+  const auto checkpoints = collect_replay_checkpoints();
+  const uint32_t headBlockNo = _mainDb.head_block_num();
+  bool stateReplaced = false;
+
+  /// Newest checkpoint is tried first, when it turns out to be unusable older one is tried next.
+  for(auto it = checkpoints.rbegin(); it != checkpoints.rend(); ++it)
+  {
+    if(it->first <= headBlockNo)
+    {
+      ilog("Replay checkpoint `${n}' is not ahead of state (head block: ${h}) - ignoring it", ("n", it->second)("h", headBlockNo));
+      break;
+    }
+
+    ilog("Resuming replay from checkpoint `${n}'", ("n", it->second));
+    _self.get_app().notify_status("loading replay checkpoint");
+    try
+    {
+      _state_replaced = false;
+      _exception = nullptr;
+      _is_error = false;
+      load_snapshot(it->second, openArgs);
+      if(_state_replaced)
+      {
+        _self.get_app().notify_status("finished loading replay checkpoint");
+        return _mainDb.head_block_num();
+      }
+      /// load_snapshot only reports missing snapshot, but such checkpoint can't be used either
+    }
+    catch(const fc::exception& e)
+    {
+      elog("Loading replay checkpoint `${n}' failed: ${e}", ("n", it->second)("e", e.to_detail_string()));
+    }
+    catch(const std::exception& e)
+    {
+      elog("Loading replay checkpoint `${n}' failed: ${e}", ("n", it->second)("e", e.what()));
+    }
+    stateReplaced = stateReplaced || _state_replaced;
+    wlog("Removing unusable replay checkpoint `${n}'", ("n", it->second));
+    bfs::remove_all(_storagePath / it->second);
+  }
+
+  if(stateReplaced)
+  {
+    /// Failed load might have left partially filled state behind - start over from empty one, so replay goes from
+    /// the first block.
+    wlog("No replay checkpoint could be loaded - state is cleared and replay starts from scratch");
+    _mainDb.close();
+    _mainDb.wipe(openArgs.shared_mem_dir);
+    _mainDb.pre_open(openArgs);
+    _mainDb.open(openArgs);
+  }
+
+  return 0;
+  }
+
+void state_snapshot_plugin::impl::remove_replay_checkpoints()
+  {
+  for(const auto& checkpoint : collect_replay_checkpoints())
+  {
+    ilog("Removing replay checkpoint `${n}'", ("n", checkpoint.second));
+    bfs::remove_all(_storagePath / checkpoint.second);
+  }
+  }
+
 state_snapshot_plugin::state_snapshot_plugin()
   {
   }
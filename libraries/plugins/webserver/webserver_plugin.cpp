@@ -45,6 +45,9 @@ using collector_t = hive::utilities::notifications::collector_t;
 
 typedef uint32_t thread_pool_size_t;
 
+/// Requests on unix endpoint with this content type are served by binary (fc::raw) versions of API methods
+const char* const binary_content_type = "application/octet-stream";
+
 namespace detail {
 
   struct asio_tls_with_stub_log : public websocketpp::config::asio_tls
@@ -258,6 +261,9 @@ class webserver_base
     optional< tcp::endpoint >                                 http_endpoint;
     optional< boost::asio::local::stream_protocol::endpoint > unix_endpoint;
     optional< tcp::endpoint >                                 ws_endpoint;
+
+    /// websocket subscriber is disconnected when it lets that much outgoing data pile up (backpressure)
+    size_t                                                    ws_subscriber_buffer_limit = 0;
 };
 
 template<typename websocket_server_type>
@@ -279,6 +285,8 @@ class webserver_plugin_impl : public webserver_base
     void handle_http_message( websocket_server_type*, connection_hdl );
     void handle_http_request( websocket_local_server_type*, connection_hdl );
 
+    plugins::json_rpc::subscription_sink make_subscription_sink( const typename websocket_server_type::connection_ptr& con ) const;
+
     thread_pool_size_t         thread_pool_size;
 
     shared_ptr< std::thread >  http_thread;
@@ -491,7 +499,7 @@ void webserver_plugin_impl<websocket_server_type>::start_webserver()
       try {
         unix_server.clear_access_channels( websocketpp::log::alevel::all );
         unix_server.clear_error_channels( websocketpp::log::elevel::all );
-        unix_server.init_asio( &http_ios );
+        unix_server.init_asio( &unix_ios );
 
         unix_server.set_http_handler( boost::bind( &webserver_plugin_impl<websocket_server_type>::handle_http_request, this, &unix_server, _1 ) );
         //unix_server.set_http_handler([&](connection_hdl hdl) {
@@ -504,7 +512,7 @@ void webserver_plugin_impl<websocket_server_type>::start_webserver()
         unix_server.start_accept();
 
         ilog( "start running unix http requests" );
-        http_ios.run();
+        unix_ios.run();
         ilog( "unix http io service exit" );
       } catch( ... ) {
         elog( "error thrown from unix http io service" );
@@ -565,6 +573,27 @@ void webserver_plugin_impl<websocket_server_type>::stop_webserver()
   }
 }
 
+template<typename websocket_server_type>
+plugins::json_rpc::subscription_sink webserver_plugin_impl<websocket_server_type>::make_subscription_sink( const typename websocket_server_type::connection_ptr& con ) const
+{
+  return [con, limit = ws_subscriber_buffer_limit]( const std::string& notification ) -> bool
+  {
+    if( con->get_state() != websocketpp::session::state::open )
+      return false;
+
+    websocketpp::lib::error_code ec;
+    if( con->get_buffered_amount() > limit )
+    {
+      ilog( "Disconnecting websocket subscriber - ${size} bytes of notifications not yet sent", ( "size", con->get_buffered_amount() ) );
+      con->close( websocketpp::close::status::try_again_later, "subscriber is not keeping up with notifications", ec );
+      return false;
+    }
+
+    ec = con->send( notification );
+    return !ec;
+  };
+}
+
 template<typename websocket_server_type>
 void webserver_plugin_impl<websocket_server_type>::handle_ws_message( websocket_server_type* server, connection_hdl hdl, const typename websocket_server_type::message_ptr& msg )
 {
@@ -581,7 +610,7 @@ void webserver_plugin_impl<websocket_server_type>::handle_ws_message( websocket_
         auto body = msg->get_payload();
         LOG_DELAY(arrival_time, fc::seconds(4), "Excessive delay to get ws payload");
 
-        auto response =  api->call( body );
+        auto response =  api->call( body, make_subscription_sink( con ) );
         LOG_DELAY_EX(arrival_time, fc::seconds(10), "Excessive delay to process ws API call: ${body}", (body));
 
         con->send( response );
@@ -688,8 +717,22 @@ void webserver_plugin_impl<websocket_server_type>::handle_http_request(websocket
 
     try
     {
-      con->set_body( api->call( body ) );
-      con->append_header( "Content-Type", "application/json" );
+      if( con->get_request_header( "Content-Type" ) == binary_content_type )
+      {
+        // binary call: resource names the method ("/api.method"), body holds fc::raw packed args
+        std::string method = con->get_resource();
+        if( !method.empty() && method.front() == '/' )
+          method.erase( 0, 1 );
+
+        std::vector< char > result = api->call_binary( method, std::vector< char >( body.begin(), body.end() ) );
+        con->set_body( std::string( result.begin(), result.end() ) );
+        con->append_header( "Content-Type", binary_content_type );
+      }
+      else
+      {
+        con->set_body( api->call( body ) );
+        con->append_header( "Content-Type", "application/json" );
+      }
       con->set_status( websocketpp::http::status_code::ok );
     }
     catch( fc::exception& e )
@@ -737,10 +780,13 @@ void webserver_plugin::set_program_options( options_description&, options_descri
   cfg.add_options()
     ("webserver-http-endpoint", bpo::value< string >(), "Local http endpoint for webserver requests.")
     ("webserver-https-endpoint", bpo::value< string >(), "Local https endpoint for webserver requests.")
-    ("webserver-unix-endpoint", bpo::value< string >(), "Local unix http endpoint for webserver requests.")
+    ("webserver-unix-endpoint", bpo::value< string >(), "Local unix http endpoint for webserver requests. "
+      "Requests with 'Content-Type: application/octet-stream' sent to '/api.method' are served in binary (fc::raw) form by APIs that support it.")
     ("webserver-ws-endpoint", bpo::value< string >(), "Local websocket endpoint for webserver requests.")
     // TODO: maybe add a flag to make this optional
     ("webserver-ws-deflate", bpo::value<bool>()->default_value( false ), "Enable the RFC-7692 permessage-deflate extension for the WebSocket server (only used if the client requests it).  This may save bandwidth at the expense of CPU")
+    ("webserver-ws-subscriber-buffer-size", bpo::value<uint32_t>()->default_value(64),
+      "Size (in MB) of outgoing notifications that can wait for a websocket subscriber before it is disconnected. Default: 64.")
     ("webserver-thread-pool-size", bpo::value<thread_pool_size_t>()->default_value(16),
       "Number of threads used to handle queries. Default: 16.")
     ("webserver-https-certificate-file-name", bpo::value< string >(), "File name with a server's certificate." )
@@ -786,6 +832,8 @@ void webserver_plugin::plugin_initialize( const variables_map& options )
       my.reset( new detail::webserver_plugin_impl<detail::websocket_server_type_nondeflate>( thread_pool_size, get_app() ) );
   }
 
+  my->ws_subscriber_buffer_limit = size_t( options.at( "webserver-ws-subscriber-buffer-size" ).as< uint32_t >() ) * 1024 * 1024;
+
   if( options.count( "webserver-http-endpoint" ) || options.count( "webserver-https-endpoint" ) )
   {
     std::string _http_or_https_endpoint = my->tls ? options.at( "webserver-https-endpoint" ).as< string >() : options.at( "webserver-http-endpoint" ).as< string >();
@@ -130,7 +130,7 @@ class witness_plugin_impl
     hive::plugins::p2p::p2p_plugin& p2p;
   };
 
-  void check_memo( const string& memo, const chain::account_object& account, const account_authority_object& auth )
+  void check_memo( const chain::database& db, const string& memo, const chain::account_object& account, const account_authority_object& auth )
   {
     vector< public_key_type > keys;
 
@@ -158,7 +158,10 @@ class witness_plugin_impl
           "Detected private posting key in memo field. You should change your posting keys." );
     }
 
-    const auto& memo_key = account.memo_key;
+    const auto* details = db.find_account_details( account );
+    if( details == nullptr ) // no memo key set
+      return;
+    const auto& memo_key = details->memo_key;
     for( auto& key : keys )
       HIVE_ASSERT( memo_key != key,  plugin_exception,
         "Detected private memo key in memo field. You should change your memo key." );
@@ -178,7 +181,7 @@ class witness_plugin_impl
     void operator()( const transfer_operation& o )const
     {
       if( o.memo.length() > 0 )
-        check_memo( o.memo,
+        check_memo( _db, o.memo,
                 _db.get< chain::account_object, chain::by_name >( o.from ),
                 _db.get< account_authority_object, chain::by_account >( o.from ) );
     }
@@ -186,7 +189,7 @@ class witness_plugin_impl
     void operator()( const transfer_to_savings_operation& o )const
     {
       if( o.memo.length() > 0 )
-        check_memo( o.memo,
+        check_memo( _db, o.memo,
                 _db.get< chain::account_object, chain::by_name >( o.from ),
                 _db.get< account_authority_object, chain::by_account >( o.from ) );
     }
@@ -194,7 +197,7 @@ class witness_plugin_impl
     void operator()( const transfer_from_savings_operation& o )const
     {
       if( o.memo.length() > 0 )
-        check_memo( o.memo,
+        check_memo( _db, o.memo,
                 _db.get< chain::account_object, chain::by_name >( o.from ),
                 _db.get< account_authority_object, chain::by_account >( o.from ) );
     }
@@ -202,7 +205,7 @@ class witness_plugin_impl
     void operator()( const recurrent_transfer_operation& o )const
     {
       if( o.memo.length() > 0 )
-        check_memo( o.memo,
+        check_memo( _db, o.memo,
           _db.get< chain::account_object, chain::by_name >( o.from ),
           _db.get< account_authority_object, chain::by_account >( o.from ) );
     }
@@ -127,6 +127,23 @@ bool is_valid_account_name( const string& name )
   return detail::check_account_name( name ) == account_name_validity::valid;
 }
 
+authority_view::operator authority()const
+{
+  authority result;
+
+  result.account_auths.reserve( account_auths.size() );
+  for( const auto& item : account_auths )
+    result.account_auths.insert( result.account_auths.end(), item );
+
+  result.key_auths.reserve( key_auths.size() );
+  for( const auto& item : key_auths )
+    result.key_auths.insert( result.key_auths.end(), item );
+
+  result.weight_threshold = weight_threshold;
+
+  return result;
+}
+
 bool operator == ( const authority& a, const authority& b )
 {
   return ( a.weight_threshold == b.weight_threshold ) &&
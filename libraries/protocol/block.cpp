@@ -1,4 +1,5 @@
 #include <hive/protocol/block.hpp>
+#include <hive/protocol/buffered_encoder.hpp>
 #include <fc/io/raw.hpp>
 #include <fc/bitutil.hpp>
 #include <algorithm>
@@ -7,7 +8,7 @@ namespace hive { namespace protocol {
   digest_type block_header::legacy_digest()const
   {
     hive::protocol::serialization_mode_controller::pack_guard guard( hive::protocol::pack_type::legacy );
-    return digest_type::hash(*this);
+    return buffered_hash< digest_type >( *this );
   }
 
   uint32_t block_header::num_from_id(const block_id_type& id)
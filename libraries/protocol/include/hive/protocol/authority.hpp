@@ -54,6 +54,49 @@ namespace hive { namespace protocol {
     key_authority_map                                               key_auths;
   };
 
+  /**
+    * Non-owning view of authority (regular one or its shared memory counterpart) for places that only read it, like
+    * signature verification, so they don't need to copy it. Valid as long as viewed object is alive and unchanged.
+    */
+  struct authority_view
+  {
+    /// Both flat_map types keep their elements in contiguous sorted storage, so pair of pointers is enough.
+    template< typename ValueType >
+    class range
+    {
+      public:
+        range(){}
+
+        template< typename FlatMap >
+        explicit range( const FlatMap& m )
+          : _begin( m.empty() ? nullptr : &*m.begin() ), _end( _begin + m.size() )
+        {
+          static_assert( std::is_same< typename FlatMap::value_type, ValueType >::value, "Incompatible map type" );
+        }
+
+        const ValueType* begin()const { return _begin; }
+        const ValueType* end()const { return _end; }
+        bool   empty()const { return _begin == _end; }
+        size_t size()const { return _end - _begin; }
+
+      private:
+        const ValueType* _begin = nullptr;
+        const ValueType* _end = nullptr;
+    };
+
+    authority_view(){}
+
+    template< typename AuthorityType >
+    explicit authority_view( const AuthorityType& a )
+      : weight_threshold( a.weight_threshold ), account_auths( a.account_auths ), key_auths( a.key_auths ) {}
+
+    operator authority()const;
+
+    uint32_t                                                        weight_threshold = 0;
+    range< std::pair< account_name_type, weight_type > >            account_auths;
+    range< std::pair< public_key_type, weight_type > >              key_auths;
+  };
+
 template< typename AuthorityType >
 void add_authority_accounts(
   flat_set<account_name_type>& result,
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <fc/io/raw.hpp>
+
+#include <cstring>
+
+namespace hive { namespace protocol {
+
+/**
+  * Stream for fc::raw::pack that collects packed data in local buffer before passing it to hash encoder.
+  * Packing of reflected structures writes each field separately, mostly just few bytes at a time, so writing
+  * directly to encoder means one (relatively costly) update of hash state per field. With the buffer encoder
+  * gets few large blocks instead. The resulting hash is the same.
+  */
+template< typename Encoder, size_t BufferSize = 1024 >
+class buffered_encoder
+{
+  public:
+    void write( const char* data, size_t size )
+    {
+      if( size > BufferSize - used )
+      {
+        flush();
+        if( size >= BufferSize )
+        {
+          encoder.write( data, size );
+          return;
+        }
+      }
+      memcpy( buffer + used, data, size );
+      used += size;
+    }
+
+    void put( char c )
+    {
+      if( used == BufferSize )
+        flush();
+      buffer[ used++ ] = c;
+    }
+
+    auto result()
+    {
+      flush();
+      return encoder.result();
+    }
+
+  private:
+    void flush()
+    {
+      if( used != 0 )
+      {
+        encoder.write( buffer, used );
+        used = 0;
+      }
+    }
+
+    Encoder encoder;
+    char    buffer[ BufferSize ];
+    size_t  used = 0;
+};
+
+/// same as Hash::hash( obj ) but with packed data passing through buffered_encoder
+template< typename Hash, typename... Args >
+Hash buffered_hash( const Args&... objs )
+{
+  buffered_encoder< typename Hash::encoder > enc;
+  ( fc::raw::pack( enc, objs ), ... );
+  return enc.result();
+}
+
+} } // hive::protocol
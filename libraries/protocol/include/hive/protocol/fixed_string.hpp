@@ -243,7 +243,13 @@ namespace fc { namespace raw {
 template< typename Stream, typename Storage >
 inline void pack( Stream& s, const hive::protocol::fixed_string_impl< Storage >& u )
 {
-  pack( s, std::string( u ) );
+  // same bytes as pack( s, std::string( u ) ), but written straight from storage - account names are part of almost
+  // every operation, so temporary string (allocated for longest names) would be made many times per transaction
+  Storage d = boost::endian::native_to_big( u.data );
+  const uint32_t size = strnlen( (const char*)&d, sizeof(d) );
+  pack( s, unsigned_int( size ) );
+  if( size )
+    s.write( (const char*)&d, size );
 }
 
 template< typename Stream, typename Storage >
@@ -6,6 +6,8 @@
 #include <hive/protocol/sign_state_types.hpp>
 #include <hive/protocol/types.hpp>
 
+#include <type_traits>
+
 namespace hive { namespace protocol {
 
 struct sign_limits
@@ -16,12 +18,18 @@ struct sign_limits
   uint32_t account_auths = ~0;
 };
 
-template <bool IS_TRACED=false>
+/**
+ * @tparam AuthorityGetter authority_getter or authority_view_getter (or anything callable with account name that
+ *   returns one of authority types)
+ */
+template <bool IS_TRACED=false, typename AuthorityGetter=authority_getter>
 class sign_state
 {
+    using authority_type = std::decay_t< std::invoke_result_t< AuthorityGetter, const string& > >;
+
     size_t account_auth_count       = 0;
 
-    authority_getter                get_current_authority;
+    AuthorityGetter                 get_current_authority;
 
     const sign_limits               limits;
     flat_set<string>                approved_by;
@@ -35,7 +43,7 @@ class sign_state
      * @param the_tracer mandatory when IS_TRACED, ignored otherwise
      */
     sign_state( const flat_set<public_key_type>& sigs,
-      const authority_getter& getter,
+      const AuthorityGetter& getter,
       const sign_limits& limits,
       authority_verification_tracer* the_tracer = nullptr )
       : get_current_authority( getter ), limits( limits ), tracer(the_tracer)
@@ -58,7 +66,7 @@ class sign_state
 
     bool check_authority( const string& id )
     {
-      authority initial_auth;
+      authority_type initial_auth;
       if constexpr (IS_TRACED) {
         FC_ASSERT(tracer && "check_authority 1", "check_authority: tracer is null", ("id", id));
         try
@@ -105,7 +113,8 @@ class sign_state
       *  Checks to see if we have signatures of the active authorites of
       *  the accounts specified in authority or the keys specified.
       */
-    bool check_authority( const authority& auth, const string& id, const string& role )
+    template< typename AuthorityType >
+    bool check_authority( const AuthorityType& auth, const string& id, const string& role )
     {
       if constexpr (IS_TRACED) {
           FC_ASSERT(tracer && "check_authority 4", "check_authority: tracer is null", ("id", id));
@@ -157,14 +166,15 @@ class sign_state
 
     const flat_map<public_key_type,bool>&  get_provided_signatures() const { return provided_signatures; }
 
-    void change_current_authority( const authority_getter& a )
+    void change_current_authority( const AuthorityGetter& a )
     {
       get_current_authority = a;
     }
 
   private:
 
-    bool check_authority_impl( const authority& auth, uint32_t depth )
+    template< typename AuthorityType >
+    bool check_authority_impl( const AuthorityType& auth, uint32_t depth )
     {
       uint32_t total_weight = 0;
 
@@ -235,7 +245,7 @@ class sign_state
 
           ++account_auth_count;
 
-          authority account_auth;
+          authority_type account_auth;
           if constexpr (IS_TRACED) {
             FC_ASSERT(tracer && "check_authority 11");
             try
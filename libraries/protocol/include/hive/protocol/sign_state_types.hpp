@@ -6,6 +6,8 @@
 namespace hive { namespace protocol {
 
 typedef std::function<authority(const string&)> authority_getter;
+/// cheaper alternative to authority_getter for callers that can keep authorities alive during verification
+typedef std::function<authority_view(const string&)> authority_view_getter;
 typedef std::function<public_key_type(const string&)> witness_public_key_getter;
 
 struct required_authorities_type
@@ -275,6 +275,9 @@ class configuration
     uint64_t         custom_op_block_limit = 5;
 
     bool allow_not_enough_rc = false;
+    // when false, changes of witness votes made during block-level processing are applied immediately instead
+    // of in batches (to compare both ways in tests)
+    bool batch_witness_votes = true;
     uint32_t rc_stats_report_frequency = // in blocks
 #ifdef IS_TEST_NET
       400; // HIVE_BLOCKS_PER_HOUR/3 - three reports per hour for testnet
@@ -34,6 +34,24 @@ void verify_authority(bool allow_strict_and_mixed_authorities,
                       const flat_set<account_name_type>& owner_approvals = flat_set<account_name_type>(),
                       const flat_set<account_name_type>& posting_approvals = flat_set<account_name_type>());
 
+/// Same as above, but authorities are only viewed, not copied - getters have to return views of objects that stay
+/// alive and unchanged during the call (like authorities kept in state).
+void verify_authority(bool allow_strict_and_mixed_authorities,
+                      bool allow_redundant_signatures,
+                      const required_authorities_type& required_authorities,
+                      const flat_set<public_key_type>& sigs,
+                      const authority_view_getter& get_active,
+                      const authority_view_getter& get_owner,
+                      const authority_view_getter& get_posting,
+                      const witness_public_key_getter& get_witness_key,
+                      uint32_t max_recursion_depth = HIVE_MAX_SIG_CHECK_DEPTH,
+                      uint32_t max_membership = HIVE_MAX_AUTHORITY_MEMBERSHIP,
+                      uint32_t max_account_auths = HIVE_MAX_SIG_CHECK_ACCOUNTS,
+                      bool allow_committe = false,
+                      const flat_set<account_name_type>& active_approvals = flat_set<account_name_type>(),
+                      const flat_set<account_name_type>& owner_approvals = flat_set<account_name_type>(),
+                      const flat_set<account_name_type>& posting_approvals = flat_set<account_name_type>());
+
 bool has_authorization( bool allow_strict_and_mixed_authorities,
                         bool allow_redundant_signatures,
                         const required_authorities_type& required_authorities,
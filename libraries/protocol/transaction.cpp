@@ -1,6 +1,7 @@
 
 #include <hive/protocol/transaction.hpp>
 #include <hive/protocol/transaction_util.hpp>
+#include <hive/protocol/buffered_encoder.hpp>
 
 #include <fc/io/raw.hpp>
 #include <fc/bitutil.hpp>
@@ -13,28 +14,19 @@ namespace hive { namespace protocol {
 digest_type signed_transaction::merkle_digest(hive::protocol::pack_type pack)const
 {
   hive::protocol::serialization_mode_controller::pack_guard guard( pack );
-  digest_type::encoder enc;
-  fc::raw::pack( enc, *this );
-  return enc.result();
+  return buffered_hash< digest_type >( *this );
 }
 
 digest_type transaction::digest(hive::protocol::pack_type pack)const
 {
   hive::protocol::serialization_mode_controller::pack_guard guard( pack );
-  digest_type::encoder enc;
-  fc::raw::pack( enc, *this );
-  return enc.result();
+  return buffered_hash< digest_type >( *this );
 }
 
 digest_type transaction::sig_digest( const chain_id_type& chain_id, hive::protocol::pack_type pack )const
 {
-  digest_type::encoder enc;
-
   hive::protocol::serialization_mode_controller::pack_guard guard( pack );
-  fc::raw::pack( enc, chain_id );
-  fc::raw::pack( enc, *this );
-
-  return enc.result();
+  return buffered_hash< digest_type >( chain_id, *this );
 }
 
 void transaction::validate() const
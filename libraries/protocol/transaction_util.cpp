@@ -14,15 +14,15 @@ enum class verify_authority_problem
   unused_signature
 };
 
-template< bool IS_TRACED=false, typename PROBLEM_HANDLER, typename OTHER_AUTH_PROBLEM_HANDLER >
+template< bool IS_TRACED=false, typename AUTHORITY_GETTER, typename PROBLEM_HANDLER, typename OTHER_AUTH_PROBLEM_HANDLER >
 void verify_authority_impl(
   bool allow_strict_and_mixed_authorities,
   bool allow_redundant_signatures,
   const required_authorities_type& required_authorities,
   const flat_set<public_key_type>& sigs,
-  const authority_getter& get_active,
-  const authority_getter& get_owner,
-  const authority_getter& get_posting,
+  const AUTHORITY_GETTER& get_active,
+  const AUTHORITY_GETTER& get_owner,
+  const AUTHORITY_GETTER& get_posting,
   const witness_public_key_getter& get_witness_key,
   uint32_t max_recursion_depth,
   uint32_t max_membership,
@@ -54,7 +54,7 @@ FC_EXPAND_MACRO(                                                \
   FC_MULTILINE_MACRO_END                                        \
 )
 
-  sign_state<IS_TRACED> s( sigs, get_posting, { allow_strict_and_mixed_authorities, max_recursion_depth, max_membership, max_account_auths }, tracer );
+  sign_state<IS_TRACED, AUTHORITY_GETTER> s( sigs, get_posting, { allow_strict_and_mixed_authorities, max_recursion_depth, max_membership, max_account_auths }, tracer );
 
   if( not required_authorities.required_posting.empty() )
   {
@@ -89,7 +89,7 @@ FC_EXPAND_MACRO(                                                \
       }
       else
       {
-        auto check_with_role_upgrade = [&](const authority& auth, const string& role) -> bool {
+        auto check_with_role_upgrade = [&](const auto& auth, const string& role) -> bool {
           if constexpr (IS_TRACED)
           {
             FC_ASSERT( tracer && "required_posting_upgrade", "Can't trace without tracer" );
@@ -191,14 +191,14 @@ FC_EXPAND_MACRO(                                                \
 #undef VERIFY_AUTHORITY_CHECK_OTHER_AUTH
 }
 
-template<bool IS_TRACED>
+template<bool IS_TRACED, typename AUTHORITY_GETTER>
 void verify_authority(bool allow_strict_and_mixed_authorities,
                       bool allow_redundant_signatures,
                       const required_authorities_type& required_authorities,
                       const flat_set<public_key_type>& sigs,
-                      const authority_getter& get_active,
-                      const authority_getter& get_owner,
-                      const authority_getter& get_posting,
+                      const AUTHORITY_GETTER& get_active,
+                      const AUTHORITY_GETTER& get_owner,
+                      const AUTHORITY_GETTER& get_posting,
                       const witness_public_key_getter& get_witness_key,
                       uint32_t max_recursion_depth /* = HIVE_MAX_SIG_CHECK_DEPTH */,
                       uint32_t max_membership /* = HIVE_MAX_AUTHORITY_MEMBERSHIP */,
@@ -231,15 +231,15 @@ FC_EXPAND_MACRO(                                                      \
           "with transactions requiring active or owner authority." );
       case verify_authority_problem::missing_posting:
         VERIFY_AUTHORITY_THROW( tx_missing_posting_auth,
-          "Missing Posting Authority ${id}", ( id )( "posting", get_posting( id ) )
-          ( "active", get_active( id ) )( "owner", get_owner( id ) ) );
+          "Missing Posting Authority ${id}", ( id )( "posting", authority( get_posting( id ) ) )
+          ( "active", authority( get_active( id ) ) )( "owner", authority( get_owner( id ) ) ) );
       case verify_authority_problem::missing_active:
         VERIFY_AUTHORITY_THROW( tx_missing_active_auth,
           "Missing Active Authority ${id}", ( id )
-          ( "auth", get_active( id ) )( "owner", get_owner( id ) ) );
+          ( "auth", authority( get_active( id ) ) )( "owner", authority( get_owner( id ) ) ) );
       case verify_authority_problem::missing_owner:
         VERIFY_AUTHORITY_THROW( tx_missing_owner_auth,
-          "Missing Owner Authority ${id}", ( id )( "auth", get_owner( id ) ) );
+          "Missing Owner Authority ${id}", ( id )( "auth", authority( get_owner( id ) ) ) );
       case verify_authority_problem::missing_witness:
         VERIFY_AUTHORITY_THROW( tx_missing_witness_auth,
           "Missing Witness Authority ${id}, key ${signing_key}", ( id )
@@ -301,6 +301,43 @@ void verify_authority(bool allow_strict_and_mixed_authorities,
   );
 }
 
+void verify_authority(bool allow_strict_and_mixed_authorities,
+                      bool allow_redundant_signatures,
+                      const required_authorities_type& required_authorities,
+                      const flat_set<public_key_type>& sigs,
+                      const authority_view_getter& get_active,
+                      const authority_view_getter& get_owner,
+                      const authority_view_getter& get_posting,
+                      const witness_public_key_getter& get_witness_key,
+                      uint32_t max_recursion_depth /* = HIVE_MAX_SIG_CHECK_DEPTH */,
+                      uint32_t max_membership /* = HIVE_MAX_AUTHORITY_MEMBERSHIP */,
+                      uint32_t max_account_auths /* = HIVE_MAX_SIG_CHECK_ACCOUNTS */,
+                      bool allow_committe /* = false */,
+                      const flat_set<account_name_type>& active_approvals /* = flat_set<account_name_type>() */,
+                      const flat_set<account_name_type>& owner_approvals /* = flat_set<account_name_type>() */,
+                      const flat_set<account_name_type>& posting_approvals /* = flat_set<account_name_type>() */
+                      )
+{
+  verify_authority<false>(
+    allow_strict_and_mixed_authorities,
+    allow_redundant_signatures,
+    required_authorities,
+    sigs,
+    get_active,
+    get_owner,
+    get_posting,
+    get_witness_key,
+    max_recursion_depth /* = HIVE_MAX_SIG_CHECK_DEPTH */,
+    max_membership /* = HIVE_MAX_AUTHORITY_MEMBERSHIP */,
+    max_account_auths /* = HIVE_MAX_SIG_CHECK_ACCOUNTS */,
+    allow_committe /* = false */,
+    active_approvals /* = flat_set<account_name_type>() */,
+    owner_approvals /* = flat_set<account_name_type>() */,
+    posting_approvals /* = flat_set<account_name_type>() */,
+    nullptr
+  );
+}
+
 template <class T>
 T force_found(std::optional<T> t, const string& id)
 {
@@ -331,9 +368,9 @@ authority_verification_trace verify_authority_with_tracing(
     allow_redundant_signatures,
     required_authorities,
     sigs,
-    [&](const string& id) -> authority { return force_found(getters.get_active(id), id); },
-    [&](const string& id) -> authority { return force_found(getters.get_owner(id), id); },
-    [&](const string& id) -> authority { return force_found(getters.get_posting(id), id); },
+    authority_getter( [&](const string& id) -> authority { return force_found(getters.get_active(id), id); } ),
+    authority_getter( [&](const string& id) -> authority { return force_found(getters.get_owner(id), id); } ),
+    authority_getter( [&](const string& id) -> authority { return force_found(getters.get_posting(id), id); } ),
     [&](const string& id) -> public_key_type { return force_found(getters.get_witness_key(id), id); },
     max_recursion_depth /* = HIVE_MAX_SIG_CHECK_DEPTH */,
     max_membership /* = HIVE_MAX_AUTHORITY_MEMBERSHIP */,
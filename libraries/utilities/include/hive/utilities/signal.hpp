@@ -2,6 +2,8 @@
 
 #include <hive/utilities/signal_connection_ptr.hpp>
 
+#include <vector>
+
 namespace hive { namespace utilities {
 
 /// Disconnects a signal connection and asserts it is disconnected.
@@ -10,4 +12,7 @@ void disconnect_signal( boost::signals2::connection& signal );
 /// Disconnects and resets an opaque signal_connection_ptr.
 void disconnect_signal( signal_connection_ptr& signal );
 
+/// Disconnects and resets all connections of a group (e.g. one registered handler per operation type).
+void disconnect_signal( std::vector<signal_connection_ptr>& signals );
+
 } }
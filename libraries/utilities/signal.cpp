@@ -21,4 +21,11 @@ void disconnect_signal( signal_connection_ptr& signal )
   }
 }
 
+void disconnect_signal( std::vector<signal_connection_ptr>& signals )
+{
+  for( auto& signal : signals )
+    disconnect_signal( signal );
+  signals.clear();
+}
+
 } } // hive::utilities
@@ -14,6 +14,7 @@
 #include <hive/chain/full_block.hpp>
 #include <hive/chain/blockchain_worker_thread_pool.hpp>
 #include <hive/chain/block_compression_dictionaries.hpp>
+#include <hive/chain/chunked_block_log.hpp>
 #include <hive/chain/split_block_log.hpp>
 #include <hive/utilities/io_primitives.hpp>
 #include <hive/utilities/git_revision.hpp>
@@ -37,6 +38,8 @@
 #include <queue>
 #include <atomic>
 #include <algorithm>
+#include <map>
+#include <optional>
 
 enum ExitCode
 {
@@ -321,6 +324,227 @@ ExitCode checksum_block_log(const fc::path &block_log, fc::optional<uint32_t> ch
   FC_LOG_AND_RETHROW()
 }
 
+struct integrity_range_result
+{
+  std::vector<std::shared_ptr<hive::chain::full_block_type>> blocks;
+  std::vector<std::string> errors;
+};
+
+// verifies blocks of given range against their artifacts (ids, merkle roots, links to previous blocks); decoded blocks are kept for hashing
+integrity_range_result verify_block_range_integrity(const hive::chain::block_log &log, const uint32_t first_block_num, const uint32_t range_first, const uint32_t range_last,
+  std::unique_ptr<char[]> &block_data_buffer, size_t &block_data_buffer_size)
+{
+  integrity_range_result result;
+  result.blocks.reserve(range_last - range_first + 1);
+
+  std::optional<hive::chain::block_id_type> previous_block_id;
+  if (range_first == 1)
+    previous_block_id = hive::chain::block_id_type();
+  else if (range_first > first_block_num)
+    previous_block_id = log.read_block_id_by_num(range_first - 1); // verified against block data by the range that holds it
+
+  const auto verify_block = [&](std::shared_ptr<hive::chain::full_block_type> full_block, const uint32_t block_num, const hive::chain::block_id_type &artifacts_block_id)
+  {
+    try
+    {
+      const hive::chain::block_id_type &block_id = full_block->get_block_id();
+      if (full_block->get_block_num() != block_num)
+        result.errors.push_back("block " + std::to_string(block_num) + ": block data holds block " + std::to_string(full_block->get_block_num()));
+      if (block_id != artifacts_block_id)
+        result.errors.push_back("block " + std::to_string(block_num) + ": block id " + block_id.str() + " does not match id from artifacts " + artifacts_block_id.str());
+      if (full_block->get_merkle_root() != full_block->get_block_header().transaction_merkle_root)
+        result.errors.push_back("block " + std::to_string(block_num) + ": transaction merkle root mismatch");
+      if (previous_block_id && full_block->get_block_header().previous != *previous_block_id)
+        result.errors.push_back("block " + std::to_string(block_num) + ": previous block id " + full_block->get_block_header().previous.str() + " does not match id of previous block " + previous_block_id->str());
+      full_block->get_uncompressed_block(); // decompress on this thread, hashing thread only reads it
+      // next block is linked against id from artifacts, so a damaged block is not reported again as broken link of its successor
+      previous_block_id = artifacts_block_id;
+      result.blocks.push_back(std::move(full_block));
+    }
+    catch (const fc::exception &e)
+    {
+      result.errors.push_back("block " + std::to_string(block_num) + ": cannot be decoded: " + e.to_string());
+      previous_block_id = artifacts_block_id;
+    }
+  };
+
+  const uint32_t head_block_num = log.head()->get_block_num();
+  const uint32_t last_block_num_from_disk = range_last == head_block_num ? range_last - 1 : range_last;
+  if (range_first <= last_block_num_from_disk)
+  {
+    hive::chain::block_log_artifacts::artifact_container_t plural_of_block_artifacts;
+    log.multi_read_raw_block_data(range_first, last_block_num_from_disk, plural_of_block_artifacts, block_data_buffer, block_data_buffer_size);
+    const uint64_t first_block_offset = plural_of_block_artifacts.front().block_log_file_pos;
+    uint32_t block_num = range_first;
+    for (const auto &artifacts : plural_of_block_artifacts)
+    {
+      std::unique_ptr<char[]> block_data(new char[artifacts.block_serialized_data_size]);
+      memcpy(block_data.get(), block_data_buffer.get() + (artifacts.block_log_file_pos - first_block_offset), artifacts.block_serialized_data_size);
+      if (artifacts.attributes.flags == hive::chain::block_log::block_flags::uncompressed)
+        verify_block(hive::chain::full_block_type::create_from_uncompressed_block_data(std::move(block_data), artifacts.block_serialized_data_size), block_num, artifacts.block_id);
+      else
+        verify_block(hive::chain::full_block_type::create_from_compressed_block_data(std::move(block_data), artifacts.block_serialized_data_size, artifacts.attributes), block_num, artifacts.block_id);
+      ++block_num;
+    }
+  }
+  if (range_last == head_block_num)
+  {
+    auto [block_data, block_size, attributes] = log.read_raw_head_block();
+    const hive::chain::block_id_type artifacts_block_id = log.read_block_id_by_num(head_block_num);
+    if (attributes.flags == hive::chain::block_log::block_flags::uncompressed)
+      verify_block(hive::chain::full_block_type::create_from_uncompressed_block_data(std::move(block_data), block_size), head_block_num, artifacts_block_id);
+    else
+      verify_block(hive::chain::full_block_type::create_from_compressed_block_data(std::move(block_data), block_size, attributes), head_block_num, artifacts_block_id);
+  }
+  return result;
+}
+
+/**
+ * Produces the same checksums as checksum_block_log, but decompression and verification of blocks against artifacts is done on
+ * `verification_threads_num` threads, each handling separate range of blocks. Only feeding the (inherently sequential) sha256
+ * stream is done in order, on the calling thread.
+ */
+ExitCode verify_block_log_integrity(const fc::path &block_log, fc::optional<uint32_t> checkpoint_every_n_blocks, unsigned verification_threads_num,
+  appbase::application &app, hive::chain::blockchain_worker_thread_pool &thread_pool, const bool json_output)
+{
+  try
+  {
+    hive::chain::block_log log(app);
+    log.open(block_log, thread_pool, true);
+    FC_ASSERT(log.head(), "Cannot operate on empty block_log");
+
+    const uint32_t first_block_num = block_log_info::get_first_block_num_for_file_name(block_log);
+    const uint32_t head_block_num = log.head()->get_block_num();
+    constexpr uint32_t BLOCKS_PER_RANGE = 1000;
+    const uint32_t range_count = (head_block_num - first_block_num) / BLOCKS_PER_RANGE + 1;
+    if (!verification_threads_num)
+      verification_threads_num = std::max(1u, std::thread::hardware_concurrency());
+    // limits memory used by decoded blocks waiting for hashing
+    const uint32_t max_ranges_ahead = 4 * verification_threads_num;
+
+    ilog("Verifying integrity of ${block_log} (blocks ${first_block_num} - ${head_block_num}) using ${verification_threads_num} threads",
+      (block_log)(first_block_num)(head_block_num)(verification_threads_num));
+
+    std::mutex results_mutex;
+    std::condition_variable results_condition;
+    std::map<uint32_t, integrity_range_result> results;
+    uint32_t next_range_to_hash = 0;
+    std::atomic<uint32_t> next_range_to_verify = { 0 };
+    bool stop_requested = false;
+    std::exception_ptr worker_exception;
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < verification_threads_num; ++i)
+      workers.emplace_back([&]()
+      {
+        fc::set_thread_name("verify_integrity"); // tells the OS the thread's name
+        fc::thread::current().set_name("verify_integrity"); // tells fc the thread's name for logging
+        std::unique_ptr<char[]> block_data_buffer;
+        size_t block_data_buffer_size = 0;
+        while (true)
+        {
+          const uint32_t range_index = next_range_to_verify.fetch_add(1);
+          if (range_index >= range_count)
+            return;
+          {
+            std::unique_lock<std::mutex> lock(results_mutex);
+            results_condition.wait(lock, [&]() { return stop_requested || range_index < next_range_to_hash + max_ranges_ahead; });
+            if (stop_requested)
+              return;
+          }
+
+          integrity_range_result result;
+          try
+          {
+            const uint32_t range_first = first_block_num + range_index * BLOCKS_PER_RANGE;
+            const uint32_t range_last = std::min(range_first + BLOCKS_PER_RANGE - 1, head_block_num);
+            result = verify_block_range_integrity(log, first_block_num, range_first, range_last, block_data_buffer, block_data_buffer_size);
+          }
+          catch (...)
+          {
+            std::unique_lock<std::mutex> lock(results_mutex);
+            if (!worker_exception)
+              worker_exception = std::current_exception();
+            stop_requested = true;
+            results_condition.notify_all();
+            return;
+          }
+
+          {
+            std::unique_lock<std::mutex> lock(results_mutex);
+            results.emplace(range_index, std::move(result));
+          }
+          results_condition.notify_all();
+        }
+      });
+
+    uint64_t uncompressed_block_start_offset = 0; // as we go, keep track of the block's starting offset if it were recorded uncompressed
+    fc::sha256::encoder block_log_sha256_encoder;
+    size_t error_count = 0;
+
+    for (uint32_t range_index = 0; range_index < range_count; ++range_index)
+    {
+      integrity_range_result result;
+      {
+        std::unique_lock<std::mutex> lock(results_mutex);
+        results_condition.wait(lock, [&]() { return stop_requested || results.count(range_index); });
+        if (stop_requested)
+          break;
+        auto result_it = results.find(range_index);
+        result = std::move(result_it->second);
+        results.erase(result_it);
+        ++next_range_to_hash;
+      }
+      results_condition.notify_all();
+
+      for (const std::string &error : result.errors)
+      {
+        elog("${block_log}: ${error}", (block_log)(error));
+        if (!json_output)
+          std::cerr << "Error: " << block_log.generic_string() << ": " << error << "\n";
+      }
+      error_count += result.errors.size();
+
+      for (const auto &full_block : result.blocks)
+      {
+        if (full_block->get_block_num() % 1000000 == 0)
+          dlog("processed block ${current} of ${total}", ("current", full_block->get_block_num())("total", head_block_num));
+
+        append_full_block_data(full_block, uncompressed_block_start_offset, block_log_sha256_encoder);
+
+        if (!json_output && checkpoint_every_n_blocks && full_block->get_block_num() % *checkpoint_every_n_blocks == 0 && full_block->get_block_num() != head_block_num)
+        {
+          fc::sha256::encoder block_log_encoder_up_to_this_block(block_log_sha256_encoder);
+          ilog("${result} ${block_log}@${block_num}", ("result", block_log_encoder_up_to_this_block.result().str())(block_log)("block_num", full_block->get_block_num()));
+          std::cout << block_log_encoder_up_to_this_block.result().str() << " " << block_log.generic_string() << "@" << full_block->get_block_num() << "\n";
+        }
+      }
+    }
+
+    for (auto &worker : workers)
+      worker.join();
+    if (worker_exception)
+      std::rethrow_exception(worker_exception);
+
+    fc::sha256 final_hash = block_log_sha256_encoder.result();
+
+    ilog("Final hash: ${final_hash} ${block_log}, blocks failing verification: ${error_count}", ("final_hash", final_hash.str())(block_log)(error_count));
+    if (json_output)
+    {
+      std::cout << generate_json_output({
+        { "final_hash", fc::variant(final_hash) },
+        { "block_log", fc::variant(block_log) },
+        { "errors", fc::variant(error_count) }
+      });
+    }
+    else
+      std::cout << final_hash.str() << " " << block_log.generic_string() << "\n";
+
+    return error_count ? ExitCode::BlockLogInvalid : ExitCode::Ok;
+  }
+  FC_LOG_AND_RETHROW()
+}
+
 bool validate_block_log_checksum(const fc::path &block_log, const block_log_hashes &hashes_to_validate, appbase::application &app, hive::chain::blockchain_worker_thread_pool &thread_pool)
 {
   try
@@ -744,8 +968,8 @@ fc::optional<uint64_t> is_data_at_file_position_a_plausible_offset_and_flags(int
   bool dictionary_is_plausible;
   if (block_offset_with_flags & 0x0100000000000000ull)
   {
-    // if the dictionary flag bit is set, verify that the dictionary number is one that we have.
-    dictionary_is_plausible = *flags.dictionary_number <= hive::chain::get_last_available_zstd_compression_dictionary_number().value_or(0);
+    // if the dictionary flag bit is set, verify that the dictionary number is one that we have (or custom one).
+    dictionary_is_plausible = hive::chain::is_plausible_zstd_compression_dictionary_number(*flags.dictionary_number);
   }
   else
   {
@@ -1350,6 +1574,89 @@ ExitCode merge_block_logs(const fc::path &input_block_log_dir, const fc::path &o
   return ExitCode::Ok;
 }
 
+ExitCode convert_to_chunked(const fc::path &block_log_path, const int32_t first_block_arg, const int32_t last_block_arg, const fc::path &output_file,
+  const uint32_t blocks_per_chunk, const int zstd_level, appbase::application &app, hive::chain::blockchain_worker_thread_pool &thread_pool, const bool json_output)
+{
+  try
+  {
+    auto block_log_reader = get_block_log_wrapper(block_log_path, app, thread_pool, true/*read_only*/, false/*allow_artifacts_regeneration*/);
+    const uint32_t head_block_num = block_log_reader->head_block_num();
+    if (!head_block_num)
+    {
+      print_simple_error_or_result_message("Cannot operate on empty block_log", block_log_path, json_output, true);
+      return ExitCode::BlockLogInvalid;
+    }
+
+    const uint32_t tail_block_num = block_log_reader->get_actual_tail_block_num();
+    const auto [first_block, last_block] = get_effective_range_of_blocks(first_block_arg, last_block_arg, head_block_num, tail_block_num);
+    if (!validate_first_and_last_block_and_print_error_if_necessary(block_log_path, first_block, last_block, tail_block_num, head_block_num, json_output))
+      return ExitCode::BlocksRangeError;
+
+    if (!json_output)
+      std::cout << "Converting blocks " << first_block << " - " << last_block << " to chunked block log ...\n";
+    hive::chain::chunked_block_log::create_from_block_log(*block_log_reader, output_file, first_block, last_block, blocks_per_chunk, zstd_level);
+
+    hive::chain::chunked_block_log chunked_log(output_file);
+    chunked_log.verify();
+    if (json_output)
+      std::cout << generate_json_output({
+        {"Result", fc::variant("Conversion to chunked block log finished")},
+        {"output_file", fc::variant(output_file)},
+        {"chunks", fc::variant(chunked_log.get_chunks().size())},
+        {"file_size", fc::variant(fc::file_size(output_file))},
+        {"block_log_path", fc::variant(block_log_path)}
+      });
+    else
+      std::cout << "Conversion finished, " << chunked_log.get_chunks().size() << " chunks written to " << output_file.generic_string() << " (" << fc::file_size(output_file) << " bytes)\n";
+  }
+  FC_CAPTURE_AND_RETHROW()
+  return ExitCode::Ok;
+}
+
+ExitCode convert_from_chunked(const fc::path &chunked_file, const fc::path &output_dir, appbase::application &app, hive::chain::blockchain_worker_thread_pool &thread_pool, const bool json_output)
+{
+  try
+  {
+    {
+      hive::chain::chunked_block_log chunked_log(chunked_file);
+      if (chunked_log.tail_block_num() != 1)
+      {
+        print_simple_error_or_result_message("Chunked block log has to start at block 1 to be converted to legacy block_log file, it starts at block " + std::to_string(chunked_log.tail_block_num()), chunked_file, json_output, true);
+        return ExitCode::BlocksRangeError;
+      }
+    }
+
+    if (!fc::exists(output_dir))
+    {
+      dlog("Creating directories: ${output_dir}", (output_dir));
+      fc::create_directories(output_dir);
+    }
+    const fc::path output_file = output_dir / hive::chain::block_log_file_name_info::_legacy_file_name;
+    if (fc::exists(output_file))
+    {
+      print_simple_error_or_result_message(output_file.generic_string() + " already exists", chunked_file, json_output, true);
+      return ExitCode::InvalidArgumentError;
+    }
+    const auto block_log_writer = hive::chain::block_log_wrapper::create_opened_wrapper(output_file, app, thread_pool, false /*read_only*/, false /*allow_artifacts_regeneration*/);
+
+    if (!json_output)
+      std::cout << "Converting chunked block log to " << output_file.generic_string() << " ...\n";
+    hive::chain::chunked_block_log::write_to_block_log(chunked_file, *block_log_writer, thread_pool);
+    block_log_writer->close_storage();
+
+    if (json_output)
+      std::cout << generate_json_output({
+        {"Result", fc::variant("Conversion from chunked block log finished")},
+        {"output_dir", fc::variant(output_dir)},
+        {"block_log_path", fc::variant(chunked_file)}
+      });
+    else
+      std::cout << "Conversion finished.\n";
+  }
+  FC_CAPTURE_AND_RETHROW()
+  return ExitCode::Ok;
+}
+
 int main(int argc, char **argv)
 {
   boost::program_options::options_description minor_options("Minor options");
@@ -1358,9 +1665,11 @@ int main(int argc, char **argv)
   minor_options.add_options()("version,v", "Print version info.");
   minor_options.add_options()("log-path,l", boost::program_options::value<boost::filesystem::path>()->value_name("filename")->default_value("./block_log_util.log"), "Path to log file. All logs are saved into this file.");
   minor_options.add_options()("json", "Output will give just a json response with result of operation.");
+  minor_options.add_options()("compression-dictionaries", boost::program_options::value<boost::filesystem::path>()->value_name("filename"), "The file with custom compression dictionaries (made by compress_block_log --train-dictionaries), needed to read block logs compressed with them.");
 
   boost::program_options::options_description block_log_operations("block_log operations");
   block_log_operations.add_options()("block-log,i", boost::program_options::value<boost::filesystem::path>(), "Path to input block-log or directory with split block log for processing, depending on the operation opening in read only (RO) or read & write (RW) mode. Artifacts are required for all operations, expect 'generate-artifacts', 'find-end', 'get-head-block-number'");
+  block_log_operations.add_options()("convert-to-chunked", "Write range of blocks into new chunked block log file (blocks grouped into chunks compressed together, for archive storage). (Block_log opened in RO mode) (operate both on single block log or directory with split block log)");
   block_log_operations.add_options()("compare", "Compare input block_log with another block_log. (Both block_logs opened in RO mode) (operate both on single block log or directory with split block log)");
   block_log_operations.add_options()("find-end", "Check if input block_log is not corrupted. Finds out place where last full block is successfully stored in block_log and proposes block_log truncation if recommended. (single block_log operation)");
   block_log_operations.add_options()("generate-artifacts", "Open input block_log in read & write mode and generate artifacts file if necessary. (operate both on single block log or directory with split block log)");
@@ -1369,12 +1678,17 @@ int main(int argc, char **argv)
   block_log_operations.add_options()("get-block-ids", "Get range of blocks ids. (Block_log opened in RO mode) (operate both on single block log or directory with split block log)");
   block_log_operations.add_options()("get-head-block-number", "Get block_log head block number. (Block_log opened in RO mode) (operate both on single block log or directory with split block log)");
   block_log_operations.add_options()("sha256sum", "Verify sha256 checksums in block-log. (Block_log opened in RO mode) (single block_log operation)");
+  block_log_operations.add_options()("verify-integrity", "Compute the same sha256 checksums as sha256sum, additionally verifying block ids, merkle roots and links between blocks against artifacts. Blocks are decompressed and verified on multiple threads. (Block_log opened in RO mode) (single block_log operation)");
   block_log_operations.add_options()("split", "Split legacy monolithic block log file into new-style multiple part files.");
   block_log_operations.add_options()("truncate", "Truncate block log to given block number. (single block_log operation)");
 
   boost::program_options::options_description additional_operations("additional operations");
   additional_operations.add_options()("verify-checksums-from-file", boost::program_options::value<boost::filesystem::path>()->value_name("filename"), "Verify sha256 from text file.");
   additional_operations.add_options()("merge-block-logs", "Merge new-style split block log part files into legacy monolithic single file.");
+  additional_operations.add_options()("convert-from-chunked", boost::program_options::value<boost::filesystem::path>()->value_name("filename"), "Convert chunked block log file (starting at block 1) back into legacy monolithic single file.");
+
+  boost::program_options::options_description convert_from_chunked_options("convert-from-chunked options");
+  convert_from_chunked_options.add_options()("output-dir,o", boost::program_options::value<boost::filesystem::path>()->value_name("directory"), "Directory where block_log file should be created.");
 
   boost::program_options::options_description merge_block_logs_options("merge-block-logs options");
   merge_block_logs_options.add_options()("input,i", boost::program_options::value<boost::filesystem::path>()->value_name("directory"), "Directory containing split block log part files to be merged. Can be the same as --output");
@@ -1385,6 +1699,11 @@ int main(int argc, char **argv)
   boost::program_options::options_description sha256sum_options("sha256sum options");
   sha256sum_options.add_options()("checkpoint", boost::program_options::value<uint32_t>()->value_name("n"), "Print the SHA256 every n blocks");
 
+  // args for verify-integrity subcommand
+  boost::program_options::options_description verify_integrity_options("verify-integrity options");
+  verify_integrity_options.add_options()("checkpoint", boost::program_options::value<uint32_t>()->value_name("n"), "Print the SHA256 every n blocks");
+  verify_integrity_options.add_options()("verification-threads", boost::program_options::value<unsigned>()->value_name("t")->default_value(0), "Number of threads verifying blocks. 0 means one per CPU core.");
+
   // args for compare subcommand
   boost::program_options::options_description cmp_options("compare options");
   cmp_options.add_options()("second-block-log", boost::program_options::value<boost::filesystem::path>(), "The second block log");
@@ -1421,6 +1740,14 @@ int main(int argc, char **argv)
   get_block_artifacts_options.add_options()("header-only", "only print the artifacts header");
   get_block_artifacts_options.add_options()("do-full-artifacts-verification-match-check", "Performs check if all artifacts from file matches block_log");
 
+  // args for convert-to-chunked subcommand
+  boost::program_options::options_description convert_to_chunked_options("convert-to-chunked options");
+  convert_to_chunked_options.add_options()("output-file,o", boost::program_options::value<boost::filesystem::path>()->value_name("filename"), "Path of chunked block log file to create.");
+  convert_to_chunked_options.add_options()("from", boost::program_options::value<int32_t>()->value_name("n"), "First block to convert. Negative numbers mean distance from end (-1 is head block). Defaults to first block of input block_log.");
+  convert_to_chunked_options.add_options()("to", boost::program_options::value<int32_t>()->value_name("m"), "Last block to convert (inclusive). Negative numbers mean distance from end (-1 is head block). Defaults to -1.");
+  convert_to_chunked_options.add_options()("blocks-per-chunk", boost::program_options::value<uint32_t>()->value_name("c")->default_value(1000), "Number of blocks compressed together. Bigger chunks compress better, but reading single block requires decompressing whole chunk.");
+  convert_to_chunked_options.add_options()("zstd-level", boost::program_options::value<int>()->value_name("l")->default_value(15), "zstd compression level of chunks.");
+
   // args for split subcommand
   boost::program_options::options_description split_block_log_options("split options");
   split_block_log_options.add_options()("output-dir,o", boost::program_options::value<boost::filesystem::path>()->value_name("directory"), "Directory where block_log files will be stored.");
@@ -1444,13 +1771,16 @@ int main(int argc, char **argv)
     std::cout << block_log_operations << "\n";
     std::cout << additional_operations << "\n";
     std::cout << cmp_options << "\n";
+    std::cout << convert_to_chunked_options << "\n";
     std::cout << get_block_options << "\n";
     std::cout << get_block_artifacts_options << "\n";
     std::cout << get_block_ids_options << "\n";
     std::cout << sha256sum_options << "\n";
+    std::cout << verify_integrity_options << "\n";
     std::cout << split_block_log_options << "\n";
     std::cout << truncate_options << "\n";
     std::cout << merge_block_logs_options << "\n";
+    std::cout << convert_from_chunked_options << "\n";
   };
 
   try
@@ -1524,6 +1854,21 @@ int main(int argc, char **argv)
 
     options_map.erase("jobs");
 
+    if (options_map.count("compression-dictionaries"))
+    {
+      const fc::path dictionaries_file = options_map["compression-dictionaries"].as<boost::filesystem::path>();
+      options_map.erase("compression-dictionaries");
+      try
+      {
+        hive::chain::load_custom_zstd_compression_dictionaries(dictionaries_file);
+      }
+      catch (const fc::exception& e)
+      {
+        print_and_log_error("Cannot load custom compression dictionaries: " + e.to_string(), json_output);
+        return ExitCode::InvalidArgumentError;
+      }
+    }
+
     if (options_map.count("version"))
     {
       print_version();
@@ -1605,6 +1950,36 @@ int main(int argc, char **argv)
       dlog("block_log_util will perform merge block logs operation. Input directory: ${input_block_log_files_dir}, output directory: ${output_block_log_file_dir}, block-number: ${max_block_number}", (input_block_log_files_dir)(output_block_log_file_dir)(max_block_number));
       return merge_block_logs(input_block_log_files_dir, output_block_log_file_dir, max_block_number, se.the_app, se.thread_pool, json_output);
     }
+    else if (options_map.count("convert-from-chunked"))
+    {
+      update_options_map(convert_from_chunked_options);
+      const fc::path chunked_file = options_map["convert-from-chunked"].as<boost::filesystem::path>();
+      options_map.erase("convert-from-chunked");
+
+      if (!options_map.count("output-dir"))
+      {
+        print_and_log_error("output-dir must be specified for convert-from-chunked operation", json_output);
+        return ExitCode::InvalidArgumentError;
+      }
+      const fc::path output_dir = options_map["output-dir"].as<boost::filesystem::path>();
+      options_map.erase("output-dir");
+
+      if (!options_map.empty())
+      {
+        print_and_log_error("You cannot perform block_log operation if you requested to perform one of additional operations (ambiguous arguments). Unnecessary arguments: " + get_arguments_as_string(options_map), json_output);
+        return ExitCode::InvalidArgumentError;
+      }
+      if (!fc::exists(chunked_file))
+      {
+        print_and_log_error(chunked_file.string() + " does not exist (input chunked block log)", json_output);
+        return ExitCode::InvalidArgumentError;
+      }
+
+      shutdown_executor se(threads_num);
+
+      dlog("block_log_util will perform convert-from-chunked operation. Input file: ${chunked_file}, output directory: ${output_dir}", (chunked_file)(output_dir));
+      return convert_from_chunked(chunked_file, output_dir, se.the_app, se.thread_pool, json_output);
+    }
     // we should handle operation which request block_log file
     else
     {
@@ -1844,6 +2219,54 @@ int main(int argc, char **argv)
         dlog("block_log_util will perform sha256sum operation on block_log: ${block_log_path}, checkpoint_every_n_blocks: ${checkpoint_every_n_blocks}", (block_log_path)(checkpoint_every_n_blocks));
         return checksum_block_log(block_log_path, checkpoint_every_n_blocks, se.the_app, se.thread_pool, json_output);
       }
+      else if (options_map.count("convert-to-chunked"))
+      {
+        if (!input_block_log_is_directory && artifacts_file_is_not_valid(block_log_path, json_output))
+          return ExitCode::ArtifactsFileNotValid;
+        update_options_map(convert_to_chunked_options);
+        if (!options_map.count("output-file"))
+        {
+          print_and_log_error("Missing \'--output-file\' for convert-to-chunked operation", json_output);
+          return ExitCode::InvalidArgumentError;
+        }
+        const fc::path output_file = options_map["output-file"].as<boost::filesystem::path>();
+        if (fc::exists(output_file))
+        {
+          print_and_log_error(output_file.string() + " already exists", json_output);
+          return ExitCode::InvalidArgumentError;
+        }
+        const uint32_t blocks_per_chunk = options_map["blocks-per-chunk"].as<uint32_t>();
+        if (blocks_per_chunk == 0)
+        {
+          print_and_log_error("'--blocks-per-chunk' cannot be 0", json_output);
+          return ExitCode::InvalidArgumentError;
+        }
+        const int zstd_level = options_map["zstd-level"].as<int>();
+
+        if (blocks_range_options_is_wrong())
+          return ExitCode::InvalidArgumentError;
+        const auto [first_block, last_block] = get_first_and_last_block_from_options();
+        dlog("block_log_util will perform convert-to-chunked operation on block_log: ${block_log_path}, from: ${first_block}, to: ${last_block}, output_file: ${output_file}, blocks_per_chunk: ${blocks_per_chunk}, zstd_level: ${zstd_level}",
+             (block_log_path)(first_block)(last_block)(output_file)(blocks_per_chunk)(zstd_level));
+        return convert_to_chunked(block_log_path, first_block, last_block, output_file, blocks_per_chunk, zstd_level, se.the_app, se.thread_pool, json_output);
+      }
+      else if (options_map.count("verify-integrity"))
+      {
+        if (input_block_log_is_directory)
+        {
+          print_and_log_error("verify-integrity operation accepts only single block_log", json_output);
+          return ExitCode::InvalidArgumentError;
+        }
+        if (artifacts_file_is_not_valid(block_log_path, json_output))
+          return ExitCode::ArtifactsFileNotValid;
+
+        update_options_map(verify_integrity_options);
+        const fc::optional<uint32_t> checkpoint_every_n_blocks = options_map.count("checkpoint") ? options_map["checkpoint"].as<uint32_t>() : fc::optional<uint32_t>();
+        const unsigned verification_threads_num = options_map["verification-threads"].as<unsigned>();
+        dlog("block_log_util will perform verify-integrity operation on block_log: ${block_log_path}, checkpoint_every_n_blocks: ${checkpoint_every_n_blocks}, verification_threads_num: ${verification_threads_num}",
+             (block_log_path)(checkpoint_every_n_blocks)(verification_threads_num));
+        return verify_block_log_integrity(block_log_path, checkpoint_every_n_blocks, verification_threads_num, se.the_app, se.thread_pool, json_output);
+      }
       else if (options_map.count("split"))
       {
         if (input_block_log_is_directory)
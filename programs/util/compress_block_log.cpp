@@ -22,11 +22,14 @@
 #include <mutex>
 #include <condition_variable>
 #include <queue>
+#include <functional>
+#include <limits>
 
 #ifndef ZSTD_STATIC_LINKING_ONLY
 # define ZSTD_STATIC_LINKING_ONLY
 #endif
 #include <zstd.h>
+#include <zdict.h>
 
 #undef dlog
 #define dlog(...) do {} while(0)
@@ -419,6 +422,133 @@ void do_job(const fc::path& input_block_log_path, const fc::path& output_block_l
   }
 }
 
+struct dictionary_evaluation
+{
+  uint64_t compressed_size = 0;
+  fc::microseconds decompression_time;
+};
+
+void evaluate_dictionary(dictionary_evaluation& evaluation, const std::vector<block_to_compress>& blocks, std::function<std::optional<uint8_t>(uint32_t)> get_dictionary_number)
+{
+  ZSTD_CCtx* zstd_compression_context = ZSTD_createCCtx();
+  ZSTD_DCtx* zstd_decompression_context = ZSTD_createDCtx();
+  for (const block_to_compress& block : blocks)
+  {
+    std::optional<uint8_t> dictionary_number = get_dictionary_number(block.block_number);
+    auto compressed = hive::chain::block_log_compression::compress_block_zstd(block.uncompressed_block_data.get(), block.uncompressed_block_size,
+      dictionary_number, zstd_level, zstd_compression_context);
+    evaluation.compressed_size += std::get<1>(compressed);
+
+    fc::time_point before = fc::time_point::now();
+    hive::chain::block_log_compression::decompress_block_zstd(std::get<0>(compressed).get(), std::get<1>(compressed),
+      dictionary_number, zstd_decompression_context);
+    evaluation.decompression_time += fc::time_point::now() - before;
+  }
+  ZSTD_freeCCtx(zstd_compression_context);
+  ZSTD_freeDCtx(zstd_decompression_context);
+}
+
+/**
+ * Trains separate zstd dictionary for each range of blocks (on evenly spaced sample of blocks from that range),
+ * then compares it with built-in dictionary on a disjoint sample (so the result is not skewed by blocks that were
+ * used to train the dictionary). Trained dictionaries are saved to side file that can be then passed to compression
+ * (--compression-dictionaries) and to hived (block-log-compression-dictionaries).
+ */
+void train_dictionaries(const fc::path& input_path, const bool read_only, const fc::path& dictionaries_path, uint32_t range_size,
+  size_t dictionary_size, uint32_t samples_per_range, appbase::application& app, hive::chain::blockchain_worker_thread_pool& thread_pool)
+{
+  FC_ASSERT(range_size > 0 && dictionary_size > 0 && samples_per_range > 0);
+  auto log_reader = hive::chain::block_log_wrapper::create_opened_wrapper( input_path, app, thread_pool, read_only, false /*allow_artifacts_regeneration*/ );
+  if (!log_reader->head_block())
+    FC_THROW("input block log is empty");
+
+  uint32_t head_block_num = log_reader->head_block_num();
+  uint32_t stop_at_block = blocks_to_compress ? std::min(starting_block_number + *blocks_to_compress - 1, head_block_num) : head_block_num;
+  std::optional<uint8_t> last_builtin_dictionary = hive::chain::get_last_available_zstd_compression_dictionary_number();
+
+  auto read_block = [&](uint32_t block_number) -> block_to_compress
+  {
+    block_to_compress block;
+    block.block_number = block_number;
+    std::tie(block.uncompressed_block_data, block.uncompressed_block_size) =
+      hive::chain::block_log_compression::decompress_raw_block(log_reader->read_common_raw_block_data_by_num(block_number));
+    return block;
+  };
+
+  std::vector<hive::chain::custom_zstd_dictionary> dictionaries;
+  uint32_t dictionary_number = HIVE_FIRST_CUSTOM_ZSTD_DICTIONARY_NUMBER;
+  for (uint32_t range_start = starting_block_number; range_start <= stop_at_block; range_start += std::min(range_size, stop_at_block - range_start + 1))
+  {
+    FC_ASSERT(dictionary_number <= std::numeric_limits<uint8_t>::max(), "Too many block ranges, use larger --dictionary-range-size");
+    uint32_t range_end = range_start + std::min(range_size - 1, stop_at_block - range_start);
+
+    // every other sampled block goes to training set, the rest is used for evaluation
+    uint32_t step = std::max<uint32_t>(1, (range_end - range_start + 1) / (2 * samples_per_range));
+    std::vector<block_to_compress> training_blocks;
+    std::vector<block_to_compress> evaluation_blocks;
+    for (uint32_t block_number = range_start, i = 0; block_number <= range_end && training_blocks.size() < samples_per_range; block_number += step, ++i)
+    {
+      if (i % 2 == 0)
+        training_blocks.push_back(read_block(block_number));
+      else
+        evaluation_blocks.push_back(read_block(block_number));
+    }
+
+    std::vector<char> samples;
+    std::vector<size_t> sample_sizes;
+    for (const block_to_compress& block : training_blocks)
+    {
+      samples.insert(samples.end(), block.uncompressed_block_data.get(), block.uncompressed_block_data.get() + block.uncompressed_block_size);
+      sample_sizes.push_back(block.uncompressed_block_size);
+    }
+
+    hive::chain::custom_zstd_dictionary dictionary;
+    dictionary.dictionary_number = dictionary_number;
+    dictionary.first_block = range_start;
+    dictionary.last_block = range_end;
+    dictionary.dictionary.resize(dictionary_size);
+    size_t trained_size = ZDICT_trainFromBuffer(dictionary.dictionary.data(), dictionary.dictionary.size(),
+                                                samples.data(), sample_sizes.data(), sample_sizes.size());
+    if (ZDICT_isError(trained_size))
+    {
+      // too few/too small samples (typical for very early blocks) - such range stays with built-in dictionary
+      wlog("Unable to train dictionary for blocks ${range_start}-${range_end}: ${error}", (range_start)(range_end)("error", ZDICT_getErrorName(trained_size)));
+      continue;
+    }
+    dictionary.dictionary.resize(trained_size);
+
+    dictionary_evaluation without_dictionary;
+    dictionary_evaluation with_builtin;
+    dictionary_evaluation with_trained;
+    evaluate_dictionary(without_dictionary, evaluation_blocks, [](uint32_t) { return std::optional<uint8_t>(); });
+    if (last_builtin_dictionary)
+      evaluate_dictionary(with_builtin, evaluation_blocks, [&](uint32_t block_number) { return std::optional<uint8_t>(std::min<uint8_t>(block_number / 1000000, *last_builtin_dictionary)); });
+    hive::chain::register_custom_zstd_compression_dictionary(dictionary);
+    evaluate_dictionary(with_trained, evaluation_blocks, [&](uint32_t) { return std::optional<uint8_t>(dictionary.dictionary_number); });
+
+    uint64_t uncompressed_size = 0;
+    for (const block_to_compress& block : evaluation_blocks)
+      uncompressed_size += block.uncompressed_block_size;
+    size_t evaluated_blocks = std::max<size_t>(1, evaluation_blocks.size());
+    ilog("Dictionary ${dictionary_number} (${trained_size} bytes) for blocks ${range_start}-${range_end}, evaluated on ${count} blocks (${uncompressed_size} bytes):",
+         ("dictionary_number", dictionary.dictionary_number)(trained_size)(range_start)(range_end)("count", evaluation_blocks.size())(uncompressed_size));
+    ilog("    no dictionary: ${size} bytes, average decompression time per block: ${time}μs",
+         ("size", without_dictionary.compressed_size)("time", without_dictionary.decompression_time.count() / evaluated_blocks));
+    if (last_builtin_dictionary)
+      ilog("    built-in dictionary: ${size} bytes, average decompression time per block: ${time}μs",
+           ("size", with_builtin.compressed_size)("time", with_builtin.decompression_time.count() / evaluated_blocks));
+    ilog("    trained dictionary: ${size} bytes, average decompression time per block: ${time}μs",
+         ("size", with_trained.compressed_size)("time", with_trained.decompression_time.count() / evaluated_blocks));
+
+    dictionaries.push_back(std::move(dictionary));
+    ++dictionary_number;
+  }
+
+  log_reader->close_storage();
+  hive::chain::save_custom_zstd_compression_dictionaries(dictionaries_path, dictionaries);
+  ilog("Saved ${count} trained dictionaries to ${dictionaries_path}", ("count", dictionaries.size())(dictionaries_path));
+}
+
 int main(int argc, char** argv)
 {
   try
@@ -438,11 +568,16 @@ int main(int argc, char** argv)
     options.add_options()("jobs,j", boost::program_options::value<int>()->default_value(1), "The number of threads to use for compression");
     options.add_options()("input-block-log,i", boost::program_options::value<std::string>(), "The file (or 1st file when split) containing the input block log. Has rights to read and write.");
     options.add_options()("input-read-only-block-log", boost::program_options::value<std::string>(), "The file (or 1st file when split) containing the input block log. Read only mode.");
-    options.add_options()("output-block-log,o", boost::program_options::value<std::string>()->required(), "The file (or 1st file when split) to contain the compressed block log");
+    options.add_options()("output-block-log,o", boost::program_options::value<std::string>(), "The file (or 1st file when split) to contain the compressed block log");
     options.add_options()("dump-raw-blocks", boost::program_options::value<std::string>(), "A directory in which to dump raw, uncompressed blocks (one block per file)");
     options.add_options()("starting-block-number,s", boost::program_options::value<uint32_t>()->default_value(1), "Start at the given block number (for benchmarking only, values > 1 will generate an unusable block log)");
     options.add_options()("block-count,n", boost::program_options::value<uint32_t>(), "Stop after this many blocks");
     options.add_options()("use-compressed-even-when-larger", boost::program_options::bool_switch()->default_value(true), "Store the compressed version of the blocks, even when larger than the uncompressed version");
+    options.add_options()("compression-dictionaries", boost::program_options::value<std::string>(), "The file with custom dictionaries (made by --train-dictionaries) to use in addition to built-in ones");
+    options.add_options()("train-dictionaries", boost::program_options::value<std::string>(), "Instead of compressing the block log, train dictionary per range of blocks, report how it compares to built-in dictionary and save them to given file");
+    options.add_options()("dictionary-range-size", boost::program_options::value<uint32_t>()->default_value(1000000), "The number of blocks covered by each trained dictionary");
+    options.add_options()("dictionary-size", boost::program_options::value<uint32_t>()->default_value(220 * 1024), "The maximum size of each trained dictionary");
+    options.add_options()("training-samples", boost::program_options::value<uint32_t>()->default_value(10000), "The number of blocks sampled from each range to train its dictionary (the same number is sampled for evaluation)");
 
     options.add_options()("help,h", "Print usage instructions");
 
@@ -468,14 +603,14 @@ int main(int argc, char** argv)
       return 0;
     }
 
-    if (!options_map.count("output-block-log"))
+    if (!options_map.count("output-block-log") && !options_map.count("train-dictionaries"))
     {
       std::cerr << "Error: missing parameter output-block-log\n";
       return 1;
     }
 
-    fc::path output_block_log_path = options_map["output-block-log"].as<std::string>();
-    if (fc::exists(output_block_log_path) &&
+    fc::path output_block_log_path = options_map.count("output-block-log") ? options_map["output-block-log"].as<std::string>() : std::string();
+    if (options_map.count("output-block-log") && fc::exists(output_block_log_path) &&
         (not fc::is_regular_file(output_block_log_path) ||
          not hive::chain::block_log_file_name_info::is_block_log_file_name(output_block_log_path)))
     {
@@ -513,6 +648,17 @@ int main(int argc, char** argv)
       return 1;
     }
 
+    if (options_map.count("compression-dictionaries"))
+      hive::chain::load_custom_zstd_compression_dictionaries(options_map["compression-dictionaries"].as<std::string>());
+
+    if (options_map.count("train-dictionaries"))
+    {
+      train_dictionaries(input_block_log_path, input_readonly, options_map["train-dictionaries"].as<std::string>(),
+        options_map["dictionary-range-size"].as<uint32_t>(), options_map["dictionary-size"].as<uint32_t>(),
+        options_map["training-samples"].as<uint32_t>(), theApp, thread_pool);
+      return 0;
+    }
+
     if (options_map.count("dump-raw-blocks"))
       raw_block_output_path = options_map["dump-raw-blocks"].as<std::string>();
 
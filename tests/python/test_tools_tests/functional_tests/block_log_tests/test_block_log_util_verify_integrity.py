@@ -0,0 +1,113 @@
+from __future__ import annotations
+
+import hashlib
+import re
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+import test_tools as tt
+
+CHECKPOINT_EVERY_N_BLOCKS = 10
+DAMAGED_BLOCK_NUMBER = 17
+
+
+@pytest.fixture
+def uncompressed_block_log(tmp_path: Path) -> Path:
+    node = tt.InitNode()
+    # uncompressed monolithic block log holds exactly the bytes that verify-integrity hashes
+    node.config.enable_block_log_compression = False
+    node.config.block_log_split = -1
+    node.run(time_control=tt.SpeedUpRateTimeControl(speed_up_rate=10))
+    node.wait_for_block_with_number(35)
+    node.close()
+
+    block_log = node.block_log.block_files[0]
+    shutil.copy(block_log, tmp_path / "block_log")
+    shutil.copy(block_log.with_name(block_log.name + ".artifacts"), tmp_path / "block_log.artifacts")
+    return tmp_path / "block_log"
+
+
+def get_block_end_offsets(data: bytes) -> list[int]:
+    """Every block is followed by 8-byte position of its start, so walking back from the end of file gives end of each block."""
+    ends = []
+    end = len(data)
+    while end > 0:
+        position_and_flags = int.from_bytes(data[end - 8 : end], "little")
+        assert position_and_flags >> 56 == 0, "block log is expected to be uncompressed"
+        ends.append(end)
+        end = position_and_flags & ((1 << 56) - 1)
+    ends.reverse()
+    return ends  # ends[n - 1] is end of block n
+
+
+def run_verify_integrity(block_log: Path) -> subprocess.CompletedProcess[str]:
+    return subprocess.run(
+        [
+            tt.paths_to_executables.get_path_of("block_log_util"),
+            "--verify-integrity",
+            "--block-log",
+            str(block_log),
+            "--checkpoint",
+            str(CHECKPOINT_EVERY_N_BLOCKS),
+            "--verification-threads",
+            "2",
+        ],
+        cwd=block_log.parent,
+        capture_output=True,
+        text=True,
+        check=False,
+    )
+
+
+def parse_hashes(stdout: str, block_log: Path) -> tuple[dict[int, str], str | None]:
+    checkpoints = {}
+    final_hash = None
+    for line in stdout.splitlines():
+        match = re.fullmatch(rf"([0-9a-f]{{64}}) {re.escape(str(block_log))}(?:@(\d+))?", line.strip())
+        if match is None:
+            continue
+        if match.group(2) is None:
+            final_hash = match.group(1)
+        else:
+            checkpoints[int(match.group(2))] = match.group(1)
+    return checkpoints, final_hash
+
+
+def test_verify_integrity_hashes(uncompressed_block_log: Path) -> None:
+    data = uncompressed_block_log.read_bytes()
+    block_ends = get_block_end_offsets(data)
+    head_block_number = len(block_ends)
+
+    result = run_verify_integrity(uncompressed_block_log)
+    assert result.returncode == 0, result.stderr
+
+    checkpoints, final_hash = parse_hashes(result.stdout, uncompressed_block_log)
+    assert final_hash == hashlib.sha256(data).hexdigest()
+
+    expected_checkpoints = [
+        number for number in range(1, head_block_number) if number % CHECKPOINT_EVERY_N_BLOCKS == 0
+    ]
+    assert sorted(checkpoints) == expected_checkpoints
+    for number, checkpoint_hash in checkpoints.items():
+        assert checkpoint_hash == hashlib.sha256(data[: block_ends[number - 1]]).hexdigest(), f"checkpoint @{number}"
+
+
+def test_verify_integrity_reports_damaged_block(uncompressed_block_log: Path) -> None:
+    data = bytearray(uncompressed_block_log.read_bytes())
+    block_ends = get_block_end_offsets(bytes(data))
+    # flip a byte of timestamp (right after 20 bytes of previous block id) - block still decodes, but its id changes
+    damaged_block_start = block_ends[DAMAGED_BLOCK_NUMBER - 2]
+    data[damaged_block_start + 20] ^= 0xFF
+    uncompressed_block_log.write_bytes(data)
+
+    result = run_verify_integrity(uncompressed_block_log)
+    assert result.returncode != 0
+
+    reported_blocks = {int(number) for number in re.findall(r"^Error: .*?: block (\d+):", result.stderr, re.MULTILINE)}
+    assert reported_blocks == {DAMAGED_BLOCK_NUMBER}
+
+    # hashes still describe actual content of the file
+    _, final_hash = parse_hashes(result.stdout, uncompressed_block_log)
+    assert final_hash == hashlib.sha256(data).hexdigest()
@@ -3,11 +3,13 @@
 #include <hive/manifest/plugins.hpp>
 
 #include <hive/plugins/condenser_api/condenser_api_plugin.hpp>
+#include <hive/plugins/webserver/webserver_plugin.hpp>
 #include <hive/plugins/witness/witness_plugin.hpp>
 
 #include <hive/utilities/logging_config.hpp>
 #include <hive/utilities/options_description_ex.hpp>
 
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 namespace bpo = boost::program_options;
@@ -199,7 +201,14 @@ json_rpc_database_fixture::json_rpc_database_fixture()
 
   configuration_data.set_initial_asset_supply( INITIAL_TEST_SUPPLY, HBD_INITIAL_TEST_SUPPLY );
 
+  // socket file is not removed by webserver, and stale one would prevent it from listening
+  const fc::path unix_socket_path = hive::utilities::temp_directory_path() /
+    boost::filesystem::unique_path( "json_rpc_%%%%%%%%.sock" ).string();
+  fc::create_directories( unix_socket_path.parent_path() );
+  fc::remove( unix_socket_path );
+
   hive::plugins::condenser_api::condenser_api_plugin* denser_api_plugin = nullptr;
+  hive::plugins::webserver::webserver_plugin* webserver_plugin = nullptr;
   postponed_init(
     {
       config_line_t( { "plugin",
@@ -207,17 +216,25 @@ json_rpc_database_fixture::json_rpc_database_fixture()
           HIVE_JSON_RPC_PLUGIN_NAME,
           HIVE_BLOCK_API_PLUGIN_NAME,
           HIVE_DATABASE_API_PLUGIN_NAME,
-          HIVE_CONDENSER_API_PLUGIN_NAME } }
+          HIVE_CONDENSER_API_PLUGIN_NAME,
+          HIVE_WEBSERVER_PLUGIN_NAME } }
       ),
       config_line_t( { "shared-file-size",
         { std::to_string( 1024 * 1024 * shared_file_size_small ) } }
-      )
+      ),
+      config_line_t( { "webserver-unix-endpoint", { unix_socket_path.string() } } ),
+      config_line_t( { "webserver-thread-pool-size", { "2" } } )
     },
     &ah_plugin,
     &rpc_plugin,
-    &denser_api_plugin
+    &denser_api_plugin,
+    &webserver_plugin
   );
 
+  // work (and so automatic webserver start) is disabled in unit tests
+  webserver_plugin->start_webserver();
+  unix_client = std::make_unique< unix_socket_client >( unix_socket_path );
+
   init_account_pub_key = init_account_priv_key.get_public_key();
 
   generate_block();
@@ -245,7 +262,11 @@ json_rpc_database_fixture::json_rpc_database_fixture()
   return;
 }
 
-json_rpc_database_fixture::~json_rpc_database_fixture() {}
+json_rpc_database_fixture::~json_rpc_database_fixture()
+{
+  if( unix_client )
+    fc::remove( unix_client->get_socket_path() );
+}
 
 fc::variant json_rpc_database_fixture::get_answer( std::string& request )
 {
@@ -365,6 +386,22 @@ void json_rpc_database_fixture::make_positive_request( std::string& request )
   make_request( request, 0/*code*/, false/*is_warning*/, false/*is_fail*/);
 }
 
+std::vector< char > json_rpc_database_fixture::make_binary_request( const std::string& method, const std::vector< char >& packed_args )
+{
+  std::string result = unix_client->post( "/" + method, "application/octet-stream", std::string( packed_args.begin(), packed_args.end() ) );
+  return std::vector< char >( result.begin(), result.end() );
+}
+
+fc::variant json_rpc_database_fixture::make_unix_socket_request( const std::string& request )
+{
+  return fc::json::from_string( unix_client->post( "/", "application/json", request ), fc::json::format_validation_mode::full );
+}
+
+fc::variant json_rpc_database_fixture::make_subscription_request( const std::string& request, const hive::plugins::json_rpc::subscription_sink& sink )
+{
+  return fc::json::from_string( rpc_plugin->call( request, sink ), fc::json::format_validation_mode::full );
+}
+
 bool hived_fixture::push_block( const std::shared_ptr<full_block_type>& b, uint32_t skip_flags /* = 0 */ )
 {
   return test::_push_block( get_chain_plugin(), b, skip_flags );
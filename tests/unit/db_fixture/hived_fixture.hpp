@@ -1,6 +1,7 @@
 #pragma once
 
 #include "database_fixture.hpp"
+#include "unix_socket_client.hpp"
 
 #include <fc/log/logger_config.hpp>
 
@@ -91,8 +92,11 @@ struct json_rpc_database_fixture : public hived_fixture
 {
   private:
     hive::plugins::json_rpc::json_rpc_plugin* rpc_plugin;
+    /// talks to webserver's unix endpoint (used by binary requests)
+    std::unique_ptr< unix_socket_client > unix_client;
 
     fc::variant get_answer( std::string& request );
+
     void review_answer( fc::variant& answer, int64_t code, bool is_warning, bool is_fail, fc::optional< fc::variant > id,
       const char* message = nullptr, const char* assert_hash = nullptr );
 
@@ -105,6 +109,12 @@ struct json_rpc_database_fixture : public hived_fixture
     fc::variant make_request( std::string& request, int64_t code = 0, bool is_warning = false, bool is_fail = true,
       const char* message = nullptr, const char* assert_hash = nullptr );
     void make_positive_request( std::string& request );
+    /// Calls binary (fc::raw) version of given "api.method" through webserver's unix endpoint
+    std::vector< char > make_binary_request( const std::string& method, const std::vector< char >& packed_args );
+    /// Sends JSON request through webserver's unix endpoint, returns whole answer
+    fc::variant make_unix_socket_request( const std::string& request );
+    /// Makes request as if it came over websocket, so subscription methods can push notifications into given sink
+    fc::variant make_subscription_request( const std::string& request, const hive::plugins::json_rpc::subscription_sink& sink );
 };
 
 } }
@@ -0,0 +1,73 @@
+#include "unix_socket_client.hpp"
+
+#include <fc/exception/exception.hpp>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+namespace hive { namespace chain {
+
+std::string unix_socket_client::post( const std::string& resource, const std::string& content_type, const std::string& body ) const
+{
+  boost::asio::io_context ios;
+  boost::asio::local::stream_protocol::socket socket( ios );
+  boost::asio::local::stream_protocol::endpoint endpoint( _socket_path.string() );
+
+  // webserver starts listening in its own thread, so right after its start the socket might not be there yet
+  boost::system::error_code ec;
+  for( int attempt = 0; attempt < 500; ++attempt )
+  {
+    socket.connect( endpoint, ec );
+    if( !ec )
+      break;
+    socket.close();
+    std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+  }
+  FC_ASSERT( !ec, "Could not connect to ${p}: ${e}", ( "p", _socket_path.string() )( "e", ec.message() ) );
+
+  std::ostringstream request;
+  request << "POST " << resource << " HTTP/1.1\r\n"
+          << "Host: localhost\r\n"
+          << "Content-Type: " << content_type << "\r\n"
+          << "Content-Length: " << body.size() << "\r\n"
+          << "Connection: close\r\n"
+          << "\r\n"
+          << body;
+  boost::asio::write( socket, boost::asio::buffer( request.str() ) );
+
+  std::string response;
+  const size_t header_size = boost::asio::read_until( socket, boost::asio::dynamic_buffer( response ), "\r\n\r\n" );
+
+  std::vector< std::string > header_lines;
+  boost::split( header_lines, response.substr( 0, header_size - 4 ), boost::is_any_of( "\r\n" ), boost::token_compress_on );
+  FC_ASSERT( !header_lines.empty() && boost::starts_with( header_lines.front(), "HTTP/1." ), "Malformed HTTP response" );
+
+  size_t content_length = 0;
+  for( const auto& line : header_lines )
+  {
+    if( boost::istarts_with( line, "Content-Length:" ) )
+      content_length = boost::lexical_cast< size_t >( boost::trim_copy( line.substr( sizeof( "Content-Length:" ) - 1 ) ) );
+  }
+
+  // part of the body might have been read together with headers
+  if( response.size() < header_size + content_length )
+    boost::asio::read( socket, boost::asio::dynamic_buffer( response ), boost::asio::transfer_exactly( header_size + content_length - response.size() ) );
+  std::string response_body = response.substr( header_size, content_length );
+
+  const std::string& status_line = header_lines.front();
+  FC_ASSERT( status_line.find( " 200 " ) != std::string::npos, "Request to ${r} failed: ${s} ${b}",
+    ( "r", resource )( "s", status_line )( "b", response_body ) );
+
+  return response_body;
+}
+
+} }
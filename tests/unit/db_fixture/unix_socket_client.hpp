@@ -0,0 +1,27 @@
+#pragma once
+
+#include <fc/filesystem.hpp>
+
+#include <string>
+
+namespace hive { namespace chain {
+
+/** @brief Minimal HTTP client for webserver's unix socket endpoint.
+ *  Sends one request per connection (the same way other local clients do), so tests go through
+ *  actual endpoint framing instead of calling json_rpc plugin directly.
+ */
+class unix_socket_client
+{
+public:
+  explicit unix_socket_client( const fc::path& socket_path ) : _socket_path( socket_path ) {}
+
+  /// Sends POST request to given resource and returns response body; throws when response is not 200 OK
+  std::string post( const std::string& resource, const std::string& content_type, const std::string& body ) const;
+
+  const fc::path& get_socket_path() const { return _socket_path; }
+
+private:
+  fc::path _socket_path;
+};
+
+} }
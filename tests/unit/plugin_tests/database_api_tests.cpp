@@ -563,6 +563,53 @@ BOOST_AUTO_TEST_CASE( verify_account_authority_test )
 
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( export_witness_votes_test )
+{ try {
+
+  const auto to_keys = []( const std::vector< hive::plugins::database_api::api_witness_vote_object >& votes )
+  {
+    std::vector< std::pair< std::string, std::string > > keys;
+    for( const auto& v : votes )
+      keys.emplace_back( v.account, v.witness );
+    return keys;
+  };
+
+  for( auto order : { hive::plugins::database_api::by_account_witness, hive::plugins::database_api::by_witness_account } )
+  {
+    BOOST_TEST_MESSAGE( "export in chunks gives the same votes in the same order as list" );
+    auto listed = database_api->list_witness_votes( { fc::variant(), DATABASE_API_SINGLE_QUERY_LIMIT, order } ).votes;
+    BOOST_REQUIRE_GT( listed.size(), 64u ); // more than one part of parallel construction
+    BOOST_REQUIRE( listed.size() < DATABASE_API_SINGLE_QUERY_LIMIT );
+
+    std::vector< hive::plugins::database_api::api_witness_vote_object > exported;
+    fc::optional< uint64_t > cursor;
+    int chunks = 0;
+    do
+    {
+      auto chunk = database_api->export_witness_votes( { cursor, 30, order } );
+      BOOST_REQUIRE_LE( chunk.votes.size(), 30u );
+      exported.insert( exported.end(), chunk.votes.begin(), chunk.votes.end() );
+      cursor = chunk.next_cursor;
+      ++chunks;
+    }
+    while( cursor.valid() );
+
+    BOOST_REQUIRE_GT( chunks, 1 );
+    BOOST_REQUIRE( to_keys( exported ) == to_keys( listed ) );
+
+    auto all = database_api->export_witness_votes( { fc::optional< uint64_t >(), DATABASE_API_EXPORT_QUERY_LIMIT, order } );
+    BOOST_REQUIRE( !all.next_cursor.valid() );
+    BOOST_REQUIRE_EQUAL( fc::json::to_string( all.votes ), fc::json::to_string( listed ) );
+  }
+
+  BOOST_TEST_MESSAGE( "invalid arguments" );
+  HIVE_REQUIRE_THROW( database_api->export_witness_votes( { fc::optional< uint64_t >(), 0, hive::plugins::database_api::by_account_witness } ), fc::exception );
+  HIVE_REQUIRE_THROW( database_api->export_witness_votes( { fc::optional< uint64_t >(), 10, hive::plugins::database_api::by_name } ), fc::exception );
+  HIVE_REQUIRE_THROW( database_api->export_proposals( { fc::optional< uint64_t >(), 10, hive::plugins::database_api::by_name } ), fc::exception );
+  BOOST_REQUIRE( !database_api->export_proposals( { fc::optional< uint64_t >(), 10, hive::plugins::database_api::by_creator } ).next_cursor.valid() );
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_FIXTURE_TEST_SUITE( database_api_tests_27, database_api_fixture_27 );
@@ -879,3 +926,183 @@ BOOST_AUTO_TEST_CASE( verify_account_authority_test )
 BOOST_AUTO_TEST_SUITE_END()
 #endif
 
+
+#if defined IS_TEST_NET
+struct database_api_cache_fixture : hived_fixture
+{
+  database_api_cache_fixture()
+  {
+    configuration_data.set_initial_asset_supply( INITIAL_TEST_SUPPLY, HBD_INITIAL_TEST_SUPPLY );
+
+    hive::plugins::database_api::database_api_plugin* db_api_plugin = nullptr;
+    postponed_init(
+      {
+        config_line_t( { "plugin", { HIVE_DATABASE_API_PLUGIN_NAME } } ),
+        config_line_t( { "api-object-cache-size", { "100" } } ),
+        config_line_t( { "shared-file-size",
+          { std::to_string( 1024 * 1024 * shared_file_size_small ) } }
+        )
+      },
+      &db_api_plugin
+    );
+
+    database_api = db_api_plugin->api.get();
+    BOOST_REQUIRE( database_api );
+
+    init_account_pub_key = init_account_priv_key.get_public_key();
+
+    generate_block();
+    db->set_hardfork( HIVE_NUM_HARDFORKS );
+    generate_block();
+  }
+
+  hive::plugins::database_api::database_api* database_api = nullptr;
+};
+
+BOOST_FIXTURE_TEST_SUITE( database_api_cache_tests, database_api_cache_fixture );
+
+BOOST_AUTO_TEST_CASE( object_cache_invalidation )
+{ try {
+
+  ACTORS( (alice)(bob) )
+  fund( "alice", HIVE_asset( 10000 ) );
+  generate_block();
+
+  auto find_alice = [&]()
+  {
+    auto accounts = database_api->find_accounts( { { "alice" } } ).accounts;
+    BOOST_REQUIRE_EQUAL( accounts.size(), 1u );
+    return accounts.front();
+  };
+
+  BOOST_TEST_MESSAGE( "repeated reads give the same result" );
+  BOOST_REQUIRE_EQUAL( find_alice().balance.amount.value, 10000 );
+  BOOST_REQUIRE_EQUAL( find_alice().balance.amount.value, 10000 );
+  auto dgpo = database_api->get_dynamic_global_properties( {} );
+  BOOST_REQUIRE_EQUAL( dgpo.head_block_number, db->head_block_num() );
+
+  BOOST_TEST_MESSAGE( "pending transaction invalidates cached objects" );
+  transfer( "alice", "bob", ASSET( "1.000 TESTS" ), "", alice_private_key );
+  BOOST_REQUIRE_EQUAL( find_alice().balance.amount.value, 9000 );
+
+  BOOST_TEST_MESSAGE( "new block invalidates cached objects" );
+  generate_block();
+  BOOST_REQUIRE_EQUAL( database_api->get_dynamic_global_properties( {} ).head_block_number, dgpo.head_block_number + 1 );
+  BOOST_REQUIRE_EQUAL( find_alice().balance.amount.value, 9000 );
+
+  BOOST_TEST_MESSAGE( "cached and constructed objects are the same" );
+  const auto& alice_object = db->get_account( "alice" );
+  hive::plugins::database_api::api_account_object constructed( alice_object, *db, nullptr, true );
+  BOOST_REQUIRE_EQUAL( fc::json::to_string( database_api->get_api_account_object( alice_object, true ) ), fc::json::to_string( constructed ) );
+
+  BOOST_TEST_MESSAGE( "direct state edit by debug_node invalidates cached objects" );
+  BOOST_REQUIRE_EQUAL( find_alice().balance.amount.value, 9000 );
+  db_plugin->debug_update( [=]( database& db )
+  {
+    db.modify( db.get_account( "alice" ), [&]( account_object& a )
+    {
+      a.balance += HIVE_asset( 500 );
+    } );
+  } );
+  BOOST_REQUIRE_EQUAL( find_alice().balance.amount.value, 9500 );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( head_state_snapshot_test )
+{ try {
+
+  // calls with lock are served from snapshot, calls without lock read current state
+  const auto check_snapshot = [&]()
+  {
+    BOOST_REQUIRE_EQUAL( fc::json::to_string( database_api->get_dynamic_global_properties( {}, true ) ),
+      fc::json::to_string( database_api->get_dynamic_global_properties( {} ) ) );
+    BOOST_REQUIRE_EQUAL( fc::json::to_string( database_api->get_witness_schedule( { false }, true ) ),
+      fc::json::to_string( database_api->get_witness_schedule( { false } ) ) );
+    BOOST_REQUIRE_EQUAL( fc::json::to_string( database_api->get_witness_schedule( { true }, true ) ),
+      fc::json::to_string( database_api->get_witness_schedule( { true } ) ) );
+    BOOST_REQUIRE_EQUAL( fc::json::to_string( database_api->get_hardfork_properties( {}, true ) ),
+      fc::json::to_string( database_api->get_hardfork_properties( {} ) ) );
+    BOOST_REQUIRE_EQUAL( fc::json::to_string( database_api->get_reward_funds( {}, true ) ),
+      fc::json::to_string( database_api->get_reward_funds( {} ) ) );
+    BOOST_REQUIRE_EQUAL( fc::json::to_string( database_api->get_current_price_feed( {}, true ) ),
+      fc::json::to_string( database_api->get_current_price_feed( {} ) ) );
+    BOOST_REQUIRE_EQUAL( fc::json::to_string( database_api->get_feed_history( {}, true ) ),
+      fc::json::to_string( database_api->get_feed_history( {} ) ) );
+  };
+
+  BOOST_TEST_MESSAGE( "snapshot matches state of head block" );
+  generate_block();
+  check_snapshot();
+  auto head_dgpo = fc::json::to_string( database_api->get_dynamic_global_properties( {}, true ) );
+
+  BOOST_TEST_MESSAGE( "pending transactions are not visible in snapshot" );
+  ACTORS( (alice) )
+  vest( "alice", HIVE_asset( 10000 ) );
+  BOOST_REQUIRE_EQUAL( fc::json::to_string( database_api->get_dynamic_global_properties( {}, true ) ), head_dgpo );
+  BOOST_REQUIRE( fc::json::to_string( database_api->get_dynamic_global_properties( {} ) ) != head_dgpo );
+
+  BOOST_TEST_MESSAGE( "next block publishes new snapshot" );
+  generate_block();
+  check_snapshot();
+  BOOST_REQUIRE_EQUAL( database_api->get_dynamic_global_properties( {}, true ).head_block_number, db->head_block_num() );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( export_accounts_test )
+{ try {
+
+  BOOST_TEST_MESSAGE( "creating accounts" );
+  const auto key = generate_private_key( "export" ).get_public_key();
+  for( int i = 0; i < 200; ++i )
+    account_create( "export" + std::to_string( i ), key );
+  generate_block();
+
+  const auto to_names = []( const std::vector< hive::plugins::database_api::api_account_object >& accounts )
+  {
+    std::vector< std::string > names;
+    for( const auto& a : accounts )
+      names.emplace_back( a.name );
+    return names;
+  };
+
+  for( auto order : { hive::plugins::database_api::by_name, hive::plugins::database_api::by_proxy,
+    hive::plugins::database_api::by_next_vesting_withdrawal } )
+  {
+    BOOST_TEST_MESSAGE( "export in chunks gives the same accounts in the same order as list" );
+    auto listed = database_api->list_accounts( { fc::variant(), DATABASE_API_SINGLE_QUERY_LIMIT, order } ).accounts;
+    BOOST_REQUIRE( listed.size() < DATABASE_API_SINGLE_QUERY_LIMIT );
+
+    std::vector< hive::plugins::database_api::api_account_object > exported;
+    fc::optional< uint64_t > cursor;
+    int chunks = 0;
+    do
+    {
+      auto chunk = database_api->export_accounts( { cursor, 70, order } );
+      BOOST_REQUIRE_LE( chunk.accounts.size(), 70u );
+      exported.insert( exported.end(), chunk.accounts.begin(), chunk.accounts.end() );
+      cursor = chunk.next_cursor;
+      ++chunks;
+    }
+    while( cursor.valid() );
+
+    BOOST_REQUIRE_GT( chunks, 1 );
+    BOOST_REQUIRE( to_names( exported ) == to_names( listed ) );
+    BOOST_REQUIRE_EQUAL( fc::json::to_string( exported ), fc::json::to_string( listed ) );
+  }
+
+  BOOST_TEST_MESSAGE( "export all at once" );
+  auto listed = database_api->list_accounts( { fc::variant(), DATABASE_API_SINGLE_QUERY_LIMIT, hive::plugins::database_api::by_name } ).accounts;
+  auto all = database_api->export_accounts( { fc::optional< uint64_t >(), DATABASE_API_EXPORT_QUERY_LIMIT, hive::plugins::database_api::by_name } );
+  BOOST_REQUIRE( !all.next_cursor.valid() );
+  BOOST_REQUIRE_EQUAL( fc::json::to_string( all.accounts ), fc::json::to_string( listed ) );
+
+  BOOST_TEST_MESSAGE( "invalid arguments" );
+  HIVE_REQUIRE_THROW( database_api->export_accounts( { fc::optional< uint64_t >(), 0, hive::plugins::database_api::by_name } ), fc::exception );
+  HIVE_REQUIRE_THROW( database_api->export_accounts( { fc::optional< uint64_t >(), DATABASE_API_EXPORT_QUERY_LIMIT + 1, hive::plugins::database_api::by_name } ), fc::exception );
+  HIVE_REQUIRE_THROW( database_api->export_accounts( { fc::optional< uint64_t >(), 10, hive::plugins::database_api::by_account } ), fc::exception );
+  HIVE_REQUIRE_THROW( database_api->export_accounts( { fc::optional< uint64_t >( 1000000 ), 10, hive::plugins::database_api::by_name } ), fc::exception );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
+#endif
@@ -5,9 +5,14 @@
 #include <hive/chain/comment_object.hpp>
 #include <hive/protocol/hive_operations.hpp>
 #include <hive/plugins/json_rpc/json_rpc_plugin.hpp>
+#include <hive/plugins/block_api/block_api_args.hpp>
+#include <hive/plugins/database_api/database_api_args.hpp>
 
 #include "../db_fixture/hived_fixture.hpp"
 
+#include <atomic>
+#include <mutex>
+
 using namespace hive::chain;
 using namespace hive::protocol;
 
@@ -351,5 +356,152 @@ BOOST_AUTO_TEST_CASE( semantics_validation )
   FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_CASE( binary_validation )
+{
+  try
+  {
+    using namespace hive::plugins;
+
+    BOOST_TEST_MESSAGE( "binary call has to give the same result as JSON call" );
+    {
+      database_api::find_accounts_args args;
+      args.accounts = { HIVE_INIT_MINER_NAME };
+      auto result = fc::raw::unpack_from_vector< database_api::find_accounts_return >(
+        make_binary_request( "database_api.find_accounts", fc::raw::pack_to_vector( args ) ) );
+      BOOST_REQUIRE_EQUAL( result.accounts.size(), 1u );
+
+      std::string request = "{\"jsonrpc\":\"2.0\", \"method\":\"database_api.find_accounts\", \"params\":{\"accounts\":[\"initminer\"]}, \"id\":1}";
+      fc::variant answer = make_request( request, 0, false, false );
+      BOOST_REQUIRE_EQUAL( fc::json::to_string( fc::variant( result ) ), fc::json::to_string( answer[ "result" ] ) );
+    }
+    {
+      block_api::get_block_args args;
+      args.block_num = 2;
+      auto result = fc::raw::unpack_from_vector< block_api::get_block_return >(
+        make_binary_request( "block_api.get_block", fc::raw::pack_to_vector( args ) ) );
+      BOOST_REQUIRE( result.block.valid() );
+      BOOST_REQUIRE_EQUAL( result.block->block_num(), 2u );
+
+      std::string request = "{\"jsonrpc\":\"2.0\", \"method\":\"block_api.get_block\", \"params\":{\"block_num\":2}, \"id\":2}";
+      fc::variant answer = make_request( request, 0, false, false );
+      BOOST_REQUIRE_EQUAL( fc::json::to_string( fc::variant( result ) ), fc::json::to_string( answer[ "result" ] ) );
+    }
+    {
+      // methods without arguments take empty body
+      auto result = fc::raw::unpack_from_vector< database_api::get_dynamic_global_properties_return >(
+        make_binary_request( "database_api.get_dynamic_global_properties", std::vector< char >() ) );
+      BOOST_REQUIRE_EQUAL( result.head_block_number, db->head_block_num() );
+    }
+
+    BOOST_TEST_MESSAGE( "unknown binary method or malformed args have to be rejected" );
+    HIVE_REQUIRE_THROW( make_binary_request( "database_api.fake_method", std::vector< char >() ), fc::exception );
+    HIVE_REQUIRE_THROW( make_binary_request( "condenser_api.get_accounts", std::vector< char >() ), fc::exception );
+    HIVE_REQUIRE_THROW( make_binary_request( "block_api.get_block", std::vector< char >( 2, 0 ) ), fc::exception );
+  }
+  FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE( binary_vs_json_throughput )
+{
+  try
+  {
+    using namespace hive::plugins;
+
+    const uint32_t iterations = 1000;
+
+    block_api::get_block_args args;
+    args.block_num = db->head_block_num();
+    std::vector< char > packed_args = fc::raw::pack_to_vector( args );
+    std::string request = "{\"jsonrpc\":\"2.0\", \"method\":\"block_api.get_block\", \"params\":{\"block_num\":" +
+      std::to_string( args.block_num ) + "}, \"id\":1}";
+
+    fc::time_point start = fc::time_point::now();
+    for( uint32_t i = 0; i < iterations; ++i )
+    {
+      auto result = fc::raw::unpack_from_vector< block_api::get_block_return >( make_binary_request( "block_api.get_block", packed_args ) );
+      BOOST_REQUIRE( result.block.valid() );
+    }
+    fc::microseconds binary_time = fc::time_point::now() - start;
+
+    start = fc::time_point::now();
+    for( uint32_t i = 0; i < iterations; ++i )
+    {
+      auto result = make_unix_socket_request( request )[ "result" ].as< block_api::get_block_return >();
+      BOOST_REQUIRE( result.block.valid() );
+    }
+    fc::microseconds json_time = fc::time_point::now() - start;
+
+    // both go through webserver's unix endpoint, so the difference is in serialization only
+    BOOST_TEST_MESSAGE( "block_api.get_block x" << iterations << ": binary " << binary_time.count() << "us, JSON " << json_time.count() << "us" );
+  }
+  FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE( subscription_validation )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "subscription is not available without a way to push notifications" );
+    std::string request = "{\"jsonrpc\":\"2.0\", \"method\":\"block_api.subscribe_blocks\", \"params\":{}, \"id\":1}";
+    make_request( request, JSON_RPC_ERROR_DURING_CALL );
+
+    std::mutex messages_mutex;
+    std::vector< std::string > messages;
+    auto collect = [&]( const std::string& message ) -> bool
+    {
+      std::lock_guard< std::mutex > guard( messages_mutex );
+      messages.push_back( message );
+      return true;
+    };
+    std::atomic< uint32_t > refused_count = { 0 };
+    auto refuse = [&]( const std::string& ) -> bool
+    {
+      ++refused_count;
+      return false;
+    };
+    auto wait_for_messages = [&]( size_t count )
+    {
+      for( int i = 0; i < 1000; ++i )
+      {
+        {
+          std::lock_guard< std::mutex > guard( messages_mutex );
+          if( messages.size() >= count )
+            return;
+        }
+        fc::usleep( fc::milliseconds( 10 ) );
+      }
+      BOOST_FAIL( "notifications did not arrive in time" );
+    };
+
+    fc::variant answer = make_subscription_request( request, collect );
+    BOOST_REQUIRE( answer.get_object().contains( "result" ) );
+    uint64_t first_id = answer[ "result" ][ "subscription_id" ].as_uint64();
+    answer = make_subscription_request( request, refuse );
+    BOOST_REQUIRE( answer[ "result" ][ "subscription_id" ].as_uint64() != first_id );
+
+    BOOST_TEST_MESSAGE( "each applied block is pushed to subscribers" );
+    generate_block();
+    wait_for_messages( 1 );
+    generate_block();
+    wait_for_messages( 2 );
+
+    for( size_t i = 0; i < 2; ++i )
+    {
+      fc::variant notification = fc::json::from_string( messages[i], fc::json::format_validation_mode::full );
+      BOOST_REQUIRE_EQUAL( notification[ "method" ].as_string(), "block_api.on_block" );
+      BOOST_REQUIRE( !notification.get_object().contains( "id" ) );
+      auto params = notification[ "params" ].as< hive::plugins::block_api::on_block_params >();
+      BOOST_REQUIRE( !params.irreversible );
+      BOOST_REQUIRE_EQUAL( params.block.block_num(), db->head_block_num() - 1 + i );
+      BOOST_REQUIRE( params.virtual_ops.valid() );
+      BOOST_REQUIRE( !params.virtual_ops->empty() ); // at least producer reward
+    }
+
+    BOOST_TEST_MESSAGE( "subscriber that refuses notification is dropped" );
+    BOOST_REQUIRE_EQUAL( refused_count.load(), 1u );
+  }
+  FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 #endif
@@ -81,5 +81,66 @@ BOOST_AUTO_TEST_CASE( additional_allocation_after_snapshot_load )
   FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_CASE( resume_replay_from_checkpoint )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "--- Testing: resume_replay_from_checkpoint" );
+
+    const std::string snapshot_root_dir = "resume_replay_from_checkpoint";
+    const fc::path checkpoint_dir = hive::utilities::temp_directory_path() / snapshot_root_dir;
+    const uint32_t block_count = 60;
+    const uint32_t interrupted_at = 35;
+    clear_snapshot( snapshot_root_dir );
+
+    auto replay_with_checkpoints = [&]( const hived_fixture::config_arg_override_t& extra_config )
+    {
+      reset_fixture( false );
+      hived_fixture::config_arg_override_t config = {
+        hived_fixture::config_line_t( { "plugin", { "state_snapshot" } } ),
+        hived_fixture::config_line_t( { "snapshot-root-dir", { checkpoint_dir.string() } } ),
+        hived_fixture::config_line_t( { "force-replay", { "" } } ),
+        hived_fixture::config_line_t( { "replay-checkpoint-interval", { "10" } } )
+      };
+      config.insert( config.end(), extra_config.begin(), extra_config.end() );
+      postponed_init( config );
+    };
+
+    {
+      postponed_init();
+      generate_blocks( block_count );
+      BOOST_REQUIRE_EQUAL( db()->head_block_num(), block_count );
+    }
+    {
+      // replay stopped before the end of block log keeps its checkpoints (only two newest ones)
+      replay_with_checkpoints( { hived_fixture::config_line_t( { "stop-at-block", { std::to_string( interrupted_at ) } } ) } );
+      BOOST_REQUIRE_EQUAL( db()->head_block_num(), interrupted_at );
+      BOOST_REQUIRE( !fc::exists( checkpoint_dir / "replay_checkpoint_0000000010" ) );
+      BOOST_REQUIRE( fc::exists( checkpoint_dir / "replay_checkpoint_0000000020" ) );
+      BOOST_REQUIRE( fc::exists( checkpoint_dir / "replay_checkpoint_0000000030" ) );
+    }
+    {
+      // newest checkpoint got damaged - replay (forced, so state from previous run is not used) has to resume from older one
+      fc::remove_all( checkpoint_dir / "replay_checkpoint_0000000030" );
+      fc::create_directories( checkpoint_dir / "replay_checkpoint_0000000030" );
+      replay_with_checkpoints( { hived_fixture::config_line_t( { "stop-at-block", { std::to_string( interrupted_at ) } } ) } );
+      BOOST_REQUIRE( db()->get_snapshot_loaded() );
+      BOOST_REQUIRE_EQUAL( db()->head_block_num(), interrupted_at );
+      BOOST_REQUIRE( fc::exists( checkpoint_dir / "replay_checkpoint_0000000020" ) );
+      BOOST_REQUIRE( fc::exists( checkpoint_dir / "replay_checkpoint_0000000030" ) ); // dumped again during resumed replay
+    }
+    {
+      // resumed replay reaches the end of block log and removes checkpoints
+      replay_with_checkpoints( {} );
+      BOOST_REQUIRE( db()->get_snapshot_loaded() );
+      BOOST_REQUIRE_EQUAL( db()->head_block_num(), block_count );
+      BOOST_REQUIRE( !fc::exists( checkpoint_dir / "replay_checkpoint_0000000020" ) );
+      BOOST_REQUIRE( !fc::exists( checkpoint_dir / "replay_checkpoint_0000000030" ) );
+      validate_database();
+    }
+  }
+  FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 #endif
@@ -709,8 +709,10 @@ BOOST_AUTO_TEST_CASE( chain_object_size )
 
   //permanent objects (no operation to remove)
   BOOST_CHECK_EQUAL( alignof( account_object ), 16u );
-  BOOST_CHECK_EQUAL( sizeof( account_object ), 480u ); //1.3M+
-  BOOST_CHECK_EQUAL( sizeof( account_index::MULTIINDEX_NODE_TYPE ), 672u );
+  BOOST_CHECK_EQUAL( sizeof( account_object ), 416u ); //1.3M+
+  BOOST_CHECK_EQUAL( sizeof( account_index::MULTIINDEX_NODE_TYPE ), 608u );
+  BOOST_CHECK_EQUAL( sizeof( account_details_object ), 72u ); //at most as many as account_object (only for accounts that set memo key or received rewards)
+  BOOST_CHECK_EQUAL( sizeof( account_details_index::MULTIINDEX_NODE_TYPE ), 136u );
   BOOST_CHECK_EQUAL( sizeof( account_authority_object ), 248u ); //as many as account_object
   BOOST_CHECK_EQUAL( sizeof( account_authority_index::MULTIINDEX_NODE_TYPE ), 312u );
   BOOST_CHECK_EQUAL( sizeof( liquidity_reward_balance_object ), 48u ); //obsolete - only created/modified up to HF12 (683 objects)
@@ -1481,7 +1483,8 @@ BOOST_AUTO_TEST_CASE( chain_object_checksum )
 {
   hive::chain::util::decoded_types_data_storage dtds;
 
-  BOOST_CHECK_EQUAL( get_decoded_type_checksum<hive::chain::account_object>(dtds), "f1d1ffb67d5b16ff922dd66afdd98a4043cf8909" );
+  BOOST_CHECK_EQUAL( get_decoded_type_checksum<hive::chain::account_object>(dtds), "b0e7b01643f27cd3e97f3a05eb92fba2ec435bd3" );
+  BOOST_CHECK_EQUAL( get_decoded_type_checksum<hive::chain::account_details_object>(dtds), "8f20a8f46de3884e19e1695ab1bc01b374fd1f90" );
   BOOST_CHECK_EQUAL( get_decoded_type_checksum<hive::chain::account_authority_object>(dtds), "e492c85b420461ce856b14b80edb3649e4996d86" );
   BOOST_CHECK_EQUAL( get_decoded_type_checksum<hive::chain::vesting_delegation_object>(dtds), "2c140c595e4a83e6aab21cb3090816206b07a5ad" );
   BOOST_CHECK_EQUAL( get_decoded_type_checksum<hive::chain::vesting_delegation_expiration_object>(dtds), "cf8a309d076970b83c8e7ada88b01277a43dc726" );
@@ -1581,6 +1584,45 @@ BOOST_AUTO_TEST_CASE( authorization_speed )
   BOOST_REQUIRE_EQUAL( counter, ITERATIONS );
   ilog( "verify_authority valid key end after ${t}us", ( "t", ( fc::time_point::now() - time ).count() ) );
 
+  for( bool use_valid_key : { true, false } )
+  {
+    ilog( "verify_authority (authority view) ${k} key start", ( "k", use_valid_key ? "valid" : "invalid" ) );
+    time = fc::time_point::now();
+    counter = 0;
+    for( int i = 0; i < ITERATIONS; ++i )
+    {
+      try
+      {
+        authority_view_getter get_active = [&]( const std::string& name ) { return authority_view( db->get< account_authority_object, by_account >( name ).active ); };
+        authority_view_getter get_owner = [&]( const std::string& name ) { return authority_view( db->get< account_authority_object, by_account >( name ).owner ); };
+        authority_view_getter get_posting = [&]( const std::string& name ) { return authority_view( db->get< account_authority_object, by_account >( name ).posting ); };
+        auto get_witness_key = [&]( const std::string& name ) { try { return db->get_witness( name ).signing_key; } FC_CAPTURE_AND_RETHROW( ( name ) ) };
+
+        required_authorities_type required_authorities;
+        required_authorities.required_active.insert( "initminer" );
+
+        hive::protocol::verify_authority(
+          db->has_hardfork( HIVE_HARDFORK_1_28_ALLOW_STRICT_AND_MIXED_AUTHORITIES ),
+          db->has_hardfork( HIVE_HARDFORK_1_28_ALLOW_REDUNDANT_SIGNATURES ),
+          required_authorities, use_valid_key ? valid_key : invalid_key, get_active, get_owner, get_posting, get_witness_key );
+        if( use_valid_key )
+          ++counter;
+        else
+          counter = 0;
+      }
+      catch( const tx_missing_active_auth& )
+      {
+        if( use_valid_key )
+          counter = 0;
+        else
+          ++counter;
+      }
+    }
+    BOOST_REQUIRE_EQUAL( counter, ITERATIONS );
+    ilog( "verify_authority (authority view) ${k} key end after ${t}us",
+      ( "k", use_valid_key ? "valid" : "invalid" )( "t", ( fc::time_point::now() - time ).count() ) );
+  }
+
   ilog( "verify_authority invalid key start" );
   time = fc::time_point::now();
   counter = 0;
@@ -1751,6 +1793,68 @@ BOOST_AUTO_TEST_CASE( authorization_speed )
   ilog( "regular exception end after ${t}us", ( "t", ( fc::time_point::now() - time ).count() ) );
 }
 
+BOOST_AUTO_TEST_CASE( account_modification_speed )
+{
+  /*
+  This test does not test anything, but reports execution time of most frequent modifications of accounts.
+  Every modification copies whole object into undo state, so the cost depends on size of account_object.
+  Data not used by consensus (memo key, reward counters etc.) is kept in account_details_object for that reason.
+  */
+  ACTORS( (alice)(bob) )
+  vest( "alice", HIVE_asset( 10'000'000 ) );
+  fund( "alice", HIVE_asset( 1'000'000 ) );
+  generate_block();
+
+  const int ITERATIONS = 200000;
+  const int TRANSFERS = 2000;
+  fc::time_point time;
+  const auto& alice = db->get_account( "alice" );
+
+  ilog( "vote-like account modification start" );
+  time = fc::time_point::now();
+  for( int i = 0; i < ITERATIONS; ++i )
+  {
+    auto session = db->start_undo_session();
+    db->modify( alice, [&]( account_object& a )
+    {
+      a.voting_manabar.current_mana -= 1;
+      a.last_vote_time = db->head_block_time();
+    } );
+  }
+  ilog( "vote-like account modification end after ${t}us", ( "t", ( fc::time_point::now() - time ).count() ) );
+
+  ilog( "account details modification start" );
+  time = fc::time_point::now();
+  for( int i = 0; i < ITERATIONS; ++i )
+  {
+    auto session = db->start_undo_session();
+    db->modify_account_details( alice, [&]( account_details_object& d )
+    {
+      d.last_account_update = db->head_block_time();
+    } );
+  }
+  ilog( "account details modification end after ${t}us", ( "t", ( fc::time_point::now() - time ).count() ) );
+
+  const auto bob_balance = db->get_account( "bob" ).get_hive_balance().amount.value;
+  ilog( "transfer start" );
+  time = fc::time_point::now();
+  for( int i = 0; i < TRANSFERS; ++i )
+  {
+    transfer_operation op;
+    op.from = "alice";
+    op.to = "bob";
+    op.amount = ASSET( "0.001 TESTS" );
+    op.memo = std::to_string( i ); // makes every transaction unique
+
+    signed_transaction tx;
+    tx.set_expiration( db->head_block_time() + HIVE_MAX_TIME_UNTIL_EXPIRATION );
+    tx.operations.push_back( op );
+    push_transaction_ex( tx, fc::ecc::private_key(), ~0 );
+  }
+  ilog( "transfer end after ${t}us", ( "t", ( fc::time_point::now() - time ).count() ) );
+  BOOST_REQUIRE_EQUAL( db->get_account( "bob" ).get_hive_balance().amount.value, bob_balance + TRANSFERS );
+}
+
 BOOST_AUTO_TEST_CASE( authorization_redirections )
 {
   BOOST_REQUIRE( db->has_hardfork( HIVE_HARDFORK_1_28_ALLOW_STRICT_AND_MIXED_AUTHORITIES ) );
@@ -2,13 +2,20 @@
 #include <boost/test/unit_test.hpp>
 
 #include <hive/chain/block_log.hpp>
+#include <hive/chain/block_log_compression.hpp>
+#include <hive/chain/block_compression_dictionaries.hpp>
 #include <hive/chain/block_log_wrapper.hpp>
 #include <hive/chain/block_storage_interface.hpp>
+#include <hive/chain/chunked_block_log.hpp>
 #include <hive/plugins/state_snapshot/state_snapshot_plugin.hpp>
 #include <hive/plugins/block_api/block_api.hpp>
 
 #include "../db_fixture/hived_fixture.hpp"
 
+#include <atomic>
+#include <fstream>
+#include <thread>
+
 using namespace hive::chain;
 using namespace hive::plugins;
 
@@ -1654,5 +1661,366 @@ BOOST_AUTO_TEST_CASE( allow_artifacts_regeneration_true_recreates_missing_artifa
   }
 }
 
+BOOST_AUTO_TEST_CASE( artifacts_regeneration_in_parallel_ranges )
+{
+  try {
+    // Block log long enough to be split into several ranges processed by separate threads during artifacts generation.
+    fc::temp_directory temp_dir( hive::utilities::temp_directory_path() );
+    fc::path log_path = temp_dir.path() / "block_log_part.0001";
+    fc::path artifacts_path = fc::path( log_path.generic_string() + ".artifacts" );
+
+    appbase::application app;
+    blockchain_worker_thread_pool thread_pool( app );
+
+    std::vector<block_id_type> ids;
+    {
+      block_log log( app );
+      log.open_and_init( log_path, false /*read_only*/, false /*allow_artifacts_regeneration*/, true /*enable_compression*/,
+                         1 /*compression_level*/, true /*enable_block_log_auto_fixing*/, thread_pool );
+      std::vector<std::shared_ptr<full_transaction_type>> full_txs;
+      for( uint32_t i = 0; i < 25005; ++i )
+      {
+        hive::protocol::signed_block_header header;
+        header.witness = "dave";
+        header.previous = ids.empty() ? block_id_type() : ids.back();
+        auto full_block = full_block_type::create_from_block_header_and_transactions( header, full_txs, nullptr );
+        log.append( full_block, false );
+        ids.push_back( full_block->get_block_id() );
+      }
+      log.flush();
+      log.close();
+    }
+
+    const auto original_artifacts_size = fc::file_size( artifacts_path );
+    fc::remove( artifacts_path );
+
+    block_log log( app );
+    log.open_and_init( log_path, true /*read_only*/, true /*allow_artifacts_regeneration*/, true /*enable_compression*/,
+                       1 /*compression_level*/, true /*enable_block_log_auto_fixing*/, thread_pool );
+    BOOST_REQUIRE_EQUAL( fc::file_size( artifacts_path ), original_artifacts_size );
+    for( uint32_t block_num = 1; block_num <= ids.size(); ++block_num )
+      BOOST_REQUIRE( log.read_block_by_num( block_num )->get_block_id() == ids[ block_num - 1 ] );
+    log.close();
+  } catch (fc::exception& e) {
+    edump((e.to_detail_string()));
+    throw;
+  }
+}
+
+BOOST_AUTO_TEST_CASE( zstd_thread_contexts )
+{
+  try {
+    ilog( "Testing block compression roundtrip with contexts and buffers reused by the same thread." );
+
+    std::optional<uint8_t> dictionary = get_last_available_zstd_compression_dictionary_number();
+    std::vector< std::string > samples;
+    for( size_t i = 0; i < 8; ++i )
+    {
+      std::string sample;
+      for( size_t j = 0; j < 100 * ( i + 1 ) * ( i + 1 ); ++j )
+        sample += "block " + std::to_string( i * j ) + ( j % 3 ? " transfer" : " vote" );
+      samples.emplace_back( std::move( sample ) );
+    }
+
+    // no BOOST_REQUIRE inside, it is also called from other threads
+    auto roundtrip = [&]( const std::string& sample, std::optional<uint8_t> dictionary_number )
+    {
+      auto [ compressed, compressed_size ] = block_log_compression::compress_block_zstd( sample.data(), sample.size(), dictionary_number );
+      block_log_compression::block_attributes_t attributes;
+      attributes.flags = block_log_compression::block_flags::zstd;
+      attributes.dictionary_number = dictionary_number;
+      auto [ uncompressed, uncompressed_size ] = block_log_compression::decompress_raw_block( compressed.get(), compressed_size, attributes );
+      return compressed_size < sample.size() && uncompressed_size == sample.size() &&
+        memcmp( uncompressed.get(), sample.data(), sample.size() ) == 0;
+    };
+
+    // alternate samples of different sizes and dictionary/no dictionary, so every call has to rebind or reuse the context
+    auto run = [&]()
+    {
+      int failures = 0;
+      for( size_t pass = 0; pass < 3; ++pass )
+        for( size_t i = 0; i < samples.size(); ++i )
+          if( !roundtrip( samples[ ( i * 5 + pass ) % samples.size() ], ( i + pass ) % 2 ? dictionary : std::optional<uint8_t>() ) )
+            ++failures;
+      return failures;
+    };
+    BOOST_REQUIRE_EQUAL( run(), 0 );
+
+    std::vector< std::thread > threads;
+    std::atomic<int> failures = { 0 };
+    for( int t = 0; t < 4; ++t )
+      threads.emplace_back( [&]()
+      {
+        try { failures += run(); }
+        catch( ... ) { ++failures; }
+      } );
+    for( auto& t : threads )
+      t.join();
+    BOOST_REQUIRE_EQUAL( failures.load(), 0 );
+
+  } catch (fc::exception& e) {
+    edump((e.to_detail_string()));
+    throw;
+  }
+}
+
+BOOST_AUTO_TEST_CASE( custom_zstd_dictionaries )
+{
+  try {
+    ilog( "Testing custom compression dictionaries registered for block ranges." );
+
+    // block ranges far beyond anything other tests use, since registration can't be undone
+    const uint32_t first_block = 4000000000u;
+    std::string sample;
+    for( size_t j = 0; j < 1000; ++j )
+      sample += "custom dictionary block " + std::to_string( j ) + ( j % 3 ? " transfer" : " vote" );
+
+    // any content works as (raw content) zstd dictionary
+    custom_zstd_dictionary dictionary;
+    dictionary.dictionary_number = HIVE_FIRST_CUSTOM_ZSTD_DICTIONARY_NUMBER + 50;
+    dictionary.first_block = first_block;
+    dictionary.last_block = first_block + 999;
+    dictionary.dictionary.assign( sample.begin(), sample.begin() + sample.size() / 2 );
+
+    custom_zstd_dictionary invalid = dictionary;
+    invalid.dictionary_number = HIVE_FIRST_CUSTOM_ZSTD_DICTIONARY_NUMBER - 1;
+    HIVE_REQUIRE_THROW( register_custom_zstd_compression_dictionary( invalid ), fc::assert_exception );
+
+    register_custom_zstd_compression_dictionary( dictionary );
+    HIVE_REQUIRE_THROW( register_custom_zstd_compression_dictionary( dictionary ), fc::assert_exception );
+    BOOST_REQUIRE( get_best_available_zstd_compression_dictionary_number_for_block( first_block + 500 ) == dictionary.dictionary_number );
+    BOOST_REQUIRE( get_best_available_zstd_compression_dictionary_number_for_block( first_block + 1000 ) != dictionary.dictionary_number );
+    BOOST_REQUIRE( get_last_available_zstd_compression_dictionary_number() != dictionary.dictionary_number );
+
+    auto [ compressed, compressed_size ] = block_log_compression::compress_block_zstd( sample.data(), sample.size(), dictionary.dictionary_number );
+    auto [ no_dictionary_compressed, no_dictionary_compressed_size ] = block_log_compression::compress_block_zstd( sample.data(), sample.size(), std::optional<uint8_t>() );
+    BOOST_REQUIRE_LT( compressed_size, no_dictionary_compressed_size );
+    block_log_compression::block_attributes_t attributes;
+    attributes.flags = block_log_compression::block_flags::zstd;
+    attributes.dictionary_number = dictionary.dictionary_number;
+    auto [ uncompressed, uncompressed_size ] = block_log_compression::decompress_raw_block( compressed.get(), compressed_size, attributes );
+    BOOST_REQUIRE_EQUAL( uncompressed_size, sample.size() );
+    BOOST_REQUIRE( memcmp( uncompressed.get(), sample.data(), sample.size() ) == 0 );
+
+    // side file roundtrip; loading registers the dictionaries
+    fc::temp_directory dictionaries_dir( hive::utilities::temp_directory_path() );
+    fc::path dictionaries_file = dictionaries_dir.path() / "dictionaries";
+    custom_zstd_dictionary next = dictionary;
+    next.dictionary_number = dictionary.dictionary_number + 1;
+    next.first_block = dictionary.last_block + 1;
+    next.last_block = dictionary.last_block + 1000;
+    save_custom_zstd_compression_dictionaries( dictionaries_file, { next } );
+    auto loaded = load_custom_zstd_compression_dictionaries( dictionaries_file );
+    BOOST_REQUIRE_EQUAL( loaded.size(), 1u );
+    BOOST_REQUIRE_EQUAL( loaded[0].dictionary_number, next.dictionary_number );
+    BOOST_REQUIRE_EQUAL( loaded[0].first_block, next.first_block );
+    BOOST_REQUIRE_EQUAL( loaded[0].last_block, next.last_block );
+    BOOST_REQUIRE( loaded[0].dictionary == next.dictionary );
+    BOOST_REQUIRE( get_best_available_zstd_compression_dictionary_number_for_block( next.first_block ) == next.dictionary_number );
+
+  } catch (fc::exception& e) {
+    edump((e.to_detail_string()));
+    throw;
+  }
+}
+
+BOOST_AUTO_TEST_CASE( mmap_block_log_reads )
+{
+  try {
+    ilog( "Testing reading blocks from memory mapped block log." );
+    fc::temp_directory temp_dir( hive::utilities::temp_directory_path() );
+    fc::path log_path = temp_dir.path() / "block_log_part.0001";
+
+    appbase::application app;
+    blockchain_worker_thread_pool thread_pool( app );
+
+    std::vector<std::shared_ptr<full_transaction_type>> full_txs;
+    auto append_block = [&]( block_log& log, const block_id_type& previous )
+    {
+      hive::protocol::signed_block_header header;
+      header.witness = "alice";
+      header.previous = previous;
+      auto full_block = full_block_type::create_from_block_header_and_transactions( header, full_txs, nullptr );
+      log.append( full_block, false );
+      return full_block->get_block_id();
+    };
+
+    std::vector<block_id_type> ids;
+    {
+      block_log log( app );
+      log.open_and_init( log_path, false /*read_only*/, false /*allow_artifacts_regeneration*/, true /*enable_compression*/,
+                         15 /*compression_level*/, true /*enable_block_log_auto_fixing*/, thread_pool, true /*enable_mmap_reads*/ );
+      for( int i = 0; i < 10; ++i )
+        ids.push_back( append_block( log, ids.empty() ? block_id_type() : ids.back() ) );
+
+      // map, then append more - new blocks have to be readable through the same (or extended) mapping
+      BOOST_REQUIRE( log.read_block_by_num( 5 )->get_block_id() == ids[4] );
+      for( int i = 0; i < 10; ++i )
+        ids.push_back( append_block( log, ids.back() ) );
+      BOOST_REQUIRE( log.read_block_by_num( 19 )->get_block_id() == ids[18] );
+
+      // block read before truncation still has its data after file is shrunk under its mapping
+      auto truncated_block = log.read_block_by_num( 20 );
+      const compressed_block_data& truncated_data = truncated_block->get_compressed_block();
+      std::vector<char> saved_data( truncated_data.data(), truncated_data.data() + truncated_data.compressed_size );
+      log.truncate( 18 );
+      BOOST_REQUIRE( memcmp( truncated_data.data(), saved_data.data(), saved_data.size() ) == 0 );
+      BOOST_REQUIRE( truncated_block->get_block_header().previous == ids[18] );
+      ids.resize( 18 );
+      ids.push_back( append_block( log, ids.back() ) );
+      ids.push_back( append_block( log, ids.back() ) );
+      BOOST_REQUIRE( log.read_block_by_num( 20 )->get_block_id() == ids[19] );
+      log.flush();
+      log.close();
+    }
+
+    block_log regular_log( app );
+    regular_log.open_and_init( log_path, true /*read_only*/, false /*allow_artifacts_regeneration*/, true /*enable_compression*/,
+                               15 /*compression_level*/, true /*enable_block_log_auto_fixing*/, thread_pool );
+    block_log mapped_log( app );
+    mapped_log.open_and_init( log_path, true /*read_only*/, false /*allow_artifacts_regeneration*/, true /*enable_compression*/,
+                              15 /*compression_level*/, true /*enable_block_log_auto_fixing*/, thread_pool, true /*enable_mmap_reads*/ );
+    HIVE_REQUIRE_THROW( regular_log.read_mapped_raw_block_data_by_num( 1 ), fc::assert_exception );
+
+    for( uint32_t block_num = 1; block_num <= ids.size(); ++block_num )
+    {
+      auto regular_block = regular_log.read_block_by_num( block_num );
+      auto mapped_block = mapped_log.read_block_by_num( block_num );
+      BOOST_REQUIRE( mapped_block->get_block_id() == ids[ block_num - 1 ] );
+      BOOST_REQUIRE( mapped_block->get_block_header().previous == regular_block->get_block_header().previous );
+      BOOST_REQUIRE_EQUAL( mapped_block->get_block_header().witness, "alice" );
+
+      const compressed_block_data& regular_data = regular_block->get_compressed_block();
+      const compressed_block_data& mapped_data = mapped_block->get_compressed_block();
+      BOOST_REQUIRE_EQUAL( mapped_data.compressed_size, regular_data.compressed_size );
+      BOOST_REQUIRE( memcmp( mapped_data.data(), regular_data.data(), regular_data.compressed_size ) == 0 );
+    }
+
+    auto mapped_range = mapped_log.read_block_range_by_num( 3, ids.size() - 2 );
+    BOOST_REQUIRE_EQUAL( mapped_range.size(), ids.size() - 2 );
+    for( size_t i = 0; i < mapped_range.size(); ++i )
+      BOOST_REQUIRE( mapped_range[i]->get_block_id() == ids[ i + 2 ] );
+
+    uint32_t replayed = 0;
+    mapped_log.for_each_block( 1, ids.size(), [&]( const std::shared_ptr<full_block_type>& full_block )
+      {
+        ++replayed;
+        return full_block->get_block_id() == ids[ full_block->get_block_num() - 1 ];
+      }, block_log::for_each_purpose::decompressing, thread_pool );
+    BOOST_REQUIRE_EQUAL( replayed, ids.size() );
+
+    regular_log.close();
+    mapped_log.close();
+  } catch (fc::exception& e) {
+    edump((e.to_detail_string()));
+    throw;
+  }
+}
+
+BOOST_AUTO_TEST_CASE( chunked_block_log_conversion )
+{
+  try {
+    ilog( "Testing conversion of block log to chunked format and back." );
+    fc::temp_directory temp_dir( hive::utilities::temp_directory_path() );
+    fc::path source_path = temp_dir.path() / "source";
+    fc::path target_path = temp_dir.path() / "target";
+    fc::create_directories( source_path );
+    fc::create_directories( target_path );
+    fc::path chunked_path = temp_dir.path() / ( "block_log" + chunked_block_log::_chunked_extension );
+
+    appbase::application app;
+    blockchain_worker_thread_pool thread_pool( app );
+
+    std::vector<std::shared_ptr<full_transaction_type>> full_txs;
+    std::vector<block_id_type> ids;
+    auto source_log = block_log_wrapper::create_opened_wrapper( source_path / block_log_file_name_info::_legacy_file_name,
+      app, thread_pool, false /*read_only*/ );
+    for( int i = 0; i < 25; ++i )
+    {
+      hive::protocol::signed_block_header header;
+      header.witness = "alice";
+      header.previous = ids.empty() ? block_id_type() : ids.back();
+      auto full_block = full_block_type::create_from_block_header_and_transactions( header, full_txs, nullptr );
+      source_log->append( full_block, false );
+      ids.push_back( full_block->get_block_id() );
+    }
+    source_log->flush_head_storage();
+
+    // last chunk is partial
+    chunked_block_log::create_from_block_log( *source_log, chunked_path, 1, ids.size(), 10, 15 );
+    HIVE_REQUIRE_THROW( chunked_block_log::create_from_block_log( *source_log, chunked_path, 1, ids.size(), 10, 15 ), fc::assert_exception );
+    source_log->close_storage();
+
+    {
+      chunked_block_log chunked_log( chunked_path );
+      chunked_log.verify();
+      BOOST_REQUIRE_EQUAL( chunked_log.get_chunks().size(), 3u );
+      BOOST_REQUIRE_EQUAL( chunked_log.tail_block_num(), 1u );
+      BOOST_REQUIRE_EQUAL( chunked_log.head_block_num(), ids.size() );
+      BOOST_REQUIRE( chunked_log.head_block_id() == ids.back() );
+
+      // random access in any order
+      for( uint32_t block_num : { 17u, 3u, 25u, 11u, 1u, 20u } )
+      {
+        auto full_block = chunked_log.read_block_by_num( block_num );
+        BOOST_REQUIRE( full_block->get_block_id() == ids[ block_num - 1 ] );
+        BOOST_REQUIRE_EQUAL( full_block->get_block_header().witness, "alice" );
+        BOOST_REQUIRE( chunked_log.find_block_id_for_num( block_num ) == ids[ block_num - 1 ] );
+        BOOST_REQUIRE( chunked_log.is_known_block( ids[ block_num - 1 ] ) );
+      }
+      BOOST_REQUIRE( !chunked_log.read_block_by_num( ids.size() + 1 ) );
+      BOOST_REQUIRE( !chunked_log.fetch_block_by_id( block_id_type() ) );
+
+      auto range = chunked_log.fetch_block_range( 8, 15 );
+      BOOST_REQUIRE_EQUAL( range.size(), 15u );
+      for( size_t i = 0; i < range.size(); ++i )
+        BOOST_REQUIRE( range[i]->get_block_id() == ids[ i + 7 ] );
+
+      // ids offered to syncing peer
+      uint32_t remaining_item_count = 0;
+      auto offered = chunked_log.get_block_ids( {}, remaining_item_count, 12 );
+      BOOST_REQUIRE_EQUAL( offered.size(), 12u );
+      BOOST_REQUIRE_EQUAL( remaining_item_count, ids.size() - 12 );
+      for( size_t i = 0; i < offered.size(); ++i )
+        BOOST_REQUIRE( offered[i] == ids[i] );
+      offered = chunked_log.get_block_ids( { ids[2], ids[14], ids[20] }, remaining_item_count, 100 );
+      BOOST_REQUIRE_EQUAL( offered.size(), ids.size() - 20 );
+      BOOST_REQUIRE_EQUAL( remaining_item_count, 0u );
+      BOOST_REQUIRE( offered.front() == ids[20] && offered.back() == ids.back() );
+      block_id_type unknown_id = ids[10];
+      unknown_id._hash[4] ^= 1;
+      HIVE_REQUIRE_THROW( chunked_log.get_block_ids( { unknown_id }, remaining_item_count, 100 ), fc::exception );
+    }
+
+    auto target_log = block_log_wrapper::create_opened_wrapper( target_path / block_log_file_name_info::_legacy_file_name,
+      app, thread_pool, false /*read_only*/ );
+    chunked_block_log::write_to_block_log( chunked_path, *target_log, thread_pool );
+    BOOST_REQUIRE_EQUAL( target_log->head_block_num(), ids.size() );
+    for( uint32_t block_num = 1; block_num <= ids.size(); ++block_num )
+      BOOST_REQUIRE( target_log->read_block_by_num( block_num )->get_block_id() == ids[ block_num - 1 ] );
+    target_log->close_storage();
+
+    // damage middle chunk - opening still works (first and last chunk are fine), reading damaged one fails
+    {
+      chunked_block_log chunked_log( chunked_path );
+      const auto& chunk = chunked_log.get_chunks()[1];
+      std::fstream file( chunked_path.generic_string(), std::ios::in | std::ios::out | std::ios::binary );
+      file.seekg( chunk.file_offset + chunk.compressed_size / 2 );
+      char byte = 0;
+      file.read( &byte, 1 );
+      byte ^= 0x5a;
+      file.seekp( chunk.file_offset + chunk.compressed_size / 2 );
+      file.write( &byte, 1 );
+    }
+    chunked_block_log damaged_log( chunked_path );
+    BOOST_REQUIRE( damaged_log.read_block_by_num( 5 )->get_block_id() == ids[4] );
+    HIVE_REQUIRE_THROW( damaged_log.read_block_by_num( 15 ), fc::assert_exception );
+    HIVE_REQUIRE_THROW( damaged_log.verify(), fc::assert_exception );
+  } catch (fc::exception& e) {
+    edump((e.to_detail_string()));
+    throw;
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 #endif
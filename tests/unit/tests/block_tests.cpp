@@ -36,6 +36,7 @@
 #include <hive/protocol/exceptions.hpp>
 
 #include <hive/chain/database.hpp>
+#include <hive/chain/fork_database.hpp>
 #include <hive/chain/detail/state/convert_request_object.hpp>
 #include <hive/chain/detail/state/collateralized_convert_request_object.hpp>
 #include <hive/chain/detail/state/escrow_object.hpp>
@@ -1955,5 +1956,325 @@ BOOST_FIXTURE_TEST_CASE( init_hive_hbd_supply, init_supply_database_fixture )
   FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_CASE( fork_database_competing_forks )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "--- Benchmarking fork database with many competing forks" );
+
+    const uint32_t MAIN_CHAIN_LENGTH = 1000;
+    const uint32_t FORK_COUNT = 200;
+    const uint32_t FORK_LENGTH = 20;
+
+    fork_database fork_db;
+    fork_db.set_max_size( 2 * MAIN_CHAIN_LENGTH );
+
+    auto make_block = [&]( const block_id_type& previous, const std::string& witness, uint32_t timestamp )
+    {
+      signed_block block;
+      block.previous = previous;
+      block.timestamp = fc::time_point_sec( timestamp );
+      block.witness = witness;
+      return full_block_type::create_from_signed_block( block );
+    };
+
+    std::vector< block_id_type > main_chain;
+    auto genesis = make_block( block_id_type(), "initminer", HIVE_BLOCK_INTERVAL );
+    fork_db.start_block( genesis );
+    main_chain.push_back( genesis->get_block_id() );
+    for( uint32_t i = 1; i < MAIN_CHAIN_LENGTH; ++i )
+    {
+      auto block = make_block( main_chain.back(), "initminer", ( i + 1 ) * HIVE_BLOCK_INTERVAL );
+      fork_db.push_block( block );
+      main_chain.push_back( block->get_block_id() );
+    }
+    BOOST_REQUIRE( fork_db.head()->get_block_id() == main_chain.back() );
+
+    // competing forks branch off the main chain at evenly spaced points; their blocks arrive in reverse order,
+    // so all but the first block of each fork have to wait in unlinked index
+    std::vector< std::pair< uint32_t, block_id_type > > fork_heads;
+    auto time_start = fc::time_point::now();
+    for( uint32_t f = 0; f < FORK_COUNT; ++f )
+    {
+      uint32_t branch_point = ( f * ( MAIN_CHAIN_LENGTH - FORK_LENGTH - 1 ) ) / FORK_COUNT;
+      std::vector< std::shared_ptr< full_block_type > > fork_blocks;
+      block_id_type previous = main_chain[ branch_point ];
+      for( uint32_t i = 0; i < FORK_LENGTH; ++i )
+      {
+        auto block = make_block( previous, "fork" + std::to_string( f ), ( branch_point + i + 2 ) * HIVE_BLOCK_INTERVAL );
+        fork_blocks.push_back( block );
+        previous = block->get_block_id();
+      }
+      for( auto it = fork_blocks.rbegin(); it != fork_blocks.rend(); ++it )
+      {
+        try
+        {
+          fork_db.push_block( *it );
+        }
+        catch( const unlinkable_block_exception& )
+        {
+          BOOST_REQUIRE( it != std::prev( fork_blocks.rend() ) );
+        }
+      }
+      fork_heads.emplace_back( branch_point, previous );
+    }
+    auto duration = fc::time_point::now() - time_start;
+    ilog( "Pushing ${x} fork blocks took ${t}us", ( "x", FORK_COUNT * FORK_LENGTH )( "t", duration.count() ) );
+
+    for( const auto& fork_head : fork_heads )
+      BOOST_REQUIRE( fork_db.is_known_block( fork_head.second ) );
+    BOOST_REQUIRE( fork_db.head()->get_block_id() == main_chain.back() );
+    BOOST_REQUIRE_EQUAL( fork_db.fetch_heads().size(), FORK_COUNT + 1 );
+
+    time_start = fc::time_point::now();
+    for( const auto& fork_head : fork_heads )
+    {
+      auto branches = fork_db.fetch_branch_from( fork_head.second, main_chain.back() );
+      BOOST_REQUIRE_EQUAL( branches.first.size(), FORK_LENGTH );
+      BOOST_REQUIRE_EQUAL( branches.second.size(), MAIN_CHAIN_LENGTH - fork_head.first - 1 );
+      BOOST_REQUIRE( branches.first.back()->previous_id() == main_chain[ fork_head.first ] );
+      BOOST_REQUIRE( branches.second.back()->previous_id() == main_chain[ fork_head.first ] );
+    }
+    duration = fc::time_point::now() - time_start;
+    ilog( "Finding common ancestors of ${x} forks took ${t}us", ( "x", FORK_COUNT )( "t", duration.count() ) );
+
+    auto branches = fork_db.fetch_branch_from( main_chain.back(), main_chain.back() );
+    BOOST_REQUIRE( branches.first.empty() && branches.second.empty() );
+
+    // main branch lookups by number must agree with walking back from head
+    auto check_main_branch = [&]()
+    {
+      auto head = fork_db.head();
+      uint32_t oldest_block_num = fork_db.get_last_irreversible_block_num();
+      BOOST_REQUIRE( !fork_db.fetch_block_on_main_branch_by_number( head->get_block_num() + 1 ) );
+      for( item_ptr item = head; item; item = item->prev.lock() )
+      {
+        auto found = fork_db.fetch_block_on_main_branch_by_number( item->get_block_num() );
+        BOOST_REQUIRE( found == item );
+        oldest_block_num = item->get_block_num();
+      }
+      BOOST_REQUIRE( !fork_db.fetch_block_on_main_branch_by_number( oldest_block_num - 1 ) );
+      auto range = fork_db.fetch_block_range_on_main_branch_by_number( head->get_block_num() - 9, 20 );
+      BOOST_REQUIRE_EQUAL( range.size(), 10u );
+      BOOST_REQUIRE( range.back().get_block_id() == head->get_block_id() );
+      BOOST_REQUIRE( range.front().get_block_id() == fork_db.fetch_block_on_main_branch_by_number( head->get_block_num() - 9 )->get_block_id() );
+    };
+    check_main_branch();
+
+    BOOST_TEST_MESSAGE( "--- Switching main branch to the longest fork" );
+    {
+      const auto& fork_head = fork_heads.front();
+      block_id_type previous = fork_head.second;
+      uint32_t block_num = fork_head.first + FORK_LENGTH + 2;
+      while( block_num <= MAIN_CHAIN_LENGTH + 1 )
+      {
+        auto block = make_block( previous, "fork0", block_num * HIVE_BLOCK_INTERVAL );
+        fork_db.push_block( block );
+        previous = block->get_block_id();
+        ++block_num;
+      }
+      BOOST_REQUIRE( fork_db.head()->get_block_id() == previous );
+      BOOST_REQUIRE_EQUAL( fork_db.head()->get_block_num(), MAIN_CHAIN_LENGTH + 1 );
+      BOOST_REQUIRE( fork_db.fetch_block_on_main_branch_by_number( fork_head.first + 1 )->get_block_id() == main_chain[ fork_head.first ] );
+      BOOST_REQUIRE( fork_db.fetch_block_on_main_branch_by_number( fork_head.first + 2 )->get_block_id() != main_chain[ fork_head.first + 1 ] );
+      check_main_branch();
+    }
+
+    fork_db.pop_block();
+    fork_db.pop_block();
+    check_main_branch();
+
+    time_start = fc::time_point::now();
+    for( const auto& fork_head : fork_heads )
+    {
+      fork_db.set_head( fork_db.fetch_block( fork_head.second ) );
+      BOOST_REQUIRE( fork_db.fetch_block_on_main_branch_by_number( fork_head.first + 1 )->get_block_id() == main_chain[ fork_head.first ] );
+      BOOST_REQUIRE( fork_db.fetch_block_on_main_branch_by_number( fork_head.first + FORK_LENGTH + 1 )->get_block_id() == fork_head.second );
+    }
+    fork_db.set_head( fork_db.fetch_block( main_chain.back() ) );
+    duration = fc::time_point::now() - time_start;
+    ilog( "Switching main branch between ${x} forks took ${t}us", ( "x", FORK_COUNT )( "t", duration.count() ) );
+    check_main_branch();
+    for( uint32_t i = 0; i < MAIN_CHAIN_LENGTH; ++i )
+      BOOST_REQUIRE( fork_db.fetch_block_on_main_branch_by_number( i + 1 )->get_block_id() == main_chain[ i ] );
+
+    fork_db.remove( main_chain.back() );
+    BOOST_REQUIRE( fork_db.head()->get_block_id() == main_chain[ MAIN_CHAIN_LENGTH - 2 ] );
+    BOOST_REQUIRE( !fork_db.fetch_block_on_main_branch_by_number( MAIN_CHAIN_LENGTH ) );
+    check_main_branch();
+  }
+  FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE( block_transactions_cache_expiration )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "--- Testing that cached transactions of decoded block expire when all of them are released" );
+
+    const uint32_t TRANSACTION_COUNT = 3;
+    auto& cache = full_transaction_cache::get_instance();
+
+    // recent timestamp, so decoding the block puts its transactions in the cache
+    signed_block block;
+    block.timestamp = fc::time_point_sec( fc::time_point::now() );
+    block.witness = "initminer";
+    for( uint32_t i = 0; i < TRANSACTION_COUNT; ++i )
+    {
+      signed_transaction tx;
+      tx.ref_block_num = i;
+      tx.ref_block_prefix = block.timestamp.sec_since_epoch();
+      tx.set_expiration( block.timestamp + HIVE_MAX_TIME_UNTIL_EXPIRATION );
+      block.transactions.push_back( tx );
+    }
+
+    auto full_block = full_block_type::create_from_signed_block( block );
+    std::vector< full_transaction_ptr > block_transactions = full_block->get_full_transactions();
+    BOOST_REQUIRE_EQUAL( block_transactions.size(), TRANSACTION_COUNT );
+    std::vector< std::weak_ptr< full_transaction_type > > weak_transactions( block_transactions.begin(), block_transactions.end() );
+
+    auto lookup = [&]( uint32_t i )
+    {
+      // adding equivalent transaction returns the one already in cache as long as it is alive
+      full_transaction_ptr fresh = full_transaction_type::create_from_signed_transaction( block.transactions[i], pack_type::legacy, false );
+      full_transaction_ptr found = cache.add_to_cache( fresh );
+      return found != fresh;
+    };
+
+    for( uint32_t i = 0; i < TRANSACTION_COUNT; ++i )
+      BOOST_REQUIRE( lookup( i ) );
+
+    // a single live transaction keeps its siblings alive as well, since they share one allocation
+    full_transaction_ptr last = block_transactions.back();
+    block_transactions.clear();
+    full_block.reset();
+    for( uint32_t i = 0; i < TRANSACTION_COUNT; ++i )
+      BOOST_REQUIRE( !weak_transactions[i].expired() );
+    BOOST_REQUIRE( lookup( 0 ) );
+
+    last.reset();
+    for( uint32_t i = 0; i < TRANSACTION_COUNT; ++i )
+    {
+      BOOST_REQUIRE( weak_transactions[i].expired() );
+      BOOST_REQUIRE( !lookup( i ) );
+    }
+  }
+  FC_LOG_AND_RETHROW()
+}
+
+BOOST_FIXTURE_TEST_CASE( witness_schedule_and_median_props, clean_database_fixture )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "--- Checking witness schedule and median props against full recomputation" );
+
+    const int EXTRA_WITNESSES = 12;
+    for( int i = 0; i < EXTRA_WITNESSES; ++i )
+    {
+      const string name = "sched" + fc::to_string( i );
+      account_create( name, init_account_pub_key );
+      fund( name, HIVE_MIN_PRODUCER_REWARD );
+      witness_create( name, init_account_priv_key, "foo.bar", init_account_pub_key, HIVE_MIN_PRODUCER_REWARD.amount );
+    }
+    generate_block();
+
+    const auto& widx = db->get_index< witness_index, by_vote_name >();
+    const auto& schedule_idx = db->get_index< witness_index, by_schedule_time >();
+
+    for( uint32_t round = 0; round < 8; ++round )
+    {
+      // reshuffle votes (with ties), props (with duplicates) and disabled witnesses so each round
+      // promotes, demotes and keeps different witnesses in their roles
+      db_plugin->debug_update( [=]( database& db )
+      {
+        // witnesses in current or future schedule still have to sign their blocks, so only idle ones can be disabled
+        flat_set< account_name_type > scheduled;
+        for( const witness_schedule_object* wso : { &db.get_witness_schedule_object(), &db.get_future_witness_schedule_object() } )
+          scheduled.insert( wso->current_shuffled_witnesses.begin(), wso->current_shuffled_witnesses.begin() + wso->num_scheduled_witnesses );
+
+        uint32_t i = 0;
+        for( const auto& witness : db.get_index< witness_index, by_name >() )
+        {
+          db.modify( witness, [&]( witness_object& w )
+          {
+            w.votes = 1000 * ( ( i * 7 + round * 5 ) % 9 + 1 );
+            w.props.account_creation_fee = HIVE_asset( HIVE_MIN_ACCOUNT_CREATION_FEE + ( i * 3 + round ) % 7 * 1000 );
+            w.props.maximum_block_size = HIVE_MIN_BLOCK_SIZE_LIMIT * ( 2 + ( i * 5 + round * 3 ) % 6 );
+            w.props.hbd_interest_rate = uint16_t( ( i * 11 + round * 7 ) % 13 * 100 );
+            w.props.account_subsidy_budget = HIVE_DEFAULT_ACCOUNT_SUBSIDY_BUDGET + int32_t( ( i + round * 2 ) % 5 * 100 );
+            w.props.account_subsidy_decay = HIVE_DEFAULT_ACCOUNT_SUBSIDY_DECAY + uint32_t( ( i * 13 + round ) % 4 * 1000 );
+            const bool disable = ( i + round ) % 4 == 1 && scheduled.count( w.owner ) == 0;
+            w.signing_key = disable ? public_key_type() : init_account_pub_key;
+          } );
+          ++i;
+        }
+      } );
+
+      while( ( db->head_block_num() + 1 ) % HIVE_MAX_WITNESSES != 0 )
+        generate_block();
+
+      // predict the schedule the next block is going to compute for the future witness set
+      flat_set< account_name_type > expected_elected;
+      flat_set< account_name_type > expected_timeshare;
+      for( auto itr = widx.begin(); itr != widx.end() && expected_elected.size() < db->get_future_witness_schedule_object().max_voted_witnesses; ++itr )
+      {
+        if( !itr->is_disabled() )
+          expected_elected.insert( itr->owner );
+      }
+      for( auto itr = schedule_idx.begin(); itr != schedule_idx.end() && expected_elected.size() + expected_timeshare.size() < HIVE_MAX_WITNESSES; ++itr )
+      {
+        if( !itr->is_disabled() && expected_elected.count( itr->owner ) == 0 )
+          expected_timeshare.insert( itr->owner );
+      }
+
+      generate_block();
+      BOOST_REQUIRE_EQUAL( db->head_block_num() % HIVE_MAX_WITNESSES, 0u );
+
+      const witness_schedule_object& future_wso = db->get_future_witness_schedule_object();
+      BOOST_REQUIRE_EQUAL( int( future_wso.num_scheduled_witnesses ), HIVE_MAX_WITNESSES );
+
+      std::vector< chain_properties > active_props;
+      for( int i = 0; i < future_wso.num_scheduled_witnesses; ++i )
+      {
+        const witness_object& witness = db->get_witness( future_wso.current_shuffled_witnesses[i] );
+        if( expected_elected.count( witness.owner ) )
+        {
+          BOOST_REQUIRE( witness.schedule == witness_object::elected );
+        }
+        else
+        {
+          BOOST_REQUIRE( expected_timeshare.count( witness.owner ) );
+          BOOST_REQUIRE( witness.schedule == witness_object::timeshare );
+        }
+        active_props.push_back( witness.props );
+      }
+
+      // medians as computed by full sort
+      const size_t median = active_props.size() / 2;
+      auto median_of = [&]( auto&& get )
+      {
+        std::vector< decltype( get( active_props[0] ) ) > values;
+        for( const auto& props : active_props )
+          values.push_back( get( props ) );
+        std::sort( values.begin(), values.end() );
+        return values[ median ];
+      };
+      BOOST_REQUIRE_EQUAL( future_wso.median_props.account_creation_fee.amount.value,
+        median_of( []( const chain_properties& p ) { return p.account_creation_fee.amount.value; } ) );
+      BOOST_REQUIRE_EQUAL( future_wso.median_props.maximum_block_size,
+        median_of( []( const chain_properties& p ) { return p.maximum_block_size; } ) );
+      BOOST_REQUIRE_EQUAL( future_wso.median_props.hbd_interest_rate,
+        median_of( []( const chain_properties& p ) { return p.hbd_interest_rate; } ) );
+      BOOST_REQUIRE_EQUAL( future_wso.median_props.account_subsidy_budget,
+        median_of( []( const chain_properties& p ) { return p.account_subsidy_budget; } ) );
+      BOOST_REQUIRE_EQUAL( future_wso.median_props.account_subsidy_decay,
+        median_of( []( const chain_properties& p ) { return p.account_subsidy_decay; } ) );
+    }
+
+    validate_database();
+  }
+  FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 #endif
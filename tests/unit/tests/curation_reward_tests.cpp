@@ -528,8 +528,8 @@ struct curation_rewards_handler
 
     for( auto& item : curve_printers[ comment_idx ].curve_items )
     {
-      const auto& acc = db.get_account( item.account );
-      item.reward = static_cast<uint32_t>( acc.curation_rewards.get_amount() );
+      const auto* details = db.find_account_details( db.get_account( item.account ) );
+      item.reward = details ? static_cast<uint32_t>( details->curation_rewards.get_amount() ) : 0;
 
       uint64_t _seconds = static_cast<uint64_t>( ( item.time - curve_printers[ comment_idx ].start_time ).to_seconds() );
 
@@ -555,8 +555,8 @@ struct curation_rewards_handler
 
     for( auto& item : curve_printers[ comment_idx ].curve_items )
     {
-      const auto& acc = db.get_account( item.account );
-      item.reward = static_cast<uint32_t>( acc.curation_rewards.get_amount() );
+      const auto* details = db.find_account_details( db.get_account( item.account ) );
+      item.reward = details ? static_cast<uint32_t>( details->curation_rewards.get_amount() ) : 0;
 
       uint64_t _seconds = static_cast<uint64_t>( ( item.time - curve_printers[ comment_idx ].start_time ).to_seconds() );
 
@@ -924,8 +924,8 @@ BOOST_AUTO_TEST_CASE( no_votes )
 
     auto found_author = crh.authors.find( author_number );
     BOOST_REQUIRE( found_author != crh.authors.end() );
-    const auto& creator = db->get_account( found_author->second );
-    BOOST_REQUIRE_EQUAL( creator.posting_rewards.get_amount(), 0 );
+    const auto* creator_details = db->find_account_details( db->get_account( found_author->second ) );
+    BOOST_REQUIRE( creator_details == nullptr || creator_details->posting_rewards.get_amount() == 0 );
 
     auto cmp = []( const reward_stat& item )
     {
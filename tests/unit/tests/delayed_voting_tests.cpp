@@ -1001,6 +1001,203 @@ BOOST_AUTO_TEST_CASE( delayed_voting_proxy_01 )
   FC_LOG_AND_RETHROW()
 }
 
+struct delayed_voting_batch_fixture : public delayed_vote_database_fixture
+{
+  struct witness_state
+  {
+    account_name_type owner;
+    share_type        votes;
+    fc::uint128       virtual_position;
+    fc::uint128       virtual_last_update;
+    fc::uint128       virtual_scheduled_time;
+  };
+  struct proxy_state
+  {
+    account_name_type name;
+    std::array< share_type, HIVE_MAX_PROXY_RECURSION_DEPTH > proxied_vsf_votes;
+  };
+  struct final_state
+  {
+    std::vector< witness_state > witnesses;
+    std::vector< proxy_state > proxies;
+  };
+
+  final_state take_state() const
+  {
+    final_state result;
+    for( const auto& w : db->get_index< witness_index, by_name >() )
+      result.witnesses.push_back( { w.owner, w.votes, w.virtual_position, w.virtual_last_update, w.virtual_scheduled_time } );
+    for( const char* name : { "celine", "dan" } )
+    {
+      const auto& a = db->get_account( name );
+      proxy_state proxy{ a.get_name() };
+      for( int d = 0; d < HIVE_MAX_PROXY_RECURSION_DEPTH; ++d )
+        proxy.proxied_vsf_votes[d] = a.proxied_vsf_votes[d];
+      result.proxies.push_back( proxy );
+    }
+    return result;
+  }
+
+  // votes of many accounts behind chain of proxies change in the same block; returns state after delayed votes
+  // mature and state after power downs
+  std::pair< final_state, final_state > run_scenario()
+  {
+    std::pair< final_state, final_state > result;
+
+    ACTORS( (alice)(bob)(celine)(dan)(eve)(witness)(witness2) )
+    generate_block();
+
+    {
+      BOOST_TEST_MESSAGE( "Preparing accounts..." );
+
+      set_price_feed( HBD_price( 1000, 1000 ) );
+      generate_block();
+
+      ISSUE_FUNDS( "alice", HIVE_asset( 10'000'000 ) );
+      ISSUE_FUNDS( "bob", HIVE_asset( 10'000'000 ) );
+      ISSUE_FUNDS( "celine", HIVE_asset( 10'000'000 ) );
+      ISSUE_FUNDS( "dan", HIVE_asset( 10'000'000 ) );
+      ISSUE_FUNDS( "eve", HIVE_asset( 10'000'000 ) );
+      ISSUE_FUNDS( "witness", HIVE_asset( 10'000'000 ) );
+      ISSUE_FUNDS( "witness2", HIVE_asset( 10'000'000 ) );
+    }
+    {
+      BOOST_TEST_MESSAGE( "Preparing witnesses..." );
+
+      witness_create( "witness", witness_private_key, "url.witness", witness_private_key.get_public_key(), HIVE_MIN_PRODUCER_REWARD.amount );
+      witness_plugin->add_signing_key( witness_private_key );
+      witness_create( "witness2", witness2_private_key, "url.witness2", witness2_private_key.get_public_key(), HIVE_MIN_PRODUCER_REWARD.amount );
+      witness_plugin->add_signing_key( witness2_private_key );
+      generate_block();
+    }
+
+    share_type votes_01 = get_votes( "witness" );
+    share_type votes_02 = get_votes( "witness2" );
+
+    auto check_votes = [&]()
+    {
+      auto v_alice   = get_vesting( "alice" );
+      auto v_bob     = get_vesting( "bob" );
+      auto v_celine  = get_vesting( "celine" );
+      auto v_dan     = get_vesting( "dan" );
+      auto v_eve     = get_vesting( "eve" );
+
+      BOOST_REQUIRE_EQUAL( PROXIED_VSF( "celine" ), ( v_alice + v_bob ).amount.value );
+      BOOST_REQUIRE_EQUAL( PROXIED_VSF( "dan" ), ( v_alice + v_bob + v_celine ).amount.value );
+      BOOST_REQUIRE_EQUAL( get_votes( "witness" ), votes_01 + ( v_alice + v_bob + v_celine + v_dan ).amount.value );
+      BOOST_REQUIRE_EQUAL( get_votes( "witness2" ), votes_02 + ( v_alice + v_bob + v_celine + v_dan + v_eve ).amount.value );
+    };
+
+    {
+      BOOST_TEST_MESSAGE( "Creating chain of proxies: alice, bob -> celine -> dan -> witness, witness2 <- eve..." );
+
+      proxy( "alice", "celine", alice_private_key );
+      proxy( "bob", "celine", bob_private_key );
+      proxy( "celine", "dan", celine_private_key );
+      witness_vote( "dan", "witness", true/*approve*/, dan_private_key );
+      witness_vote( "dan", "witness2", true/*approve*/, dan_private_key );
+      witness_vote( "eve", "witness2", true/*approve*/, eve_private_key );
+      generate_block();
+    }
+    {
+      BOOST_TEST_MESSAGE( "Delayed votes of all accounts mature in the same block..." );
+
+      vest( "alice", "alice",    HIVE_asset( 1'000 ), alice_private_key );
+      vest( "bob", "bob",        HIVE_asset( 2'000 ), bob_private_key );
+      vest( "celine", "celine",  HIVE_asset( 3'000 ), celine_private_key );
+      vest( "dan", "dan",        HIVE_asset( 4'000 ), dan_private_key );
+      vest( "eve", "eve",        HIVE_asset( 5'000 ), eve_private_key );
+      generate_block();
+
+      generate_blocks( db->head_block_time() + HIVE_DELAYED_VOTING_TOTAL_INTERVAL_SECONDS, true );
+      generate_block();
+
+      BOOST_REQUIRE_EQUAL( DELAYED_VOTES( "alice" ), 0 );
+      BOOST_REQUIRE_EQUAL( DELAYED_VOTES( "bob" ), 0 );
+      BOOST_REQUIRE_EQUAL( DELAYED_VOTES( "celine" ), 0 );
+      BOOST_REQUIRE_EQUAL( DELAYED_VOTES( "dan" ), 0 );
+      BOOST_REQUIRE_EQUAL( DELAYED_VOTES( "eve" ), 0 );
+      check_votes();
+      result.first = take_state();
+    }
+    {
+      BOOST_TEST_MESSAGE( "Power downs of many accounts processed in the same block..." );
+
+      withdraw_vesting( "alice", get_vesting( "alice" ), alice_private_key );
+      withdraw_vesting( "bob", get_vesting( "bob" ), bob_private_key );
+      withdraw_vesting( "celine", get_vesting( "celine" ), celine_private_key );
+      withdraw_vesting( "eve", get_vesting( "eve" ), eve_private_key );
+      generate_block();
+
+      auto v_alice = get_vesting( "alice" );
+      auto next_withdrawal = db->get_account( "alice" ).next_vesting_withdrawal;
+      BOOST_REQUIRE( db->get_account( "bob" ).next_vesting_withdrawal == next_withdrawal );
+      BOOST_REQUIRE( db->get_account( "celine" ).next_vesting_withdrawal == next_withdrawal );
+      BOOST_REQUIRE( db->get_account( "eve" ).next_vesting_withdrawal == next_withdrawal );
+      generate_blocks( next_withdrawal, true );
+      generate_block();
+
+      BOOST_REQUIRE( get_vesting( "alice" ) < v_alice );
+      check_votes();
+      result.second = take_state();
+    }
+
+    validate_database();
+    return result;
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE( delayed_voting_proxy_batched, empty_fixture )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "Testing: votes of many accounts behind chain of proxies changing in the same block" );
+
+    BOOST_TEST_MESSAGE( "Changes of witness votes applied in batches..." );
+    std::pair< delayed_voting_batch_fixture::final_state, delayed_voting_batch_fixture::final_state > batched;
+    {
+      delayed_voting_batch_fixture fixture;
+      batched = fixture.run_scenario();
+    }
+
+    BOOST_TEST_MESSAGE( "Changes of witness votes applied one by one..." );
+    configuration_data.batch_witness_votes = false;
+    autoscope reset_batching( []() { configuration_data.batch_witness_votes = true; } );
+    std::pair< delayed_voting_batch_fixture::final_state, delayed_voting_batch_fixture::final_state > unbatched;
+    {
+      delayed_voting_batch_fixture fixture;
+      unbatched = fixture.run_scenario();
+    }
+
+    // both ways have to lead to exactly the same witness schedule related values
+    auto compare = []( const delayed_voting_batch_fixture::final_state& a, const delayed_voting_batch_fixture::final_state& b )
+    {
+      BOOST_REQUIRE_EQUAL( a.witnesses.size(), b.witnesses.size() );
+      for( size_t i = 0; i < a.witnesses.size(); ++i )
+      {
+        const auto& wa = a.witnesses[i];
+        const auto& wb = b.witnesses[i];
+        BOOST_TEST_MESSAGE( "Comparing witness " << std::string( wa.owner ) );
+        BOOST_REQUIRE( wa.owner == wb.owner );
+        BOOST_REQUIRE_EQUAL( wa.votes.value, wb.votes.value );
+        BOOST_REQUIRE( wa.virtual_position == wb.virtual_position );
+        BOOST_REQUIRE( wa.virtual_last_update == wb.virtual_last_update );
+        BOOST_REQUIRE( wa.virtual_scheduled_time == wb.virtual_scheduled_time );
+      }
+      BOOST_REQUIRE_EQUAL( a.proxies.size(), b.proxies.size() );
+      for( size_t i = 0; i < a.proxies.size(); ++i )
+      {
+        BOOST_REQUIRE( a.proxies[i].name == b.proxies[i].name );
+        for( int d = 0; d < HIVE_MAX_PROXY_RECURSION_DEPTH; ++d )
+          BOOST_REQUIRE_EQUAL( a.proxies[i].proxied_vsf_votes[d].value, b.proxies[i].proxied_vsf_votes[d].value );
+      }
+    };
+    compare( batched.first, unbatched.first );
+    compare( batched.second, unbatched.second );
+  }
+  FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_CASE( delayed_voting_many_vesting_01 )
 {
   try
@@ -172,7 +172,7 @@ BOOST_AUTO_TEST_CASE( account_create_apply )
     BOOST_REQUIRE_EQUAL( acct.get_name(), "alice" );
     BOOST_REQUIRE( acct_auth.owner == authority( 1, priv_key.get_public_key(), 1 ) );
     BOOST_REQUIRE( acct_auth.active == authority( 2, priv_key.get_public_key(), 2 ) );
-    BOOST_REQUIRE( acct.memo_key == priv_key.get_public_key() );
+    BOOST_REQUIRE( db->find_account_details( acct )->memo_key == priv_key.get_public_key() );
     CHECK_NO_PROXY( acct );
     BOOST_REQUIRE_EQUAL( acct.get_creation_time(), db->head_block_time() );
     BOOST_REQUIRE_EQUAL( acct.get_hive_balance(), HIVE_asset( 0 ) );
@@ -192,7 +192,7 @@ BOOST_AUTO_TEST_CASE( account_create_apply )
     BOOST_REQUIRE_EQUAL( acct.get_name(), "alice" );
     BOOST_REQUIRE( acct_auth.owner == authority( 1, priv_key.get_public_key(), 1 ) );
     BOOST_REQUIRE( acct_auth.active == authority( 2, priv_key.get_public_key(), 2 ) );
-    BOOST_REQUIRE( acct.memo_key == priv_key.get_public_key() );
+    BOOST_REQUIRE( db->find_account_details( acct )->memo_key == priv_key.get_public_key() );
     CHECK_NO_PROXY( acct );
     BOOST_REQUIRE_EQUAL( acct.get_creation_time(), db->head_block_time() );
     BOOST_REQUIRE_EQUAL( acct.get_hive_balance(), HIVE_asset( 0 ) );
@@ -382,7 +382,7 @@ BOOST_AUTO_TEST_CASE( account_update_apply )
     BOOST_REQUIRE_EQUAL( acct.get_name(), "alice" );
     BOOST_REQUIRE( acct_auth.owner == authority( 1, new_private_key.get_public_key(), 1 ) );
     BOOST_REQUIRE( acct_auth.active == authority( 2, new_private_key.get_public_key(), 2 ) );
-    BOOST_REQUIRE( acct.memo_key == new_private_key.get_public_key() );
+    BOOST_REQUIRE( db->find_account_details( acct )->memo_key == new_private_key.get_public_key() );
 
     validate_database();
 
@@ -9090,7 +9090,7 @@ BOOST_AUTO_TEST_CASE( create_claimed_account_apply )
     BOOST_REQUIRE( bob_auth.owner == authority( 1, priv_key.get_public_key(), 1 ) );
     BOOST_REQUIRE( bob_auth.active == authority( 2, priv_key.get_public_key(), 2 ) );
     BOOST_REQUIRE( bob_auth.posting == authority( 3, priv_key.get_public_key(), 3 ) );
-    BOOST_REQUIRE( bob.memo_key == priv_key.get_public_key() );
+    BOOST_REQUIRE( db->find_account_details( bob )->memo_key == priv_key.get_public_key() );
 
     CHECK_NO_PROXY( bob );
     BOOST_REQUIRE_EQUAL( bob.get_recovery_account(), alice_id );
@@ -9533,7 +9533,7 @@ BOOST_AUTO_TEST_CASE( account_update2_apply )
     BOOST_REQUIRE_EQUAL( acct.get_name(), "alice" );
     BOOST_REQUIRE( acct_auth.owner == authority( 1, new_private_key.get_public_key(), 1 ) );
     BOOST_REQUIRE( acct_auth.active == authority( 2, new_private_key.get_public_key(), 2 ) );
-    BOOST_REQUIRE( acct.memo_key == new_private_key.get_public_key() );
+    BOOST_REQUIRE( db->find_account_details( acct )->memo_key == new_private_key.get_public_key() );
 
     validate_database();
 
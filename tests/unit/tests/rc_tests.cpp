@@ -1629,6 +1629,62 @@ BOOST_AUTO_TEST_CASE( rc_exception_during_modify )
   BOOST_REQUIRE_EQUAL( expected_exception_found, true );
 }
 
+BOOST_AUTO_TEST_CASE( rc_batched_cost )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "Testing that cost calculated for all resources at once matches calculation per resource" );
+
+    inject_hardfork( HIVE_BLOCKCHAIN_VERSION.minor_v() );
+    generate_block();
+
+    const auto& params = db->get< rc_resource_param_object, by_id >( rc_resource_param_id_type() );
+    const auto& pools = db->get< rc_pool_object, by_id >( rc_pool_id_type() );
+
+    auto check = [&]( int64_t rc_regen, const resource_count_type& raw_usage )
+    {
+      resource_count_type usage = raw_usage;
+      resource_cost_type cost;
+      int64_t total_cost = resource_credits::compute_cost( params, pools, rc_regen, usage, cost );
+
+      int64_t expected_total_cost = 0;
+      for( int i = 0; i < HIVE_RC_NUM_RESOURCE_TYPES; ++i )
+      {
+        const auto& resource_params = params.resource_param_array[i];
+        int64_t expected_usage = raw_usage[i] * int64_t( resource_params.resource_dynamics_params.resource_unit );
+        int64_t regen_share = fc::uint128_to_int64( ( fc::uint128_t( rc_regen ) * pools.get_weight(i) ) / pools.get_weight_divisor() );
+        int64_t expected_cost = 0;
+        if( regen_share > 0 )
+          expected_cost = resource_credits::compute_cost( resource_params.price_curve_params, pools.get_pool(i), expected_usage, regen_share );
+        BOOST_CHECK_EQUAL( usage[i], expected_usage );
+        BOOST_CHECK_EQUAL( cost[i], expected_cost );
+        expected_total_cost += expected_cost;
+      }
+      BOOST_CHECK_EQUAL( total_cost, expected_total_cost );
+    };
+
+    resource_count_type usage;
+    usage[ resource_history_bytes ] = 250;
+    usage[ resource_new_accounts ] = 1;
+    usage[ resource_market_bytes ] = 250;
+    usage[ resource_state_bytes ] = 120000;
+    usage[ resource_execution_time ] = 4000;
+    // small regen (64-bit path), current regen, then values that need full 128-bit arithmetic
+    int64_t rc_regen = db->get_dynamic_global_properties().get_total_vesting_shares().amount.value / ( HIVE_RC_REGEN_TIME / HIVE_BLOCK_INTERVAL );
+    check( 1000, usage );
+    check( rc_regen, usage );
+    check( rc_regen * 1000000, usage );
+    usage[ resource_state_bytes ] = -120000; // negative usage (state discount) gives negative cost
+    check( rc_regen, usage );
+
+    BOOST_TEST_MESSAGE( "No cost when there is no regen" );
+    resource_cost_type cost;
+    BOOST_CHECK_EQUAL( resource_credits::compute_cost( params, pools, 0, usage, cost ), 0 );
+    BOOST_CHECK_EQUAL( usage[ resource_history_bytes ], 250 );
+  }
+  FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif
@@ -703,6 +703,111 @@ BOOST_AUTO_TEST_CASE( legacy_signed_transaction )
   );
 }
 
+BOOST_AUTO_TEST_CASE( transaction_digests_test )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "Testing that digests of transaction match hashes of its plain serialization" );
+
+    signed_transaction tx;
+    tx.ref_block_num = 4000;
+    tx.ref_block_prefix = 4000000000;
+    tx.expiration = fc::time_point_sec( 1514764800 );
+    // operations of different sizes, some of them bigger than internal buffer of hash stream
+    for( size_t memo_size : { 0, 10, 500, 1023, 1024, 3000 } )
+    {
+      transfer_operation op;
+      op.from = "alice";
+      op.to = "bob";
+      op.amount = asset( 100 + memo_size, HIVE_SYMBOL );
+      op.memo = std::string( memo_size, 'x' );
+      tx.operations.push_back( op );
+    }
+    tx.signatures.resize( 2 );
+    const chain_id_type chain_id = HIVE_CHAIN_ID;
+
+    for( auto pack : { hive::protocol::pack_type::legacy, hive::protocol::pack_type::hf26 } )
+    {
+      hive::protocol::serialization_mode_controller::pack_guard guard( pack );
+      auto packed = fc::raw::pack_to_vector( static_cast< const transaction& >( tx ) );
+      auto packed_signed = fc::raw::pack_to_vector( tx );
+      auto packed_chain_id = fc::raw::pack_to_vector( chain_id );
+      packed_chain_id.insert( packed_chain_id.end(), packed.begin(), packed.end() );
+
+      BOOST_REQUIRE( tx.digest( pack ) == digest_type::hash( packed.data(), packed.size() ) );
+      BOOST_REQUIRE( tx.merkle_digest( pack ) == digest_type::hash( packed_signed.data(), packed_signed.size() ) );
+      BOOST_REQUIRE( tx.sig_digest( chain_id, pack ) == digest_type::hash( packed_chain_id.data(), packed_chain_id.size() ) );
+    }
+  }
+  FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE( fixed_string_raw_test )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "Testing that fixed_string packs the same way as std::string" );
+
+    for( const std::string& name : { std::string(), std::string( "a" ), std::string( "alice" ), std::string( "initminer" ),
+      std::string( 15, 'x' ), std::string( 16, 'y' ) } )
+    {
+      account_name_type fixed_name( name );
+      BOOST_REQUIRE( fc::raw::pack_to_vector( fixed_name ) == fc::raw::pack_to_vector( name ) );
+      BOOST_REQUIRE_EQUAL( fc::raw::pack_size( fixed_name ), fc::raw::pack_size( name ) );
+      BOOST_REQUIRE( fc::raw::unpack_from_vector< account_name_type >( fc::raw::pack_to_vector( fixed_name ) ) == fixed_name );
+    }
+    for( size_t length : { 0, 1, 16, 17, 31, 32 } )
+    {
+      const std::string id( length, 'z' );
+      custom_id_type fixed_id( id );
+      BOOST_REQUIRE( fc::raw::pack_to_vector( fixed_id ) == fc::raw::pack_to_vector( id ) );
+      BOOST_REQUIRE_EQUAL( fc::raw::pack_size( fixed_id ), fc::raw::pack_size( id ) );
+    }
+  }
+  FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE( full_transaction_serialization_test )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "Testing that serialized data of full transaction matches its content after signing" );
+
+    transaction tx;
+    tx.ref_block_num = 4000;
+    tx.ref_block_prefix = 4000000000;
+    tx.expiration = fc::time_point_sec( 1514764800 );
+    transfer_operation op;
+    op.from = "alice";
+    op.to = "bob";
+    op.amount = asset( 100, HIVE_SYMBOL );
+    op.memo = "test";
+    tx.operations.push_back( op );
+    const chain_id_type chain_id = HIVE_CHAIN_ID;
+    const std::vector< fc::ecc::private_key > keys = { generate_private_key( "alice" ), generate_private_key( "bob" ) };
+
+    for( auto pack : { hive::protocol::pack_type::legacy, hive::protocol::pack_type::hf26 } )
+    {
+      auto full_tx = hive::chain::full_transaction_type::create_from_transaction( tx, pack );
+      full_tx->sign_transaction( keys, chain_id, pack );
+      const signed_transaction& signed_tx = full_tx->get_transaction();
+      BOOST_REQUIRE_EQUAL( signed_tx.signatures.size(), 2u );
+
+      hive::protocol::serialization_mode_controller::pack_guard guard( pack );
+      auto packed = fc::raw::pack_to_vector( signed_tx );
+      const auto& serialized = full_tx->get_serialized_transaction();
+      BOOST_REQUIRE_EQUAL( full_tx->get_transaction_size(), packed.size() );
+      BOOST_REQUIRE( memcmp( serialized.begin, packed.data(), packed.size() ) == 0 );
+      BOOST_REQUIRE_EQUAL( size_t( serialized.transaction_end - serialized.begin ), fc::raw::pack_size( tx ) );
+      BOOST_REQUIRE( full_tx->get_transaction_id() == signed_tx.id( pack ) );
+      BOOST_REQUIRE( full_tx->get_merkle_digest() == signed_tx.merkle_digest( pack ) );
+      BOOST_REQUIRE( full_tx->compute_sig_digest( chain_id ) == signed_tx.sig_digest( chain_id, pack ) );
+      BOOST_REQUIRE_EQUAL( full_tx->is_legacy_pack(), pack == hive::protocol::pack_type::legacy );
+    }
+  }
+  FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_CASE( static_variant_json_test )
 {
   try
@@ -168,6 +168,19 @@ private: //just because it is (almost unused) part of signal registration
   virtual void plugin_shutdown() override {}
 };
 
+struct operation_log : appbase::plugin< operation_log >
+{
+  std::vector< std::pair< char, int64_t > > entries; // handler id and operation::which()
+
+  static const std::string& name() { static std::string name = "test"; return name; }
+private: //just because it is (almost unused) part of signal registration
+  virtual void set_program_options( appbase::options_description& cli, appbase::options_description& cfg ) override {}
+  virtual void plugin_for_each_dependency( plugin_processor&& processor ) override {}
+  virtual void plugin_initialize( const appbase::variables_map& options ) override {}
+  virtual void plugin_startup() override {}
+  virtual void plugin_shutdown() override {}
+};
+
 BOOST_FIXTURE_TEST_SUITE( tx_status_tests, clean_database_fixture )
 
 BOOST_AUTO_TEST_CASE( regular_transactions )
@@ -761,5 +774,73 @@ BOOST_AUTO_TEST_CASE( failure_during_fork_switch )
   FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_CASE( typed_operation_handlers )
+{
+  try
+  {
+    BOOST_TEST_MESSAGE( "Testing handlers registered for selected operation types" );
+
+    ACTORS( (alice)(bob) )
+    generate_block();
+    fund( "alice", HIVE_asset( 10'000 ) );
+    generate_block();
+
+    operation_log ops_log;
+
+    const int64_t transfer_tag = operation::tag< transfer_operation >::value;
+    const int64_t vesting_tag = operation::tag< transfer_to_vesting_operation >::value;
+
+    // generic handler registered with later group than typed ones - it is still called first
+    auto generic_conn = db->add_post_apply_operation_handler(
+      [&]( const operation_notification& note ){ ops_log.entries.emplace_back( 'g', note.op.which() ); }, ops_log, 1 );
+    auto a_conns = db->add_post_apply_operation_handler_for< transfer_operation >(
+      [&]( const operation_notification& note ){ ops_log.entries.emplace_back( 'a', note.op.which() ); }, ops_log, 1 );
+    auto b_conns = db->add_post_apply_operation_handler_for< transfer_operation, transfer_to_vesting_operation >(
+      [&]( const operation_notification& note ){ ops_log.entries.emplace_back( 'b', note.op.which() ); }, ops_log, 0 );
+    auto p_conns = db->add_pre_apply_operation_handler_for< transfer_operation >(
+      [&]( const operation_notification& note ){ ops_log.entries.emplace_back( 'p', note.op.which() ); }, ops_log, 0 );
+    BOOST_REQUIRE_EQUAL( a_conns.size(), 1u );
+    BOOST_REQUIRE_EQUAL( b_conns.size(), 2u );
+
+    BOOST_SCOPE_EXIT( &generic_conn, &a_conns, &b_conns, &p_conns )
+    {
+      hive::utilities::disconnect_signal( generic_conn );
+      hive::utilities::disconnect_signal( a_conns );
+      hive::utilities::disconnect_signal( b_conns );
+      hive::utilities::disconnect_signal( p_conns );
+    } BOOST_SCOPE_EXIT_END
+
+    BOOST_TEST_MESSAGE( "Transfer reaches all typed handlers, in group order, after generic one" );
+    transfer( "alice", "bob", HIVE_asset( 1'000 ).to_asset(), "", alice_active_key );
+    {
+      decltype( ops_log.entries ) expected = { { 'p', transfer_tag }, { 'g', transfer_tag }, { 'b', transfer_tag }, { 'a', transfer_tag } };
+      BOOST_REQUIRE( ops_log.entries == expected );
+    }
+    ops_log.entries.clear();
+
+    BOOST_TEST_MESSAGE( "Transfer to vesting reaches only handler subscribed to it" );
+    vest( "alice", "bob", HIVE_asset( 1'000 ), alice_active_key );
+    {
+      // generic handler also sees virtual operations (e.g. transfer_to_vesting_completed_operation)
+      BOOST_REQUIRE_GE( ops_log.entries.size(), 2u );
+      BOOST_REQUIRE( ops_log.entries[ ops_log.entries.size() - 2 ] == std::make_pair( 'g', vesting_tag ) );
+      BOOST_REQUIRE( ops_log.entries.back() == std::make_pair( 'b', vesting_tag ) );
+      for( size_t i = 0; i < ops_log.entries.size() - 1; ++i )
+        BOOST_REQUIRE_EQUAL( ops_log.entries[i].first, 'g' );
+    }
+    ops_log.entries.clear();
+
+    BOOST_TEST_MESSAGE( "Disconnected typed handler is no longer called" );
+    hive::utilities::disconnect_signal( a_conns );
+    transfer( "alice", "bob", HIVE_asset( 1'000 ).to_asset(), "", alice_active_key );
+    {
+      decltype( ops_log.entries ) expected = { { 'p', transfer_tag }, { 'g', transfer_tag }, { 'b', transfer_tag } };
+      BOOST_REQUIRE( ops_log.entries == expected );
+    }
+
+    validate_database();
+  }
+  FC_LOG_AND_RETHROW()
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -1781,7 +1781,7 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
 
     const int NUMBER_OF_OBJECTS = 30000;
 
-    // create big objects with subcontainers: account_object (place on undo_state::new_ids)
+    // create big objects with subcontainers: account_object (new in undo session, no undo records)
     {
       auto undo_session = db->start_undo_session();
       auto time_start = std::chrono::high_resolution_clock::now();
@@ -1795,16 +1795,16 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( account_idx.size(), account_idx_size + NUMBER_OF_OBJECTS );
 
-      // remove big objects from undo session through undo (they are on new_ids, so their size does not matter)
+      // remove big objects from undo session through undo (they are new, so their size does not matter)
       time_start = std::chrono::high_resolution_clock::now();
       undo_session.undo();
       duration_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::high_resolution_clock::now() - time_start ).count();
-      ilog( "Removing of ${x} new account_objects from new_ids through undo took ${t}ns (${o} per object)",
+      ilog( "Removing of ${x} new account_objects through undo took ${t}ns (${o} per object)",
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( account_idx.size(), account_idx_size );
     }
 
-    // create big objects again (place on undo_state::new_ids)
+    // create big objects again (new in undo session, no undo records)
     {
       auto undo_session = db->start_undo_session();
       auto time_start = std::chrono::high_resolution_clock::now();
@@ -1818,12 +1818,12 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( account_idx.size(), account_idx_size + NUMBER_OF_OBJECTS );
 
-      // remove big objects from undo session through commit (they are on new_ids, so their size does not matter)
+      // remove big objects from undo session through commit (they are new, so their size does not matter)
       time_start = std::chrono::high_resolution_clock::now();
       undo_session.push();
       db->commit( db->revision() );
       duration_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::high_resolution_clock::now() - time_start ).count();
-      ilog( "Removing of ${x} new account_objects from new_ids through commit took ${t}ns (${o} per object)",
+      ilog( "Removing of ${x} new account_objects through commit took ${t}ns (${o} per object)",
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( account_idx.size(), account_idx_size + NUMBER_OF_OBJECTS );
     }
@@ -1832,7 +1832,7 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
     auto firstAccountI = lastBuiltinAccountI;
     ++firstAccountI;
 
-    // create small objects: comment_object (place on undo_state::new_ids)
+    // create small objects: comment_object (new in undo session, no undo records)
     {
       auto undo_session = db->start_undo_session();
       auto time_start = std::chrono::high_resolution_clock::now();
@@ -1845,16 +1845,16 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( comment_idx.size(), comment_idx_size + NUMBER_OF_OBJECTS );
 
-      // remove small objects from undo session through undo (they are on new_ids, so their size does not matter)
+      // remove small objects from undo session through undo (they are new, so their size does not matter)
       time_start = std::chrono::high_resolution_clock::now();
       undo_session.undo();
       duration_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::high_resolution_clock::now() - time_start ).count();
-      ilog( "Removing of ${x} new comment_objects from new_ids through undo took ${t}ns (${o} per object)",
+      ilog( "Removing of ${x} new comment_objects through undo took ${t}ns (${o} per object)",
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( comment_idx.size(), comment_idx_size );
     }
 
-    // create small objects again (place on undo_state::new_ids)
+    // create small objects again (new in undo session, no undo records)
     {
       auto undo_session = db->start_undo_session();
       auto time_start = std::chrono::high_resolution_clock::now();
@@ -1867,12 +1867,12 @@ BOOST_AUTO_TEST_CASE( filled_undo_benchmark )
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( comment_idx.size(), comment_idx_size + NUMBER_OF_OBJECTS );
 
-      // remove small objects from undo session through commit (they are on new_ids, so their size does not matter)
+      // remove small objects from undo session through commit (they are new, so their size does not matter)
       time_start = std::chrono::high_resolution_clock::now();
       undo_session.push();
       db->commit( db->revision() );
       duration_ns = std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::high_resolution_clock::now() - time_start ).count();
-      ilog( "Removing of ${x} new comment_objects from new_ids through commit took ${t}ns (${o} per object)",
+      ilog( "Removing of ${x} new comment_objects through commit took ${t}ns (${o} per object)",
         ( "x", NUMBER_OF_OBJECTS )( "t", duration_ns )( "o", ( duration_ns + NUMBER_OF_OBJECTS - 1 ) / NUMBER_OF_OBJECTS ) );
       BOOST_REQUIRE_EQUAL( comment_idx.size(), comment_idx_size + NUMBER_OF_OBJECTS );
     }